@@ -0,0 +1,109 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <benchmark/benchmark.h>
+#include <sys/stat.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "logging/appender_config.h"
+#include "logging/binary_appender.h"
+#include "logging/file_appender.h"
+#include "logging/log_clock.h"
+#include "logging/log_event.h"
+
+namespace {
+
+constexpr const char * kFormats[] = {
+  "request {} from {} took {} us",
+  "cache miss for key {} in shard {}",
+  "retrying {} after {} ms, attempt {}",
+  "queue {} depth {} above {}"
+};
+constexpr const char * kLoggerNames[] = {"SubModuleA", "SubModuleB", "Network", "Storage"};
+constexpr const char * kUsers[] = {"some_user", "other_user", "admin", "batch_job", "guest"};
+
+// Typical traffic: deferred messages with varying arguments over a few format strings, plain
+// messages which mostly differ in the ids they contain and messages with structured fields,
+// spread over several loggers and threads.
+std::vector<logging::LogEvent> MakeTypicalEvents() {
+  constexpr std::size_t kNumEvents = 1024;
+  std::vector<logging::LogEvent> log_events(kNumEvents);
+  for (std::size_t i = 0; i < kNumEvents; ++i) {
+    logging::LogEvent & log_event = log_events[i];
+    log_event.m_log_level = i % 16 == 0 ? logging::LogLevel::WARN : logging::LogLevel::INFO;
+    log_event.m_logger_name = kLoggerNames[i % 4];
+    log_event.m_thread_id = static_cast<uint32_t>(3 + i % 8);
+    int64_t id = static_cast<int64_t>(100000 + i * 7919 % 100000);
+    switch (i % 3) {
+      case 0:
+        log_event.m_format = kFormats[i / 3 % 4];
+        log_event.m_arguments.Add(id, std::string(kUsers[i % 5]), static_cast<int>(i % 1000));
+        break;
+      case 1:
+        log_event.m_message = "connection " + std::to_string(id) + " to " + kUsers[i % 5] + " closed";
+        break;
+      default:
+        log_event.m_message = i % 2 == 0 ? "request done" : "request failed";
+        log_event.m_fields.AddFields("user_id", id, "latency_us", static_cast<int>(i % 500), "status", i % 2 == 0 ? 200 : 503);
+        break;
+    }
+  }
+  return log_events;
+}
+
+template <class Appender>
+void RunTypicalTraffic(benchmark::State & state, Appender & appender) {
+  std::vector<logging::LogEvent> log_events = MakeTypicalEvents();
+  std::size_t next = 0;
+  for (auto _ : state) {
+    logging::LogEvent & log_event = log_events[next];
+    log_event.m_timestamp = logging::LogClock::Now();
+    appender.Send(log_event);
+    next = next + 1 == log_events.size() ? 0 : next + 1;
+  }
+  appender.Close();
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Text output with the default pattern, the baseline for the binary format.
+void BM_TextFileTypicalTraffic(benchmark::State & state) {
+  std::unique_ptr<logging::FileAppenderConfig> appender_config =
+    std::make_unique<logging::FileAppenderConfig>(logging::AppenderType::FILE, "BenchFileAppender", "/tmp/", "FALSE", "logging_text_size_bench", "TRUNCATE");
+  logging::FileAppender appender(std::move(appender_config));
+  RunTypicalTraffic(state, appender);
+  struct stat file_stat;
+  ::stat("/tmp/logging_text_size_bench.txt", &file_stat);
+  state.counters["bytes_per_event"] = static_cast<double>(file_stat.st_size) / state.iterations();
+}
+BENCHMARK(BM_TextFileTypicalTraffic);
+
+void BM_BinaryFileTypicalTraffic(benchmark::State & state) {
+  std::unique_ptr<logging::FileAppenderConfig> appender_config =
+    std::make_unique<logging::FileAppenderConfig>(logging::AppenderType::BINARY, "BenchBinaryAppender", "/tmp/", "FALSE", "logging_binary_size_bench", "TRUNCATE");
+  logging::BinaryAppender appender(std::move(appender_config));
+  RunTypicalTraffic(state, appender);
+  state.counters["bytes_per_event"] = static_cast<double>(appender.GetBytesWritten()) / state.iterations();
+}
+BENCHMARK(BM_BinaryFileTypicalTraffic);
+
+}  // namespace
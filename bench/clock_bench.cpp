@@ -0,0 +1,70 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include "logging/log_clock.h"
+#include "logging/timestamp_formatter.h"
+
+namespace {
+
+// Timestamp capture on the logging thread.
+void BM_LogClockNow(benchmark::State & state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(logging::LogClock::Now());
+  }
+  state.SetLabel(logging::LogClock::IsUsingTsc() ? "tsc" : "steady_clock");
+}
+BENCHMARK(BM_LogClockNow);
+
+void BM_SystemClockNow(benchmark::State & state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(std::chrono::system_clock::now());
+  }
+}
+BENCHMARK(BM_SystemClockNow);
+
+// Formatting of events 1us apart, so the cached second is almost always reused.
+void BM_TimestampFormat(benchmark::State & state) {
+  logging::TimestampFormatter formatter;
+  std::string output;
+  int64_t unix_nanos = logging::LogClock::ToUnixNanos(logging::LogClock::Now());
+  for (auto _ : state) {
+    output.clear();
+    formatter.Format(unix_nanos, output);
+    benchmark::DoNotOptimize(output.data());
+    unix_nanos += 1000;
+  }
+}
+BENCHMARK(BM_TimestampFormat);
+
+void BM_TimestampToUnixNanos(benchmark::State & state) {
+  uint64_t ticks = logging::LogClock::Now();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(logging::LogClock::ToUnixNanos(ticks++));
+  }
+}
+BENCHMARK(BM_TimestampToUnixNanos);
+
+}  // namespace
@@ -0,0 +1,61 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include "logging/logging_configurator.h"
+
+namespace {
+
+// A config file with a default console appender and state.range(0) loggers with a file appender each.
+std::string WriteConfigFile(int num_loggers) {
+  std::string file_name = "/tmp/logging_config_bench_" + std::to_string(num_loggers) + ".txt";
+  std::ofstream ofs(file_name, std::ios::trunc);
+  ofs << "# Generated by logging-bench\n\n";
+  ofs << "[DefaultAppender]\nAppenderType=CONSOLE\nAppenderName=DefaultConsoleAppender\nLogLevel=INFO\n"
+      << "Pattern=%d{%H:%M:%S.%f} [%p] %c - %m%n\nCustomParameters=NONE\n\n";
+  for (int i = 0; i < num_loggers; ++i) {
+    ofs << "[Logger]\nLoggerName=SubModule" << i << "_Logger\nLogLevel=DEBUG\n"
+        << "[LoggerAppender]\nAppenderType=FILE\nAppenderName=SubModule" << i << "_FileAppender\nLogLevel=INFO\n"
+        << "CustomParameters=OutPutFileDirectory:/tmp/,OutPutFileNamePrefix:submodule" << i << "_,FileOpenMode:APPEND\n\n";
+  }
+  return file_name;
+}
+
+// Parsing only, the appenders described by the file are not created.
+void BM_ReadConfigFile(benchmark::State & state) {
+  std::string file_name = WriteConfigFile(static_cast<int>(state.range(0)));
+  logging::LoggingConfigurator configurator;
+  for (auto _ : state) {
+    configurator.Clear();
+    bool result = configurator.ReadConfigFromFile(file_name);
+    benchmark::DoNotOptimize(result);
+  }
+  std::remove(file_name.c_str());
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ReadConfigFile)->Arg(1)->Arg(10)->Arg(100)->Arg(1000);
+
+}  // namespace
@@ -0,0 +1,66 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <string>
+#include "logging/appender_config.h"
+#include "logging/console_appender.h"
+#include "logging/log_event.h"
+#include "stdout_redirect.h"
+
+namespace {
+
+void RunConsoleAppender(benchmark::State & state, const std::string & custom_parameters) {
+  StdoutToDevNull redirect;
+  std::unique_ptr<logging::ConsoleAppenderConfig> appender_config =
+    std::make_unique<logging::ConsoleAppenderConfig>(logging::AppenderType::CONSOLE, "BenchConsoleAppender");
+  appender_config->InitFromCustomParametersStr(custom_parameters);
+  logging::ConsoleAppender appender(std::move(appender_config));
+  logging::LogEvent log_event;
+  log_event.m_log_level = logging::LogLevel::INFO;
+  log_event.m_logger_name = "Bench";
+  log_event.m_message = "request 123456 from some_user took 42 us";
+  for (auto _ : state) {
+    appender.Send(log_event);
+  }
+  appender.Close();
+  state.SetItemsProcessed(state.iterations());
+}
+
+// std::cout with a flush per line.
+void BM_ConsoleAppenderStream(benchmark::State & state) {
+  RunConsoleAppender(state, "NONE");
+}
+BENCHMARK(BM_ConsoleAppenderStream);
+
+void BM_ConsoleAppenderDirectLine(benchmark::State & state) {
+  RunConsoleAppender(state, "OutputMode:DIRECT,Buffering:LINE");
+}
+BENCHMARK(BM_ConsoleAppenderDirectLine);
+
+void BM_ConsoleAppenderDirectBlock(benchmark::State & state) {
+  RunConsoleAppender(state, "OutputMode:DIRECT,Buffering:BLOCK");
+}
+BENCHMARK(BM_ConsoleAppenderDirectBlock);
+
+}  // namespace
@@ -0,0 +1,95 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "logging/appender_base.h"
+#include "logging/log_clock.h"
+#include "logging/log_event.h"
+
+namespace {
+
+class NullAppender : public logging::AppenderBase {
+ public:
+  explicit NullAppender(std::unique_ptr<logging::AppenderConfig> appender_config)
+    : logging::AppenderBase(std::move(appender_config)) {}
+  void Close() override { m_is_closed = true; }
+
+ protected:
+  void HookedDoSend(const logging::LogEvent & log_event) override { benchmark::DoNotOptimize(&log_event); }
+};
+
+std::unique_ptr<logging::AppenderConfig> MakeConfig(bool dedup) {
+  std::unique_ptr<logging::AppenderConfig> appender_config =
+    std::make_unique<logging::AppenderConfig>(logging::AppenderType::NONE, "BenchNullAppender");
+  appender_config->m_dedup_level = dedup ? logging::LogLevel::WARN : logging::LogLevel::OFF;
+  return appender_config;
+}
+
+// Overhead of the dedup check on ERROR events which are all different (nothing suppressed).
+void BM_DedupDistinctErrors(benchmark::State & state) {
+  NullAppender appender(MakeConfig(state.range(0) != 0));
+  std::vector<logging::LogEvent> log_events(64);
+  for (std::size_t i = 0; i < log_events.size(); ++i) {
+    log_events[i].m_log_level = logging::LogLevel::ERROR;
+    log_events[i].m_logger_name = "SubModuleA";
+    log_events[i].m_message = "connection to db-" + std::to_string(i) + ".example.com:5432 refused, retrying in 100 ms";
+    log_events[i].m_timestamp = logging::LogClock::Now();
+  }
+  std::size_t next = 0;
+  for (auto _ : state) {
+    appender.Send(log_events[next]);
+    next = (next + 1) % log_events.size();
+  }
+}
+BENCHMARK(BM_DedupDistinctErrors)->Arg(0)->Arg(1);
+
+// The same ERROR over and over, suppressed with dedup on.
+void BM_DedupRepeatedErrors(benchmark::State & state) {
+  NullAppender appender(MakeConfig(state.range(0) != 0));
+  logging::LogEvent log_event;
+  log_event.m_log_level = logging::LogLevel::ERROR;
+  log_event.m_logger_name = "SubModuleA";
+  log_event.m_message = "connection to db-1.example.com:5432 refused, retrying in 100 ms";
+  for (auto _ : state) {
+    log_event.m_timestamp = logging::LogClock::Now();
+    appender.Send(log_event);
+  }
+}
+BENCHMARK(BM_DedupRepeatedErrors)->Arg(0)->Arg(1);
+
+// INFO events pass the dedup stage with a single relaxed load.
+void BM_DedupInfo(benchmark::State & state) {
+  NullAppender appender(MakeConfig(state.range(0) != 0));
+  logging::LogEvent log_event;
+  log_event.m_log_level = logging::LogLevel::INFO;
+  log_event.m_logger_name = "SubModuleA";
+  log_event.m_message = "request 123456 from some_user took 42 us";
+  for (auto _ : state) {
+    appender.Send(log_event);
+  }
+}
+BENCHMARK(BM_DedupInfo)->Arg(0)->Arg(1);
+
+}  // namespace
@@ -0,0 +1,83 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <string>
+#include "logging/appender_config.h"
+#include "logging/async_appender.h"
+#include "logging/file_appender.h"
+#include "logging/log_event.h"
+
+namespace {
+
+// Throughput of FileAppender for a given buffer size, 0 is the old flush after every message.
+void BM_FileAppender(benchmark::State & state) {
+  std::unique_ptr<logging::FileAppenderConfig> appender_config =
+    std::make_unique<logging::FileAppenderConfig>(logging::AppenderType::FILE, "BenchFileAppender", "/tmp/", "FALSE", "logging_file_bench", "TRUNCATE");
+  appender_config->m_buffer_size = state.range(0);
+  logging::FileAppender appender(std::move(appender_config));
+  logging::LogEvent log_event;
+  log_event.m_log_level = logging::LogLevel::INFO;
+  log_event.m_logger_name = "Bench";
+  log_event.m_message = "request 123456 from some_user took 42 us";
+  for (auto _ : state) {
+    appender.Send(log_event);
+  }
+  appender.Close();
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FileAppender)->Arg(0)->Arg(4 * 1024)->Arg(64 * 1024)->Arg(1024 * 1024);
+
+// Caller side cost with a slow sink (flush after every message) behind a queue of 1024 events:
+// -1 writes synchronously, otherwise the argument is the OverflowPolicy.
+void BM_QueuedSlowFileAppender(benchmark::State & state) {
+  std::unique_ptr<logging::FileAppenderConfig> appender_config =
+    std::make_unique<logging::FileAppenderConfig>(logging::AppenderType::FILE, "BenchFileAppender", "/tmp/", "FALSE", "logging_queue_bench", "TRUNCATE");
+  appender_config->m_buffer_size = 0;
+  appender_config->m_dedup_level = logging::LogLevel::OFF;
+  std::unique_ptr<logging::IAppender> appender;
+  logging::AsyncAppender * async_appender = nullptr;
+  if (state.range(0) < 0) {
+    appender.reset(new logging::FileAppender(std::move(appender_config)));
+  } else {
+    appender_config->m_queue_size = 1024;
+    appender_config->m_overflow_policy = static_cast<logging::OverflowPolicy>(state.range(0));
+    async_appender = new logging::AsyncAppender(logging::AppenderUnqPtr(new logging::FileAppender(std::move(appender_config))));
+    appender.reset(async_appender);
+  }
+  logging::LogEvent log_event;
+  log_event.m_log_level = logging::LogLevel::INFO;
+  log_event.m_logger_name = "Bench";
+  log_event.m_message = "request 123456 from some_user took 42 us";
+  for (auto _ : state) {
+    appender->Send(log_event);
+  }
+  appender->Close();
+  if (async_appender != nullptr) {
+    state.counters["dropped_ratio"] = static_cast<double>(async_appender->GetDroppedCount()) / state.iterations();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_QueuedSlowFileAppender)->Arg(-1)->Arg(0)->Arg(1)->Arg(2)->UseRealTime();
+
+}  // namespace
@@ -0,0 +1,232 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <string>
+#include "logging/appender_base.h"
+#include "logging/ara_log_format_policy.h"
+#include "logging/default_format_policy.h"
+#include "logging/default_format_policy_with_newline.h"
+#include "logging/layout_format_policy.h"
+#include "logging/pattern_format_policy.h"
+#include "logging/log_manager.h"
+#include "logging/logger.h"
+
+namespace {
+
+// Accepts every event but doesn't format it, so only the caller side cost is measured.
+class NullAppender : public logging::AppenderBase {
+ public:
+  explicit NullAppender(const std::string & name)
+    : logging::AppenderBase(std::make_unique<logging::AppenderConfig>(logging::AppenderType::NONE, name)) {}
+  void Close() override { m_is_closed = true; }
+
+ protected:
+  void HookedDoSend(const logging::LogEvent & log_event) override { benchmark::DoNotOptimize(&log_event); }
+};
+
+logging::Logger & GetBenchLogger() {
+  logging::LogManager::GetInstance().RemoveAllDefaultAppenders();
+  logging::Logger & logger = logging::LogManager::GetInstance().GetLogger("Bench");
+  logger.AddAppender(logging::AppenderUnqPtr(new NullAppender("BenchNullAppender")));
+  return logger;
+}
+
+// Current path: the caller builds the whole string before LOG_INFO.
+void BM_LogInfoString(benchmark::State & state) {
+  logging::Logger & logger = GetBenchLogger();
+  int64_t request_id = 123456;
+  std::string user("some_user");
+  for (auto _ : state) {
+    LOG_INFO(logger, "request " + std::to_string(request_id) + " from " + user + " took " + std::to_string(42) + " us");
+  }
+}
+BENCHMARK(BM_LogInfoString);
+
+// Deferred path: only the arguments are captured on the caller thread.
+void BM_LogInfoFormat(benchmark::State & state) {
+  logging::Logger & logger = GetBenchLogger();
+  int64_t request_id = 123456;
+  std::string user("some_user");
+  for (auto _ : state) {
+    LOG_INFO_FMT(logger, "request {} from {} took {} us", request_id, user, 42);
+  }
+}
+BENCHMARK(BM_LogInfoFormat);
+
+// Structured fields: typed values are copied, nothing is converted to text on the caller thread.
+void BM_LogInfoKV(benchmark::State & state) {
+  logging::Logger & logger = GetBenchLogger();
+  int64_t request_id = 123456;
+  std::string user("some_user");
+  for (auto _ : state) {
+    LOG_INFO_KV(logger, "request done", "request_id", request_id, "user", user, "latency_us", 42);
+  }
+}
+BENCHMARK(BM_LogInfoKV);
+
+// Backend side cost of the deferred path.
+void BM_FormatDeferredMessage(benchmark::State & state) {
+  logging::LogEvent log_event;
+  log_event.m_format = "request {} from {} took {} us";
+  log_event.m_arguments.Add(int64_t(123456), std::string("some_user"), 42);
+  std::string message;
+  for (auto _ : state) {
+    log_event.m_arguments.Format(log_event.m_format, message);
+    benchmark::DoNotOptimize(message.data());
+  }
+}
+BENCHMARK(BM_FormatDeferredMessage);
+
+// Cost of the source location and thread id captured by LOG_*: the macro against a plain
+// Logger::Write call which fills neither.
+void BM_WriteWithoutLocation(benchmark::State & state) {
+  logging::Logger & logger = GetBenchLogger();
+  const std::string message("request 123456 from some_user took 42 us");
+  for (auto _ : state) {
+    if (logger.ShouldLog(logging::LogLevel::INFO)) {
+      logger.Write(logging::LogLevel::INFO, message);
+    }
+  }
+}
+BENCHMARK(BM_WriteWithoutLocation);
+
+void BM_LogInfoWithLocation(benchmark::State & state) {
+  logging::Logger & logger = GetBenchLogger();
+  const std::string message("request 123456 from some_user took 42 us");
+  for (auto _ : state) {
+    LOG_INFO(logger, message);
+  }
+}
+BENCHMARK(BM_LogInfoWithLocation);
+
+// Sampled statements in a hot loop: the per call site check against building every message.
+void BM_LogWarnEveryMessage(benchmark::State & state) {
+  logging::Logger & logger = GetBenchLogger();
+  int64_t queue_size = 4096;
+  for (auto _ : state) {
+    LOG_WARN(logger, "queue full, " + std::to_string(queue_size) + " entries");
+  }
+}
+BENCHMARK(BM_LogWarnEveryMessage);
+
+void BM_LogWarnEveryN(benchmark::State & state) {
+  logging::Logger & logger = GetBenchLogger();
+  int64_t queue_size = 4096;
+  for (auto _ : state) {
+    LOG_EVERY_N(WARN, logger, 1000, "queue full, " + std::to_string(queue_size) + " entries");
+  }
+}
+BENCHMARK(BM_LogWarnEveryN);
+
+void BM_LogWarnFirstN(benchmark::State & state) {
+  logging::Logger & logger = GetBenchLogger();
+  int64_t queue_size = 4096;
+  for (auto _ : state) {
+    LOG_FIRST_N(WARN, logger, 10, "queue full, " + std::to_string(queue_size) + " entries");
+  }
+}
+BENCHMARK(BM_LogWarnFirstN);
+
+void BM_LogWarnEveryT(benchmark::State & state) {
+  logging::Logger & logger = GetBenchLogger();
+  int64_t queue_size = 4096;
+  for (auto _ : state) {
+    LOG_EVERY_T(WARN, logger, 1.0, "queue full, " + std::to_string(queue_size) + " entries");
+  }
+}
+BENCHMARK(BM_LogWarnEveryT);
+
+void BM_LogWarnRateLimited(benchmark::State & state) {
+  logging::Logger & logger = GetBenchLogger();
+  int64_t queue_size = 4096;
+  for (auto _ : state) {
+    LOG_RATE_LIMITED(WARN, logger, 100, "queue full, " + std::to_string(queue_size) + " entries");
+  }
+}
+BENCHMARK(BM_LogWarnRateLimited)->Threads(1)->Threads(4);
+
+// Line layout: string concatenation vs the precompiled pattern with a reused buffer.
+logging::LogEvent MakeLayoutEvent() {
+  logging::LogEvent log_event;
+  log_event.m_log_level = logging::LogLevel::INFO;
+  log_event.m_logger_name = "Bench";
+  log_event.m_message = "request 123456 from some_user took 42 us";
+  return log_event;
+}
+
+void BM_LayoutDefaultPolicy(benchmark::State & state) {
+  logging::LogEvent log_event = MakeLayoutEvent();
+  logging::DefaultFormatPolicyWithNewLine policy;
+  for (auto _ : state) {
+    std::string line = policy.FormatMessage(log_event);
+    benchmark::DoNotOptimize(line.data());
+  }
+}
+BENCHMARK(BM_LayoutDefaultPolicy);
+
+void BM_LayoutPatternPolicy(benchmark::State & state) {
+  logging::LogEvent log_event = MakeLayoutEvent();
+  logging::PatternFormatPolicy policy;
+  for (auto _ : state) {
+    const std::string & line = policy.FormatMessage(log_event);
+    benchmark::DoNotOptimize(line.data());
+  }
+}
+BENCHMARK(BM_LayoutPatternPolicy);
+
+// "[logger] message" without timestamp or newline.
+void BM_LayoutDefaultPolicyNoNewline(benchmark::State & state) {
+  logging::LogEvent log_event = MakeLayoutEvent();
+  logging::DefaultFormatPolicy policy;
+  for (auto _ : state) {
+    std::string line = policy.FormatMessage(log_event);
+    benchmark::DoNotOptimize(line.data());
+  }
+}
+BENCHMARK(BM_LayoutDefaultPolicyNoNewline);
+
+// "[logger] message" of the ARA log appender.
+void BM_LayoutAraLogPolicy(benchmark::State & state) {
+  logging::LogEvent log_event = MakeLayoutEvent();
+  logging::AraLogFormatPolicy policy;
+  for (auto _ : state) {
+    std::string line = policy.FormatMessage(log_event);
+    benchmark::DoNotOptimize(line.data());
+  }
+}
+BENCHMARK(BM_LayoutAraLogPolicy);
+
+// JSON lines through the layout selection of the console and file appenders.
+void BM_LayoutJsonPolicy(benchmark::State & state) {
+  logging::LogEvent log_event = MakeLayoutEvent();
+  logging::LayoutFormatPolicy policy;
+  policy.SetLayout(logging::LayoutType::JSON);
+  for (auto _ : state) {
+    const std::string & line = policy.FormatMessage(log_event);
+    benchmark::DoNotOptimize(line.data());
+  }
+}
+BENCHMARK(BM_LayoutJsonPolicy);
+
+}  // namespace
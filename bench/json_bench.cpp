@@ -0,0 +1,112 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <benchmark/benchmark.h>
+#include <string>
+#include "logging/json_escape.h"
+#include "logging/json_format_policy.h"
+#include "logging/log_event.h"
+
+namespace {
+
+// Typical message: long runs of printable ASCII with a rare quote.
+std::string MakeAsciiHeavyInput() {
+  std::string input;
+  while (input.size() < 1024) {
+    input += "request 123456 from \"some_user\" took 42 us, cache hit ratio 0.97 on shard eu-west-1; ";
+  }
+  return input;
+}
+
+// Worst case: every few bytes need an escape sequence.
+std::string MakeEscapeHeavyInput() {
+  std::string input;
+  while (input.size() < 1024) {
+    input += "a\"b\\c\td\ne\x01";
+  }
+  return input;
+}
+
+void BM_JsonEscapeScalarAscii(benchmark::State & state) {
+  const std::string input = MakeAsciiHeavyInput();
+  std::string output;
+  for (auto _ : state) {
+    output.clear();
+    logging::AppendJsonEscapedScalar(input.data(), input.size(), output);
+    benchmark::DoNotOptimize(output.data());
+  }
+  state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(BM_JsonEscapeScalarAscii);
+
+void BM_JsonEscapeSimdAscii(benchmark::State & state) {
+  const std::string input = MakeAsciiHeavyInput();
+  std::string output;
+  for (auto _ : state) {
+    output.clear();
+    logging::AppendJsonEscaped(input.data(), input.size(), output);
+    benchmark::DoNotOptimize(output.data());
+  }
+  state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(BM_JsonEscapeSimdAscii);
+
+void BM_JsonEscapeScalarEscapeHeavy(benchmark::State & state) {
+  const std::string input = MakeEscapeHeavyInput();
+  std::string output;
+  for (auto _ : state) {
+    output.clear();
+    logging::AppendJsonEscapedScalar(input.data(), input.size(), output);
+    benchmark::DoNotOptimize(output.data());
+  }
+  state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(BM_JsonEscapeScalarEscapeHeavy);
+
+void BM_JsonEscapeSimdEscapeHeavy(benchmark::State & state) {
+  const std::string input = MakeEscapeHeavyInput();
+  std::string output;
+  for (auto _ : state) {
+    output.clear();
+    logging::AppendJsonEscaped(input.data(), input.size(), output);
+    benchmark::DoNotOptimize(output.data());
+  }
+  state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(BM_JsonEscapeSimdEscapeHeavy);
+
+// Whole line through the policy used by the appenders.
+void BM_JsonFormatPolicy(benchmark::State & state) {
+  logging::LogEvent log_event;
+  log_event.m_log_level = logging::LogLevel::INFO;
+  log_event.m_logger_name = "Bench";
+  log_event.m_message = "request 123456 from some_user took 42 us";
+  log_event.m_fields.AddFields("user_id", 42, "latency_us", 12.5, "user", std::string("some user"));
+  logging::JsonFormatPolicy policy;
+  for (auto _ : state) {
+    const std::string & line = policy.FormatMessage(log_event);
+    benchmark::DoNotOptimize(line.data());
+  }
+}
+BENCHMARK(BM_JsonFormatPolicy);
+
+}  // namespace
@@ -0,0 +1,131 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <string>
+#include "logging/appender_base.h"
+#include "logging/appender_config.h"
+#include "logging/console_appender.h"
+#include "logging/file_appender.h"
+#include "logging/log_manager.h"
+#include "logging/logger.h"
+#include "stdout_redirect.h"
+
+// LOG_* statements from 1 to 8 producer threads, one logger per sink. Loggers are created on first
+// use and kept, so every thread of a run logs through the same logger and appender.
+namespace {
+
+class NullAppender : public logging::AppenderBase {
+ public:
+  explicit NullAppender(const std::string & name)
+    : logging::AppenderBase(std::make_unique<logging::AppenderConfig>(logging::AppenderType::NONE, name)) {}
+  void Close() override { m_is_closed = true; }
+
+ protected:
+  void HookedDoSend(const logging::LogEvent & log_event) override { benchmark::DoNotOptimize(&log_event); }
+};
+
+logging::Logger & MakeLogger(const std::string & name, logging::LogLevel log_level, logging::AppenderUnqPtr appender) {
+  logging::Logger & logger = logging::LogManager::GetInstance().GetLogger(name);
+  logger.SetUseDefaultAppender(false);
+  logger.SetLogLevel(log_level);
+  logger.AddAppender(std::move(appender));
+  return logger;
+}
+
+logging::Logger & GetNullSinkLogger() {
+  static logging::Logger & logger = MakeLogger("BenchNullSink", logging::LogLevel::INFO,
+                                               logging::AppenderUnqPtr(new NullAppender("BenchNullAppender")));
+  return logger;
+}
+
+logging::Logger & GetFileSinkLogger() {
+  static logging::Logger & logger = [] () -> logging::Logger & {
+    std::unique_ptr<logging::FileAppenderConfig> appender_config =
+      std::make_unique<logging::FileAppenderConfig>(logging::AppenderType::FILE, "BenchFileAppender", "/tmp/", "FALSE", "logging_logger_bench", "TRUNCATE");
+    return MakeLogger("BenchFileSink", logging::LogLevel::INFO,
+                      logging::AppenderUnqPtr(new logging::FileAppender(std::move(appender_config))));
+  }();
+  return logger;
+}
+
+// Line buffered direct output, so nothing is left in the buffer when stdout is restored.
+logging::Logger & GetConsoleSinkLogger() {
+  static logging::Logger & logger = [] () -> logging::Logger & {
+    std::unique_ptr<logging::ConsoleAppenderConfig> appender_config =
+      std::make_unique<logging::ConsoleAppenderConfig>(logging::AppenderType::CONSOLE, "BenchConsoleAppender");
+    appender_config->InitFromCustomParametersStr("OutputMode:DIRECT,Buffering:LINE");
+    return MakeLogger("BenchConsoleSink", logging::LogLevel::INFO,
+                      logging::AppenderUnqPtr(new logging::ConsoleAppender(std::move(appender_config))));
+  }();
+  return logger;
+}
+
+// A statement below the logger level: one relaxed load, the message is never built.
+void BM_LogDisabledLevel(benchmark::State & state) {
+  logging::Logger & logger = GetNullSinkLogger();
+  for (auto _ : state) {
+    LOG_DEBUG(logger, "request 123456 from some_user took 42 us");
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LogDisabledLevel)->ThreadRange(1, 8)->UseRealTime();
+
+void BM_LogDisabledLevelFormat(benchmark::State & state) {
+  logging::Logger & logger = GetNullSinkLogger();
+  int64_t request_id = 123456;
+  std::string user("some_user");
+  for (auto _ : state) {
+    LOG_DEBUG_FMT(logger, "request {} from {} took {} us", request_id, user, 42);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LogDisabledLevelFormat)->ThreadRange(1, 8)->UseRealTime();
+
+void RunLogInfo(benchmark::State & state, logging::Logger & logger) {
+  int64_t request_id = 123456;
+  std::string user("some_user");
+  for (auto _ : state) {
+    LOG_INFO_FMT(logger, "request {} from {} took {} us", request_id, user, 42);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BM_LogInfoNullSink(benchmark::State & state) {
+  RunLogInfo(state, GetNullSinkLogger());
+}
+BENCHMARK(BM_LogInfoNullSink)->ThreadRange(1, 8)->UseRealTime();
+
+void BM_LogInfoFileSink(benchmark::State & state) {
+  RunLogInfo(state, GetFileSinkLogger());
+}
+BENCHMARK(BM_LogInfoFileSink)->ThreadRange(1, 8)->UseRealTime();
+
+void BM_LogInfoConsoleSink(benchmark::State & state) {
+  StdoutToDevNull redirect;
+  RunLogInfo(state, GetConsoleSinkLogger());
+}
+BENCHMARK(BM_LogInfoConsoleSink)->ThreadRange(1, 8)->UseRealTime();
+
+}  // namespace
@@ -0,0 +1,98 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <benchmark/benchmark.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "logging/log_manager.h"
+#include "logging/logger.h"
+
+namespace {
+
+constexpr int kNumLoggers = 10000;
+
+const std::vector<std::string> & GetLoggerNames() {
+  static const std::vector<std::string> names = [] {
+    std::vector<std::string> result;
+    for (int i = 0; i < kNumLoggers; ++i) {
+      result.push_back("module" + std::to_string(i % 97) + ".component" + std::to_string(i));
+    }
+    return result;
+  }();
+  return names;
+}
+
+// The previous registry: std::map guarded by a recursive mutex on every lookup.
+class MapRegistry {
+ public:
+  int & Get(const std::string & name) {
+    std::lock_guard<std::recursive_mutex> lock(m_rmtx);
+    auto it = m_entries.find(name);
+    if (it == m_entries.end()) {
+      it = m_entries.emplace(name, std::unique_ptr<int>(new int(0))).first;
+    }
+    return *it->second;
+  }
+
+ private:
+  std::map<std::string, std::unique_ptr<int>> m_entries;
+  std::recursive_mutex m_rmtx;
+};
+
+void BM_GetLoggerMap(benchmark::State & state) {
+  static MapRegistry registry;
+  const auto & names = GetLoggerNames();
+  if (state.thread_index() == 0) {
+    for (const auto & name : names) {
+      registry.Get(name);
+    }
+  }
+  std::size_t i = state.thread_index() * 7919;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(&registry.Get(names[i % names.size()]));
+    i += 31;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_GetLoggerMap)->Threads(1)->Threads(4)->Threads(8)->UseRealTime();
+
+void BM_GetLoggerRegistry(benchmark::State & state) {
+  auto & log_manager = logging::LogManager::GetInstance();
+  const auto & names = GetLoggerNames();
+  if (state.thread_index() == 0) {
+    for (const auto & name : names) {
+      log_manager.GetLogger(name);
+    }
+  }
+  std::size_t i = state.thread_index() * 7919;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(&log_manager.GetLogger(names[i % names.size()]));
+    i += 31;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_GetLoggerRegistry)->Threads(1)->Threads(4)->Threads(8)->UseRealTime();
+
+}  // namespace
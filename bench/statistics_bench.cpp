@@ -0,0 +1,61 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <cstdint>
+#include "logging/log_clock.h"
+#include "logging/log_statistics.h"
+
+namespace {
+
+// What the counters would cost without sharding: every thread increments the same line.
+std::atomic<uint64_t> g_shared_counter {0};
+logging::ShardedCounters<logging::kNumStatisticLevels> g_sharded_counters;
+logging::LatencyHistogram g_histogram;
+
+void BM_SharedAtomicCounter(benchmark::State & state) {
+  for (auto _ : state) {
+    g_shared_counter.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+BENCHMARK(BM_SharedAtomicCounter)->ThreadRange(1, 8)->UseRealTime();
+
+void BM_ShardedCounter(benchmark::State & state) {
+  for (auto _ : state) {
+    g_sharded_counters.Add(static_cast<std::size_t>(logging::LogLevel::INFO));
+  }
+}
+BENCHMARK(BM_ShardedCounter)->ThreadRange(1, 8)->UseRealTime();
+
+// Record() of a typical Send duration, without the two LogClock::Now() around it.
+void BM_LatencyHistogramRecord(benchmark::State & state) {
+  uint64_t ticks = 1000;
+  for (auto _ : state) {
+    g_histogram.Record(ticks);
+    ticks = (ticks * 7 + 13) & 0xffff;
+  }
+}
+BENCHMARK(BM_LatencyHistogramRecord)->ThreadRange(1, 8)->UseRealTime();
+
+}  // namespace
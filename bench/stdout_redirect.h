@@ -0,0 +1,76 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef BENCH_STDOUT_REDIRECT_H_
+#define BENCH_STDOUT_REDIRECT_H_
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstdio>
+#include <iostream>
+#include <mutex>
+
+// Console output goes to /dev/null while a benchmark runs, as it would into a pipe. Every thread of
+// a multithreaded benchmark holds one; stdout is redirected by the first and restored by the last,
+// which Google Benchmark orders around the timed loops of all threads.
+class StdoutToDevNull {
+ public:
+  StdoutToDevNull() {
+    std::lock_guard<std::mutex> lock(GetMutex());
+    if (GetUsers()++ == 0) {
+      std::cout << std::flush;
+      fflush(stdout);
+      GetSavedStdout() = dup(STDOUT_FILENO);
+      int dev_null = open("/dev/null", O_WRONLY);
+      dup2(dev_null, STDOUT_FILENO);
+      close(dev_null);
+    }
+  }
+  ~StdoutToDevNull() {
+    std::lock_guard<std::mutex> lock(GetMutex());
+    if (--GetUsers() == 0) {
+      std::cout << std::flush;
+      dup2(GetSavedStdout(), STDOUT_FILENO);
+      close(GetSavedStdout());
+    }
+  }
+
+  StdoutToDevNull(const StdoutToDevNull&) = delete;
+  StdoutToDevNull& operator = (const StdoutToDevNull&) = delete;
+
+ private:
+  static std::mutex & GetMutex() {
+    static std::mutex mtx;
+    return mtx;
+  }
+  static int & GetUsers() {
+    static int users = 0;
+    return users;
+  }
+  static int & GetSavedStdout() {
+    static int saved_stdout = -1;
+    return saved_stdout;
+  }
+};
+
+#endif  // BENCH_STDOUT_REDIRECT_H_
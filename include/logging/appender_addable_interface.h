@@ -40,7 +40,8 @@ class IAppenderAddable {
  public:
     virtual AppenderAddableError AddAppender(std::unique_ptr<AppenderConfig> new_appender_config) = 0;
 
-    virtual AppenderList & GetAllAppenders() = 0;
+    // Snapshot of the current appenders, it is not affected by later modifications.
+    virtual AppenderListPtr GetAllAppenders() = 0;
 
 
     virtual AppenderRawPtr GetAppender(const std::string& name) const = 0;
@@ -51,6 +52,12 @@ class IAppenderAddable {
 
     virtual void RemoveAppender(const std::string& name) = 0;
 
+    // Creates an appender for new_appender_config and puts it in place of the appender with the same
+    // name, or adds it if there is none. The replaced appender is flushed and closed once the writers which
+    // still use it are done, the new one may write to the same destination meanwhile (see
+    // AppenderConfig::ContinueOutputOf). If the new appender can't be created the current one is kept.
+    virtual AppenderAddableError ReplaceAppender(std::unique_ptr<AppenderConfig> new_appender_config) = 0;
+
     virtual ~IAppenderAddable() = default;
 
  private:
@@ -24,11 +24,13 @@
 #define INCLUDE_LOGGING_APPENDER_BASE_H_
 
 #include <atomic>
+#include <cstdint>
 #include <string>
 #include <memory>
 #include <utility>
 #include "logging/appender_interface.h"
 #include "logging/appender_config.h"
+#include "logging/log_deduplicator.h"
 
 namespace logging {
 
@@ -41,18 +43,44 @@ class AppenderBase : public IAppender {
 
   const AppenderConfig& GetAppenderConfig() const override {return *m_appender_config.get();};
 
-  void SetAppenderConfig(std::unique_ptr<AppenderConfig> appender_config) override { m_appender_config = std::move(appender_config);};
+  void SetAppenderConfig(std::unique_ptr<AppenderConfig> appender_config) override;
+
+  bool Reconfigure(const AppenderConfig & appender_config) override;
 
   AppenderType GetAppenderType() override { return m_appender_config->m_appender_type; }
 
   std::string GetAppenderName() override { return m_appender_config->m_name; }
 
-  LogLevel GetAppenderLogLevel() { return m_appender_config->m_level; }
+  // Can differ from GetAppenderConfig().m_level after Reconfigure().
+  LogLevel GetAppenderLogLevel() { return m_level.load(std::memory_order_relaxed); }
+
+  // Reports pending repeats, then flushes the appender.
+  void Flush() final;
+
+  void ReportExpiredRepeats() final;
+
+  void CollectStatistics(AppenderStatistics & statistics) const override;
 
  protected:
     std::unique_ptr<AppenderConfig> m_appender_config;
     std::atomic<bool> m_is_closed;
+    std::atomic<LogLevel> m_level;
     virtual void HookedDoSend(const LogEvent & log_event) = 0;
+    // Nothing is buffered by default.
+    virtual void HookedFlush() {}
+    // Called by the derived appenders with the bytes they wrote to their destination.
+    void AddBytesWritten(uint64_t bytes) { m_counters.Add(kBytesWrittenCounter, bytes); }
+
+ private:
+    void SendRepeatSummary(const RepeatSummary & summary);
+    LogDeduplicator m_deduplicator;
+
+    // Events per level at the indexes of the levels, followed by the other counters.
+    static constexpr std::size_t kBytesWrittenCounter = kNumStatisticLevels;
+    static constexpr std::size_t kSuppressedCounter = kNumStatisticLevels + 1;
+    static constexpr std::size_t kFlushesCounter = kNumStatisticLevels + 2;
+    ShardedCounters<kNumStatisticLevels + 3> m_counters;
+    LatencyHistogram m_send_latency;
 };
 
 }  // namespace logging
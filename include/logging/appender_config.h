@@ -23,8 +23,11 @@
 #ifndef INCLUDE_LOGGING_APPENDER_CONFIG_H_
 #define INCLUDE_LOGGING_APPENDER_CONFIG_H_
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <iostream>
+#include <stdexcept>
 #include "logging/log_level.h"
 
 namespace logging {
@@ -35,7 +38,9 @@ enum class AppenderType {
   NET = 3,
   SYSLOG = 4,
   ARALOG = 5,
-  NONE = 6
+  NONE = 6,
+  BINARY = 7,
+  TRACE = 8
 };
 
 const inline std::string AppenderTypelToString(AppenderType appender_type) {
@@ -45,20 +50,97 @@ const inline std::string AppenderTypelToString(AppenderType appender_type) {
   else if (appender_type == AppenderType::SYSLOG) result = "SYSLOG";
   else if (appender_type == AppenderType::ARALOG) result = "ARALOG";
   else if (appender_type == AppenderType::NET) result = "NET";
+  else if (appender_type == AppenderType::BINARY) result = "BINARY";
+  else if (appender_type == AppenderType::TRACE) result = "TRACE";
   else throw std::invalid_argument("Invalid appender type.");
   return result;
 }
 
+// Line format of the console and file appenders.
+enum class LayoutType {
+  PATTERN = 0,
+  JSON = 1
+};
+
+const inline LayoutType LayoutTypeFromString(const std::string & layout_type) {
+  LayoutType result = LayoutType::PATTERN;
+  if (layout_type == "PATTERN") result = LayoutType::PATTERN;
+  else if (layout_type == "JSON") result = LayoutType::JSON;
+  else throw std::invalid_argument("Invalid layout type.");
+  return result;
+}
+
+// What Send() does when the queue of an appender (AppenderConfig::m_queue_size) is full.
+enum class OverflowPolicy {
+  // The caller waits for room.
+  BLOCK = 0,
+  // The new event is dropped.
+  DROP_NEWEST = 1,
+  // The oldest queued event is dropped.
+  DROP_OLDEST = 2,
+  // Events less severe than m_overflow_keep_level are dropped, least severe first. The caller
+  // waits for room only if every queued event is at or above that level.
+  DROP_BELOW_LEVEL = 3
+};
+
+const inline OverflowPolicy OverflowPolicyFromString(const std::string & overflow_policy) {
+  OverflowPolicy result = OverflowPolicy::BLOCK;
+  if (overflow_policy == "BLOCK") result = OverflowPolicy::BLOCK;
+  else if (overflow_policy == "DROP_NEWEST") result = OverflowPolicy::DROP_NEWEST;
+  else if (overflow_policy == "DROP_OLDEST") result = OverflowPolicy::DROP_OLDEST;
+  else if (overflow_policy == "DROP_BELOW_LEVEL") result = OverflowPolicy::DROP_BELOW_LEVEL;
+  else throw std::invalid_argument("Invalid overflow policy.");
+  return result;
+}
+
+// Compression of rotated log files.
+enum class CompressionType {
+  NONE = 0,
+  GZIP = 1,
+  ZSTD = 2
+};
+
+const inline CompressionType CompressionTypeFromString(const std::string & compression_type) {
+  CompressionType result = CompressionType::NONE;
+  if (compression_type == "NONE") result = CompressionType::NONE;
+  else if (compression_type == "GZIP") result = CompressionType::GZIP;
+  else if (compression_type == "ZSTD") result = CompressionType::ZSTD;
+  else throw std::invalid_argument("Invalid compression type.");
+  return result;
+}
+
 class AppenderConfig {
  public:
+  static constexpr uint32_t kDefaultDedupWindowMs = 1000;
+
   AppenderConfig();
   virtual ~AppenderConfig() = default;
   explicit AppenderConfig(AppenderType appender_type, std::string name, LogLevel m_level = LogLevel::VERBOSE);
   virtual bool IsValidConfig();
   virtual void InitFromCustomParametersStr(const std::string & custom_parameters) {}
+  // True if an appender created from this config can switch to other with IAppender::Reconfigure(),
+  // that is they differ at most in the level and the deduplication settings.
+  virtual bool IsReconfigurableTo(const AppenderConfig & other) const;
+  // Called before an appender created from this config replaces one created from replaced, after
+  // that one has been closed. Lets the new appender continue the output of the old one.
+  virtual void ContinueOutputOf(const AppenderConfig & /*replaced*/) {}
   AppenderType m_appender_type;
   LogLevel m_level;
   std::string m_name;
+  // Layout of appenders which support it and the pattern of the PATTERN layout, empty for the
+  // default pattern.
+  LayoutType m_layout = LayoutType::PATTERN;
+  std::string m_pattern;
+  // Exact repeats of events at or above this level within the window are counted instead of
+  // written, see LogDeduplicator. OFF or a window of 0 disables it.
+  LogLevel m_dedup_level = LogLevel::WARN;
+  uint32_t m_dedup_window_ms = kDefaultDedupWindowMs;
+  // Size of the queue between the callers and a thread of the appender which writes the events
+  // (see AsyncAppender), 0 writes on the calling thread. Only read when the appender is created.
+  std::size_t m_queue_size = 0;
+  OverflowPolicy m_overflow_policy = OverflowPolicy::BLOCK;
+  // Least severe level which DROP_BELOW_LEVEL never drops.
+  LogLevel m_overflow_keep_level = LogLevel::ERROR;
 };
 
 class AraLogAppenderConfig : public AppenderConfig {
@@ -67,23 +149,67 @@ class AraLogAppenderConfig : public AppenderConfig {
   explicit AraLogAppenderConfig(AppenderType appender_type, std::string name, std::string app_id, std::string app_description, std::string log_mode, std::string directory_path);
   bool IsValidConfig() override;
   void InitFromCustomParametersStr(const std::string & custom_parameters) override;
+  bool IsReconfigurableTo(const AppenderConfig & other) const override;
   std::string m_app_id;
   std::string m_app_description;
   std::string m_log_mode;
   std::string m_directory_path;
 };
 
+class ConsoleAppenderConfig : public AppenderConfig {
+ public:
+  static constexpr std::size_t kDefaultBufferSize = 64 * 1024;
+  static constexpr uint32_t kDefaultFlushIntervalMs = 1000;
+
+  ConsoleAppenderConfig(AppenderType appender_type, std::string name, LogLevel m_level = LogLevel::VERBOSE);
+  void InitFromCustomParametersStr(const std::string & custom_parameters) override;
+  bool IsReconfigurableTo(const AppenderConfig & other) const override;
+  // STREAM writes through std::cout and flushes every line, DIRECT writes to fd 1/2 with its own buffer.
+  std::string m_output_mode = "STREAM";
+  // DIRECT mode only. LINE writes every line, BLOCK writes when the buffer is full, AUTO uses LINE on a TTY
+  // and BLOCK otherwise.
+  std::string m_buffering = "AUTO";
+  std::size_t m_buffer_size = kDefaultBufferSize;
+  // Period of the background flush with BLOCK buffering, 0 disables it.
+  uint32_t m_flush_interval_ms = kDefaultFlushIntervalMs;
+  // DIRECT mode only. "TRUE" writes ERROR and FATAL to stderr.
+  std::string m_errors_to_stderr = "FALSE";
+};
+
 class FileAppenderConfig : public AppenderConfig {
  public:
+  static constexpr std::size_t kDefaultBufferSize = 64 * 1024;
+  static constexpr uint32_t kDefaultFlushIntervalMs = 1000;
+
   FileAppenderConfig(AppenderType appender_type, std::string name);
   explicit FileAppenderConfig(AppenderType appender_type, std::string name, std::string output_file_path, std::string add_timestamp_to_file_name, std::string file_name_prefix, std::string open_mode);
   explicit FileAppenderConfig(AppenderType appender_type, std::string name, LogLevel m_level, std::string output_file_path, std::string add_timestamp_to_file_name, std::string file_name_prefix, std::string open_mode);
   bool IsValidConfig() override;
   void InitFromCustomParametersStr(const std::string & custom_parameters) override;
+  bool IsReconfigurableTo(const AppenderConfig & other) const override;
+  // A FILE appender writing to the same file appends to it instead of truncating what the replaced
+  // appender wrote.
+  void ContinueOutputOf(const AppenderConfig & replaced) override;
   std::string m_output_file_path;
   std::string m_add_timestamp_to_file_name;
   std::string m_file_name_prefix;
   std::string m_open_mode;
+  // Bytes buffered before they are written to the file, 0 flushes after every message.
+  // Opt-in for FILE, which flushes every message by default; BINARY and TRACE buffer kDefaultBufferSize.
+  std::size_t m_buffer_size;
+  // Period of the background flush, 0 disables it. Only used with a buffer.
+  uint32_t m_flush_interval_ms = kDefaultFlushIntervalMs;
+  // Messages at or above this level are flushed right away.
+  LogLevel m_flush_level = LogLevel::ERROR;
+  // Rotate once the file reaches this many bytes, 0 disables size based rotation.
+  std::size_t m_max_file_size = 0;
+  // Rotate after this many seconds, 0 disables time based rotation.
+  uint32_t m_rotation_interval_sec = 0;
+  // Rotated files kept next to the active one, 0 keeps all of them.
+  uint32_t m_max_files = 0;
+  // Compression of rotated files and the number of files compressed at the same time.
+  CompressionType m_compression = CompressionType::NONE;
+  uint32_t m_max_compression_jobs = 1;
 };
 
 }  // namespace logging
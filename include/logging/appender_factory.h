@@ -26,7 +26,10 @@
 #include <memory>
 #include <utility>
 #include "appender_interface.h"
+#include "logging/async_appender.h"
 #include "console_appender.h"
+#include "logging/binary_appender.h"
+#include "logging/trace_appender.h"
 #include "logging/file_appender.h"
 #ifdef ARALOG
 #include "logging/aralog_appender.h"
@@ -36,9 +39,29 @@ namespace logging {
 
 class AppenderFactory {
  public:
+  // Appenders with AppenderConfig::m_queue_size > 0 are wrapped into an AsyncAppender.
   template <class T>
   static std::unique_ptr<IAppender> CreateAppender(std::unique_ptr<AppenderConfig> appender_config) {
-          return std::unique_ptr<IAppender>(new T(std::move(appender_config)));
+          const bool is_queued = appender_config->m_queue_size > 0;
+          std::unique_ptr<IAppender> appender(new T(std::move(appender_config)));
+          if (is_queued) {
+            appender.reset(new AsyncAppender(std::move(appender)));
+          }
+          return appender;
+  }
+
+  // Appender of the type in appender_config, nullptr for types which have no appender in this build.
+  static std::unique_ptr<IAppender> CreateAppenderFromConfig(std::unique_ptr<AppenderConfig> appender_config) {
+    switch (appender_config->m_appender_type) {
+      case (AppenderType::CONSOLE) : return CreateAppender<ConsoleAppender>(std::move(appender_config));
+      case (AppenderType::FILE) : return CreateAppender<FileAppender>(std::move(appender_config));
+      case (AppenderType::BINARY) : return CreateAppender<BinaryAppender>(std::move(appender_config));
+      case (AppenderType::TRACE) : return CreateAppender<TraceAppender>(std::move(appender_config));
+#ifdef ARALOG
+      case (AppenderType::ARALOG) : return CreateAppender<AraLogAppender>(std::move(appender_config));
+#endif
+      default : return nullptr;
+    }
   }
 };
 
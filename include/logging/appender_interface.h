@@ -28,14 +28,17 @@
 #include <vector>
 
 #include "logging/log_event.h"
+#include "logging/log_statistics.h"
 
 namespace logging {
 
 class IAppender;
 
 using AppenderUnqPtr = std::unique_ptr<IAppender>;
+using AppenderSharedPtr = std::shared_ptr<IAppender>;
 using AppenderRawPtr = IAppender*;
-using AppenderList = std::vector<AppenderUnqPtr>;
+using AppenderList = std::vector<AppenderSharedPtr>;
+using AppenderListPtr = std::shared_ptr<const AppenderList>;
 
 class IAppender {
  public:
@@ -53,9 +56,30 @@ class IAppender {
 
   virtual void SetAppenderConfig(std::unique_ptr<AppenderConfig> appender_config) = 0;
 
+  // Switches to the level and deduplication settings of appender_config while events are written,
+  // if the rest matches the current config (see AppenderConfig::IsReconfigurableTo). False if the
+  // appender has to be recreated for appender_config instead.
+  virtual bool Reconfigure(const AppenderConfig & /*appender_config*/) { return false; }
+
   virtual void Close() = 0;
+
+  // Pushes buffered output to its destination.
+  virtual void Flush() = 0;
+
+  // Writes the counts of suppressed repeats whose window has passed. Called periodically by the
+  // LogManager, so a streak is reported even if nothing else is logged after it.
+  virtual void ReportExpiredRepeats() {}
+
+  // Adds the counters of this appender to statistics. Appenders without counters leave it unchanged.
+  virtual void CollectStatistics(AppenderStatistics & /*statistics*/) const {}
 };
 
+// Levels written by an appender configured with appender_level. Unlike loggers,
+// an appender with NOT_SELECTED writes nothing.
+inline uint32_t AppenderLevelMask(LogLevel appender_level) {
+  return appender_level == LogLevel::NOT_SELECTED ? 0 : LogLevelMask(appender_level);
+}
+
 }  // namespace logging
 
 
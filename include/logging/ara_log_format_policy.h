@@ -31,7 +31,7 @@ namespace logging {
 class AraLogFormatPolicy {
  public:
   std::string FormatMessage(const LogEvent & event) const {
-    return std::string ("[" + event.m_logger_name + "] " + event.m_message);
+    return std::string ("[" + event.m_logger_name + "] " + event.GetMessage());
   }
 };
 
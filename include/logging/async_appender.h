@@ -0,0 +1,129 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef INCLUDE_LOGGING_ASYNC_APPENDER_H_
+#define INCLUDE_LOGGING_ASYNC_APPENDER_H_
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "logging/appender_interface.h"
+
+namespace logging {
+
+// Puts a bounded queue and a writer thread in front of another appender, so callers only wait for
+// the sink as the overflow policy allows. Created by AppenderFactory for configs with m_queue_size > 0
+// and owns the wrapped appender; the queue settings are taken from the config of the wrapped appender.
+//
+// Events the wrapped appender would filter by level are not queued. Dropped events are counted per
+// level and reported to the wrapped appender as "N events dropped", at the most severe dropped level,
+// when the writer thread next takes events from the queue.
+class AsyncAppender : public IAppender {
+ public:
+  explicit AsyncAppender(AppenderUnqPtr appender);
+  ~AsyncAppender() override;
+
+  AsyncAppender(const AsyncAppender&) = delete;
+  AsyncAppender& operator = (const AsyncAppender&) = delete;
+
+  void Send(const LogEvent & log_event) override;
+  // Waits until the events queued before the call are written, then flushes the wrapped appender.
+  void Flush() override;
+  // Writes what is queued, stops the writer thread and closes the wrapped appender. Events sent while
+  // the queue drains are still queued, later events are written on the calling thread.
+  void Close() override;
+
+  AppenderType GetAppenderType() override { return m_appender->GetAppenderType(); }
+  std::string GetAppenderName() override { return m_appender->GetAppenderName(); }
+  LogLevel GetAppenderLogLevel() override { return m_appender->GetAppenderLogLevel(); }
+  const AppenderConfig& GetAppenderConfig() const override { return m_appender->GetAppenderConfig(); }
+  // The queue keeps its size and policy.
+  void SetAppenderConfig(std::unique_ptr<AppenderConfig> appender_config) override { m_appender->SetAppenderConfig(std::move(appender_config)); }
+  // The queue settings are part of the compared config, so they can't change here.
+  bool Reconfigure(const AppenderConfig & appender_config) override { return m_appender->Reconfigure(appender_config); }
+  // Written by the calling thread, the suppressed repeats have already left the queue.
+  void ReportExpiredRepeats() override { m_appender->ReportExpiredRepeats(); }
+  // Statistics of the wrapped appender plus the events dropped by the queue.
+  void CollectStatistics(AppenderStatistics & statistics) const override;
+
+  IAppender * GetWrappedAppender() const { return m_appender.get(); }
+  uint64_t GetDroppedCount(LogLevel log_level) const;
+  uint64_t GetDroppedCount() const;
+
+ private:
+  static constexpr std::size_t kNumLevels = static_cast<std::size_t>(LogLevel::VERBOSE) + 1;
+
+  struct QueuedEvent {
+    uint64_t m_sequence;
+    LogEvent m_log_event;
+  };
+  using LevelQueues = std::array<std::deque<QueuedEvent>, kNumLevels>;
+
+  // Level of the queue holding the oldest event, kNumLevels if all are empty.
+  static std::size_t FindOldest(const LevelQueues & queues);
+
+  void Run();
+  void Stop();
+  // Requires m_mtx to be held. Make room according to m_overflow_policy, false if log_event has to
+  // be dropped instead.
+  bool MakeRoomLocked(std::unique_lock<std::mutex> & lock, const LogEvent & log_event);
+  // Requires m_mtx to be held. Drops the oldest queued event less severe than log_level and the
+  // keep level, least severe first, in constant time. False if there is none.
+  bool DropLessSevereLocked(LogLevel log_level);
+  void CountDropLocked(LogLevel log_level);
+  void SendDropReport(uint64_t count, LogLevel log_level);
+
+  AppenderUnqPtr m_appender;
+  const std::size_t m_capacity;
+  const OverflowPolicy m_overflow_policy;
+  const LogLevel m_overflow_keep_level;
+
+  mutable std::mutex m_mtx;
+  std::condition_variable m_not_empty_cv;
+  std::condition_variable m_not_full_cv;
+  std::condition_variable m_written_cv;
+  // Queued events by level, each in the order they were sent; the sequence numbers give the order
+  // across levels. Keeps finding a victim for DROP_BELOW_LEVEL independent of the queue length.
+  LevelQueues m_queues;
+  std::size_t m_queue_size = 0;
+  uint64_t m_next_sequence = 0;
+  // Events accepted into the queue and events written or dropped out of it, for Flush().
+  uint64_t m_accepted_count = 0;
+  uint64_t m_done_count = 0;
+  // Drops not yet reported and the most severe level among them.
+  uint64_t m_unreported_drops = 0;
+  LogLevel m_unreported_level = LogLevel::VERBOSE;
+  bool m_stop_requested = false;
+  // Set by the writer thread once it has written everything, written under m_mtx.
+  std::atomic<bool> m_is_stopped {false};
+  std::array<std::atomic<uint64_t>, kNumLevels> m_dropped_per_level {};
+  std::thread m_thread;
+};
+
+}  // namespace logging
+
+#endif  // INCLUDE_LOGGING_ASYNC_APPENDER_H_
@@ -0,0 +1,91 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef INCLUDE_LOGGING_ASYNC_LOG_WORKER_H_
+#define INCLUDE_LOGGING_ASYNC_LOG_WORKER_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "logging/log_event.h"
+#include "logging/mpsc_queue.h"
+
+namespace logging {
+
+class Logger;
+
+struct AsyncLogRecord {
+  const Logger * m_logger = nullptr;
+  LogEvent m_log_event;
+};
+
+// Backend of the asynchronous logging mode. Producers (Logger::Write) push events into a bounded
+// lock-free queue and a dedicated thread drains them into the appenders of the issuing logger.
+class AsyncLogWorker {
+ public:
+  static constexpr std::size_t kDefaultQueueCapacity = 8192;
+
+  AsyncLogWorker() = default;
+  ~AsyncLogWorker();
+
+  AsyncLogWorker(const AsyncLogWorker&) = delete;
+  AsyncLogWorker& operator = (const AsyncLogWorker&) = delete;
+
+  // Returns false if the worker is already running.
+  bool Start(std::size_t queue_capacity = kDefaultQueueCapacity);
+  // Stops accepting new events, drains everything already queued and joins the backend thread.
+  void Stop();
+  // Blocks until every event enqueued before this call has been handed to the appenders.
+  void Flush();
+  bool IsRunning() const { return m_accepting.load(std::memory_order_acquire); }
+
+  // Blocks while the queue is full. Returns false if the worker is not running, or the queue is full and
+  // the caller is the backend thread itself, in that case the caller has to write the event synchronously.
+  // log_event is only moved from on success.
+  bool Enqueue(const Logger * logger, LogEvent & log_event);
+
+ private:
+  void Run();
+  void WakeUpBackend();
+
+  std::unique_ptr<MpscQueue<AsyncLogRecord>> m_queue;
+  std::thread m_thread;
+  std::atomic<bool> m_accepting {false};
+  std::atomic<bool> m_stop_requested {false};
+  std::atomic<std::size_t> m_active_producers {0};
+  std::atomic<std::size_t> m_processed_count {0};
+  std::atomic<std::size_t> m_flush_waiters {0};
+  std::atomic<bool> m_backend_waiting {false};
+  // Set by Run(), lets Enqueue() recognize calls from appenders on the backend thread.
+  std::atomic<std::thread::id> m_backend_thread_id {std::thread::id()};
+  std::mutex m_start_stop_mtx;
+  std::mutex m_mtx;
+  std::condition_variable m_backend_cv;
+  std::condition_variable m_flush_cv;
+};
+
+}  // namespace logging
+
+#endif  // INCLUDE_LOGGING_ASYNC_LOG_WORKER_H_
@@ -0,0 +1,86 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef INCLUDE_LOGGING_BINARY_APPENDER_H_
+#define INCLUDE_LOGGING_BINARY_APPENDER_H_
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "logging/appender_base.h"
+#include "logging/log_arguments.h"
+#include "logging/periodic_task.h"
+
+namespace logging {
+
+// Writes events in the compact format of binary_log_format.h to <prefix>.bin, configured with a
+// FileAppenderConfig of type BINARY. Logger names, format strings and field keys are written once
+// per file and referenced by id, deferred messages (LOG_*_FMT) keep their arguments unformatted.
+// Buffering and flushing follow the FileAppender settings; the file is always truncated and
+// rotation is not supported. Decode the file with the logcat tool or BinaryLogReader.
+class BinaryAppender : public AppenderBase {
+ public:
+  explicit BinaryAppender(std::unique_ptr<AppenderConfig> appender_config, bool is_closed = false);
+  ~BinaryAppender() override;
+  void Close() override;
+
+  // Bytes written to the file so far, including the header.
+  uint64_t GetBytesWritten();
+
+ protected:
+  void HookedDoSend(const LogEvent & log_event) final;
+  void HookedFlush() final;
+
+ private:
+  void WriteHeader();
+  void WriteRecord(const std::string & record);
+  uint64_t GetLoggerId(const std::string & logger_name);
+  uint64_t GetStringId(const char * value);
+  uint64_t DefineString(const char * value, std::size_t length);
+  void AppendArguments(const LogArguments & arguments, std::string & output);
+
+  std::mutex m_mtx;
+  std::string m_filename;
+  std::unique_ptr<char[]> m_buffer;
+  std::ofstream m_ofs;
+  uint64_t m_bytes_written;
+  uint32_t m_flush_level_mask;
+  bool m_has_unflushed;
+  int64_t m_last_timestamp;
+  std::unordered_map<std::string, uint64_t> m_logger_ids;
+  // Keyed by contents, format strings and keys don't have to be literals.
+  std::unordered_map<std::string, uint64_t> m_string_ids;
+  // Reused for lookups in m_string_ids.
+  std::string m_string_key;
+  uint64_t m_next_string_id;
+  // Reused for every event, the definitions are written before it.
+  std::string m_record;
+  std::string m_definition;
+  PeriodicTask m_flush_task;
+};
+
+}  // namespace logging
+
+#endif  // INCLUDE_LOGGING_BINARY_APPENDER_H_
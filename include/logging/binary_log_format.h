@@ -0,0 +1,97 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef INCLUDE_LOGGING_BINARY_LOG_FORMAT_H_
+#define INCLUDE_LOGGING_BINARY_LOG_FORMAT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace logging {
+
+// Binary log file written by BinaryAppender and read by BinaryLogReader.
+//
+// File header:
+//   magic "LOGBIN\0", version byte,
+//   varint start time (unix nanoseconds),
+//   varint metadata length, metadata as "key=value\n" lines.
+// Followed by records, each a varint length and that many bytes starting with a BinaryRecordType byte.
+// Readers skip record types they don't know.
+//   LOGGER: varint id, name bytes.
+//   STRING: varint id, bytes of a format string or field key.
+//   EVENT:  level byte, varint logger id, zigzag varint timestamp delta (ns) to the previous event
+//           (the start time for the first one), varint thread id, varint format string id,
+//           varint argument count, the arguments and then the fields up to the end of the record.
+// The format string id is 0 for a plain message, which follows as varint length and bytes.
+// Arguments are a LogArgumentType byte followed by: 1 byte (BOOL, CHAR), zigzag varint (INT64),
+// varint (UINT64, POINTER), 8 little endian bytes (DOUBLE), varint length and bytes (STRING),
+// varint string id (KEY). Fields are KEY arguments each followed by the value.
+// Ids are assigned from 1 on in order of first use and are valid until the end of the file.
+constexpr char kBinaryLogMagic[] = "LOGBIN";
+constexpr std::size_t kBinaryLogMagicSize = sizeof(kBinaryLogMagic);
+constexpr uint8_t kBinaryLogVersion = 1;
+// Readers reject larger records and metadata as corrupt instead of allocating for them.
+constexpr uint64_t kBinaryLogMaxRecordSize = 256 * 1024 * 1024;
+constexpr uint64_t kBinaryLogMaxMetadataSize = 64 * 1024;
+
+enum class BinaryRecordType : uint8_t {
+  LOGGER = 1,
+  STRING = 2,
+  EVENT = 3
+};
+
+inline void AppendVarint(uint64_t value, std::string & output) {
+  while (value >= 0x80) {
+    output += static_cast<char>((value & 0x7f) | 0x80);
+    value >>= 7;
+  }
+  output += static_cast<char>(value);
+}
+
+inline void AppendZigZag(int64_t value, std::string & output) {
+  AppendVarint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63), output);
+}
+
+// Returns the position after the varint or nullptr if it doesn't end before data_end.
+inline const char * ReadVarint(const char * data, const char * data_end, uint64_t & value) {
+  value = 0;
+  for (unsigned shift = 0; data < data_end && shift < 64; shift += 7) {
+    uint8_t byte = static_cast<uint8_t>(*data++);
+    value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0) {
+      return data;
+    }
+  }
+  return nullptr;
+}
+
+inline const char * ReadZigZag(const char * data, const char * data_end, int64_t & value) {
+  uint64_t encoded = 0;
+  data = ReadVarint(data, data_end, encoded);
+  value = static_cast<int64_t>((encoded >> 1) ^ (~(encoded & 1) + 1));
+  return data;
+}
+
+}  // namespace logging
+
+#endif  // INCLUDE_LOGGING_BINARY_LOG_FORMAT_H_
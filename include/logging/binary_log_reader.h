@@ -0,0 +1,72 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef INCLUDE_LOGGING_BINARY_LOG_READER_H_
+#define INCLUDE_LOGGING_BINARY_LOG_READER_H_
+
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <unordered_map>
+#include "logging/log_arguments.h"
+#include "logging/log_event.h"
+
+namespace logging {
+
+// Decodes files written by BinaryAppender (see binary_log_format.h) back into LogEvents.
+class BinaryLogReader {
+ public:
+  explicit BinaryLogReader(std::istream & input) : m_input(input) {}
+
+  // Reads the file header, false if the input is not a binary log of a supported version.
+  bool ReadHeader();
+  // Reads up to the next event. Deferred messages come back with m_format and m_arguments set,
+  // m_format stays valid as long as the reader. unix_nanos receives the event time. Returns false
+  // at the end of the input or at a truncated or corrupt record.
+  bool ReadEvent(LogEvent & log_event, int64_t & unix_nanos);
+
+  // True once ReadEvent stopped at the end of the input rather than at a broken record.
+  bool IsAtEnd() const { return m_is_at_end; }
+  int64_t GetStartTime() const { return m_start_time; }
+  // "key=value\n" lines of the header.
+  const std::string & GetMetadata() const { return m_metadata; }
+
+ private:
+  bool ReadRecord();
+  bool ParseEvent(const char * data, const char * data_end, LogEvent & log_event, int64_t & unix_nanos);
+  // Reads up to count arguments (all until data_end for SIZE_MAX), nullptr if they are corrupt.
+  const char * ReadArguments(const char * data, const char * data_end, uint64_t count, LogArguments & arguments);
+
+  std::istream & m_input;
+  std::string m_record;
+  std::string m_metadata;
+  int64_t m_start_time = 0;
+  int64_t m_last_timestamp = 0;
+  bool m_is_at_end = false;
+  std::unordered_map<uint64_t, std::string> m_loggers;
+  // Map nodes don't move, so c_str() of the entries can be handed out as format strings and keys.
+  std::unordered_map<uint64_t, std::string> m_strings;
+};
+
+}  // namespace logging
+
+#endif  // INCLUDE_LOGGING_BINARY_LOG_READER_H_
@@ -0,0 +1,72 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef INCLUDE_LOGGING_CONFIG_FILE_WATCHER_H_
+#define INCLUDE_LOGGING_CONFIG_FILE_WATCHER_H_
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+#include "logging/periodic_task.h"
+
+namespace logging {
+
+// Calls a callback on its own thread after a file was written or replaced.
+// On Linux it waits on inotify for the directory of the file, so editors which save by renaming a
+// temporary file are seen as well. Bursts of events are collapsed into one call. Elsewhere the
+// modification time is polled.
+class ConfigFileWatcher {
+ public:
+  static constexpr int kDebounceMs = 50;
+  static constexpr int kPollIntervalMs = 500;
+
+  ConfigFileWatcher() = default;
+  ~ConfigFileWatcher();
+
+  ConfigFileWatcher(const ConfigFileWatcher&) = delete;
+  ConfigFileWatcher& operator = (const ConfigFileWatcher&) = delete;
+
+  // Returns false if the watcher is already running or the file can't be watched.
+  // Changes made after Start returns are reported.
+  bool Start(const std::string & file_name, std::function<void()> on_change);
+  // Joins the thread. The callback is not called again after Stop returns.
+  void Stop();
+  bool IsRunning() const { return m_thread.joinable() || m_poll_task.IsRunning(); }
+
+ private:
+  void Run();
+  void PollModificationTime();
+
+  std::string m_file_name;
+  std::function<void()> m_on_change;
+  std::thread m_thread;
+  int m_inotify_fd = -1;
+  int m_stop_pipe[2] = {-1, -1};
+  PeriodicTask m_poll_task;
+  int64_t m_modification_time = 0;
+  int64_t m_file_size = 0;
+};
+
+}  // namespace logging
+
+#endif  // INCLUDE_LOGGING_CONFIG_FILE_WATCHER_H_
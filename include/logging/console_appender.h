@@ -23,26 +23,44 @@
 #ifndef INCLUDE_LOGGING_CONSOLE_APPENDER_H_
 #define INCLUDE_LOGGING_CONSOLE_APPENDER_H_
 
+#include <cstddef>
 #include <memory>
+#include <mutex>
+#include <string>
 #include "logging/appender_base.h"
 #include "logging/message_appender.h"
-#include "logging/default_format_policy_with_newline.h"
+#include "logging/layout_format_policy.h"
+#include "logging/periodic_task.h"
 
 namespace logging {
 
+// Writes through std::cout by default. With ConsoleAppenderConfig::m_output_mode DIRECT lines are
+// collected in an own buffer and written to fd 1 (and fd 2 for ERROR/FATAL if configured) with
+// write(2), either per line or once the buffer is full.
 class ConsoleAppender : public AppenderBase {
  public:
-  using MessageAppenderHost = MessageAppender<DefaultFormatPolicyWithNewLine>;
+  using MessageAppenderHost = MessageAppender<LayoutFormatPolicy>;
   ConsoleAppender();
   explicit ConsoleAppender(std::unique_ptr<AppenderConfig> appender_config, bool is_closed = false);
+  ~ConsoleAppender() override;
   void Close() override;
 
  protected:
   void HookedDoSend(const LogEvent & log_event) final;
-  void Flush() const { std::cout << std::flush; }
+  void HookedFlush() final;
 
  private:
+  void FlushLocked();
+
+  // Loggers write without locking, this keeps lines from different threads apart.
+  std::mutex m_mtx;
   MessageAppenderHost m_message_appender_host;
+  bool m_is_direct;
+  bool m_is_line_buffered;
+  bool m_errors_to_stderr;
+  std::size_t m_buffer_size;
+  std::string m_buffer;
+  PeriodicTask m_flush_task;
 };
 
 }  // namespace logging
@@ -31,7 +31,7 @@ namespace logging {
 class DefaultFormatPolicy {
  public:
   std::string FormatMessage(const LogEvent & log_event) {
-    return std::string ("[" + log_event.m_logger_name + "] " + log_event.m_message);
+    return std::string ("[" + log_event.m_logger_name + "] " + log_event.GetMessage());
   }
 };
 
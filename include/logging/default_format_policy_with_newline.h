@@ -31,7 +31,7 @@ namespace logging {
 class DefaultFormatPolicyWithNewLine {
  public:
   std::string FormatMessage(const LogEvent & log_event) {
-    return std::string ("[" + LogLevelToString(log_event.m_log_level) + "][" + log_event.m_logger_name + "] " + log_event.m_message + '\n');
+    return std::string ("[" + LogLevelToString(log_event.m_log_level) + "][" + log_event.m_logger_name + "] " + log_event.GetMessage() + '\n');
   }
 };
 
@@ -24,31 +24,91 @@
 #define INCLUDE_LOGGING_FILE_APPENDER_H_
 
 #include <stdio.h>
+#include <chrono>
+#include <cstdint>
 #include <thread>
 #include <memory>
+#include <mutex>
 #include <fstream>
 #include <string>
+#include <vector>
 #include "logging/appender_base.h"
 #include "logging/message_appender.h"
-#include "logging/default_format_policy_with_newline.h"
+#include "logging/layout_format_policy.h"
+#include "logging/file_compressor.h"
+#include "logging/periodic_task.h"
 
 namespace logging {
 
+// file_name_prefix followed by the local time as yy-mm-dd-HH-MM-SS.
+std::string GetTimeStampedFileName(const std::string & file_name_prefix);
+
+// Writes into a buffer of FileAppenderConfig::m_buffer_size bytes which reaches the file when it
+// is full, on the periodic background flush, on messages at or above the flush level and on
+// Flush()/Close().
+//
+// With rotation enabled the active file is always <prefix>.txt and rotated files are
+// <prefix>.<n>.txt with n increasing. Rollover runs on a background thread: it renames the active
+// file, opens a new one and swaps it in under the lock, then closes the old stream and removes the
+// oldest rotated files beyond m_max_files. Writers only wait for the swap. Rotated files can be
+// handed to a FileCompressor which replaces them with <prefix>.<n>.txt.gz or .zst.
 class FileAppender : public AppenderBase {
  public:
-  using MessageAppenderHost = MessageAppender<DefaultFormatPolicyWithNewLine>;
+  using MessageAppenderHost = MessageAppender<LayoutFormatPolicy>;
   explicit FileAppender(std::unique_ptr<AppenderConfig> appender_config, bool is_closed = false);
+  ~FileAppender() override;
   void Close() override;
 
  protected:
   void HookedDoSend(const LogEvent & log_event) final;
-  void Flush() { m_ofs << std::flush; }
+  void HookedFlush() final;
 
  private:
+  struct OutputFile {
+    std::unique_ptr<char[]> m_buffer;
+    std::ofstream m_ofs;
+    // Bytes in the file, including what was there before it was opened in APPEND mode.
+    std::size_t m_size = 0;
+    bool m_has_messages = false;
+  };
+
+  std::unique_ptr<OutputFile> OpenOutputFile(const std::string & open_mode);
+  void FlushLocked();
+  bool IsRotationEnabled() const { return m_max_file_size > 0 || m_rotation_interval.count() > 0; }
+  // Runs on m_rotation_task.
+  void RotateIfNeeded();
+  void Rotate();
+  std::string GetRotatedFileName(uint64_t sequence) const;
+  // Sequence numbers of the rotated files on disk, oldest first.
+  std::vector<uint64_t> ListRotatedFiles() const;
+  void RemoveOldRotatedFiles();
+
   std::mutex m_mtx;
+  // Directory with trailing '/' and file name without ".txt" of the active file.
+  std::string m_directory;
+  std::string m_file_stem;
   std::string m_filename;
-  std::ofstream m_ofs;
+  std::size_t m_buffer_size;
+  std::unique_ptr<OutputFile> m_file;
+  // Levels flushed right after they are written.
+  uint32_t m_flush_level_mask;
+  bool m_has_unflushed;
   MessageAppenderHost m_message_appender_host;
+
+  std::size_t m_max_file_size;
+  std::chrono::seconds m_rotation_interval;
+  uint32_t m_max_files;
+  CompressionType m_compression;
+  bool m_rotation_requested;
+  // Only used on the rotation thread.
+  std::chrono::steady_clock::time_point m_next_rotation_time;
+  uint64_t m_next_sequence;
+
+  PeriodicTask m_flush_task;
+  PeriodicTask m_rotation_task;
+  // Serializes pruning between the rotation and the compression threads.
+  std::mutex m_prune_mtx;
+  FileCompressor m_compressor;
 };
 
 }  // namespace logging
@@ -0,0 +1,79 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef INCLUDE_LOGGING_FILE_COMPRESSOR_H_
+#define INCLUDE_LOGGING_FILE_COMPRESSOR_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include "logging/appender_config.h"
+
+namespace logging {
+
+// Compresses finished log files on low priority background threads. <file> is written to
+// <file>.gz or <file>.zst and removed once the compressed copy is complete.
+class FileCompressor {
+ public:
+  FileCompressor() = default;
+  ~FileCompressor();
+
+  FileCompressor(const FileCompressor&) = delete;
+  FileCompressor& operator = (const FileCompressor&) = delete;
+
+  // Whether this build can write compression_type (ZSTD needs LOGGING_HAVE_ZSTD).
+  static bool IsSupported(CompressionType compression_type);
+  static std::string GetFileExtension(CompressionType compression_type);
+  // Compresses file_name into compressed_file_name on the calling thread.
+  static bool CompressFile(CompressionType compression_type, const std::string & file_name, const std::string & compressed_file_name);
+
+  // Starts max_jobs worker threads. Returns false if already running. on_compressed runs on the
+  // worker thread after each submitted file has been handled.
+  bool Start(CompressionType compression_type, std::size_t max_jobs, std::function<void()> on_compressed = nullptr);
+  // Compresses every submitted file and joins the workers.
+  void Stop();
+  void Submit(const std::string & file_name);
+  // Whether file_name is queued or being compressed.
+  bool IsPending(const std::string & file_name);
+
+ private:
+  void Run();
+
+  CompressionType m_compression_type = CompressionType::NONE;
+  std::vector<std::thread> m_threads;
+  std::function<void()> m_on_compressed;
+  std::deque<std::string> m_pending;
+  std::set<std::string> m_in_progress;
+  bool m_stop_requested = false;
+  std::mutex m_mtx;
+  std::condition_variable m_cv;
+};
+
+}  // namespace logging
+
+#endif  // INCLUDE_LOGGING_FILE_COMPRESSOR_H_
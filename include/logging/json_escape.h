@@ -0,0 +1,41 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef INCLUDE_LOGGING_JSON_ESCAPE_H_
+#define INCLUDE_LOGGING_JSON_ESCAPE_H_
+
+#include <cstddef>
+#include <string>
+
+namespace logging {
+
+// Appends data as the contents of a JSON string (without the quotes). '"', '\\' and control
+// characters are escaped, all other bytes including UTF-8 sequences are copied unchanged.
+// Runs of bytes which need no escaping are found 32 (AVX2) or 16 (SSE2) bytes at a time.
+void AppendJsonEscaped(const char * data, std::size_t length, std::string & output);
+
+// Byte by byte reference implementation, used for the tail of the SIMD paths and in benchmarks.
+void AppendJsonEscapedScalar(const char * data, std::size_t length, std::string & output);
+
+}  // namespace logging
+
+#endif  // INCLUDE_LOGGING_JSON_ESCAPE_H_
@@ -0,0 +1,55 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef INCLUDE_LOGGING_JSON_FORMAT_POLICY_H_
+#define INCLUDE_LOGGING_JSON_FORMAT_POLICY_H_
+
+#include <string>
+#include "logging/log_event.h"
+#include "logging/timestamp_formatter.h"
+
+namespace logging {
+
+// One JSON object per line (NDJSON):
+// {"time":"2024-01-01 12:00:00.000123","level":"INFO","logger":"A","thread":1,"message":"...",
+//  "file":"a.cpp","line":12,"function":"f","fields":{"user_id":42}}
+// Location and fields are left out when the event has none. Like PatternFormatPolicy the returned
+// string is a buffer owned by the policy.
+class JsonFormatPolicy {
+ public:
+  const std::string & FormatMessage(const LogEvent & log_event) {
+    m_buffer.clear();
+    Render(log_event, m_buffer);
+    return m_buffer;
+  }
+
+  // Appends the object and a newline to output.
+  void Render(const LogEvent & log_event, std::string & output);
+
+ private:
+  TimestampFormatter m_timestamp_formatter;
+  std::string m_buffer;
+};
+
+}  // namespace logging
+
+#endif  // INCLUDE_LOGGING_JSON_FORMAT_POLICY_H_
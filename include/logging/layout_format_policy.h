@@ -0,0 +1,59 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef INCLUDE_LOGGING_LAYOUT_FORMAT_POLICY_H_
+#define INCLUDE_LOGGING_LAYOUT_FORMAT_POLICY_H_
+
+#include <string>
+#include "logging/appender_config.h"
+#include "logging/json_format_policy.h"
+#include "logging/log_event.h"
+#include "logging/pattern_format_policy.h"
+
+namespace logging {
+
+// Format policy of the console and file appenders, selects the layout configured per appender.
+class LayoutFormatPolicy {
+ public:
+  void SetLayout(LayoutType layout) { m_layout = layout; }
+  LayoutType GetLayout() const { return m_layout; }
+  void SetPattern(const std::string & pattern) { m_pattern_policy.SetPattern(pattern); }
+
+  // The "####" file header would break line based formats such as JSON.
+  bool HasHeader() const { return m_layout == LayoutType::PATTERN; }
+
+  const std::string & FormatMessage(const LogEvent & log_event) {
+    if (m_layout == LayoutType::JSON) {
+      return m_json_policy.FormatMessage(log_event);
+    }
+    return m_pattern_policy.FormatMessage(log_event);
+  }
+
+ private:
+  LayoutType m_layout = LayoutType::PATTERN;
+  PatternFormatPolicy m_pattern_policy;
+  JsonFormatPolicy m_json_policy;
+};
+
+}  // namespace logging
+
+#endif  // INCLUDE_LOGGING_LAYOUT_FORMAT_POLICY_H_
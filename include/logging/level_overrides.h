@@ -0,0 +1,73 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef INCLUDE_LOGGING_LEVEL_OVERRIDES_H_
+#define INCLUDE_LOGGING_LEVEL_OVERRIDES_H_
+
+#include <map>
+#include <memory>
+#include <regex>
+#include <string>
+#include <utility>
+#include <vector>
+#include "logging/log_level.h"
+
+namespace logging {
+
+// Log levels for families of loggers given by name patterns, built once from the config file.
+// Patterns are globs ('*' any characters including dots, '?' one character) or, prefixed with
+// "regex:", ECMAScript regular expressions. Plain names and globs whose only wildcard is a trailing
+// '*' go into a prefix trie, the others are compiled to regular expressions.
+// A name takes the level of its exact pattern, else of its longest prefix pattern, else of the first
+// other pattern which matches it, in the order they were added.
+class LevelOverrides {
+ public:
+  static constexpr const char * kRegexPrefix = "regex:";
+
+  LevelOverrides() = default;
+  LevelOverrides(const LevelOverrides&) = delete;
+  LevelOverrides& operator = (const LevelOverrides&) = delete;
+
+  // Returns false and adds nothing if pattern is not a valid regular expression.
+  bool Add(const std::string & pattern, LogLevel log_level);
+  // Returns false if no pattern matches name.
+  bool Match(const std::string & name, LogLevel & log_level) const;
+  bool IsEmpty() const { return m_root.m_children.empty() && !m_root.m_has_prefix_level && m_patterns.empty(); }
+
+ private:
+  struct TrieNode {
+    std::map<char, std::unique_ptr<TrieNode>> m_children;
+    bool m_has_exact_level = false;
+    LogLevel m_exact_level = LogLevel::NOT_SELECTED;
+    bool m_has_prefix_level = false;
+    LogLevel m_prefix_level = LogLevel::NOT_SELECTED;
+  };
+
+  TrieNode & GetNode(const std::string & key);
+
+  TrieNode m_root;
+  std::vector<std::pair<std::regex, LogLevel>> m_patterns;
+};
+
+}  // namespace logging
+
+#endif  // INCLUDE_LOGGING_LEVEL_OVERRIDES_H_
@@ -0,0 +1,206 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef INCLUDE_LOGGING_LOG_ARGUMENTS_H_
+#define INCLUDE_LOGGING_LOG_ARGUMENTS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+namespace logging {
+
+enum class LogArgumentType : uint8_t {
+  BOOL = 1,
+  CHAR = 2,
+  INT64 = 3,
+  UINT64 = 4,
+  DOUBLE = 5,
+  POINTER = 6,
+  STRING = 7,
+  // Name of a structured field, stored as a pointer to a string with static storage duration.
+  KEY = 8
+};
+
+// A single decoded argument. m_string/m_length are set for STRING and KEY and point into the
+// argument buffer (or the static key).
+struct LogArgumentValue {
+  LogArgumentType m_type;
+  union {
+    bool m_bool;
+    char m_char;
+    int64_t m_int64;
+    uint64_t m_uint64;
+    double m_double;
+    const void * m_pointer;
+  };
+  const char * m_string = nullptr;
+  std::size_t m_length = 0;
+};
+
+// Compact buffer holding typed copies of the arguments of a deferred log statement.
+// Arguments are stored as a type byte followed by their raw bytes (strings as length + bytes) so capturing
+// them is a few memcpy and the actual text formatting can happen later, e.g. on the backend thread.
+// Small argument lists fit into the inline storage and don't allocate.
+class LogArguments {
+ public:
+  static constexpr std::size_t kInlineCapacity = 96;
+
+  LogArguments() noexcept {}
+  LogArguments(const LogArguments & other) { Assign(other); }
+  LogArguments(LogArguments && other) noexcept { Assign(std::move(other)); }
+  LogArguments & operator = (const LogArguments & other);
+  LogArguments & operator = (LogArguments && other) noexcept;
+
+  void Clear() { m_size = 0; m_count = 0; }
+  bool IsEmpty() const { return m_count == 0; }
+  std::size_t GetCount() const { return m_count; }
+  std::size_t GetSize() const { return m_size; }
+  const char * GetData() const { return m_heap ? m_heap.get() : m_inline; }
+
+  template <class... Args>
+  void Add(const Args &... args) {
+    int expand[] = {0, (AddArgument(args), 0)...};
+    (void)expand;
+  }
+
+  void AddArgument(bool value) { Put(LogArgumentType::BOOL, &value, sizeof(value)); }
+  void AddArgument(char value) { Put(LogArgumentType::CHAR, &value, sizeof(value)); }
+  void AddArgument(double value) { Put(LogArgumentType::DOUBLE, &value, sizeof(value)); }
+  void AddArgument(float value) { AddArgument(static_cast<double>(value)); }
+  void AddArgument(const char * value) { AddString(value, value == nullptr ? 0 : std::strlen(value)); }
+  void AddArgument(const std::string & value) { AddString(value.data(), value.size()); }
+
+  template <class T>
+  typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type AddArgument(T value) {
+    int64_t converted = value;
+    Put(LogArgumentType::INT64, &converted, sizeof(converted));
+  }
+
+  template <class T>
+  typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value>::type AddArgument(T value) {
+    uint64_t converted = value;
+    Put(LogArgumentType::UINT64, &converted, sizeof(converted));
+  }
+
+  template <class T>
+  typename std::enable_if<std::is_enum<T>::value>::type AddArgument(T value) {
+    AddArgument(static_cast<typename std::underlying_type<T>::type>(value));
+  }
+
+  template <class T>
+  void AddArgument(const T * value) {
+    const void * converted = value;
+    Put(LogArgumentType::POINTER, &converted, sizeof(converted));
+  }
+
+  // Structured fields: AddFields("user_id", id, "latency_us", latency) stores each key followed by
+  // its typed value. Keys have to be string literals (or otherwise outlive the event).
+  void AddFields() {}
+  template <class T, class... Rest>
+  void AddFields(const char * key, const T & value, const Rest &... rest) {
+    AddKey(key);
+    AddArgument(value);
+    AddFields(rest...);
+  }
+  void AddKey(const char * key) { Put(LogArgumentType::KEY, &key, sizeof(key)); }
+
+  // Calls visitor(key, value) for every field added with AddFields.
+  template <class Visitor>
+  void ForEachField(Visitor && visitor) const {
+    const char * data = GetData();
+    const char * data_end = data + m_size;
+    LogArgumentValue key;
+    LogArgumentValue value;
+    while (data < data_end) {
+      data = ReadArgument(data, key);
+      if (data >= data_end || key.m_type != LogArgumentType::KEY) {
+        break;
+      }
+      data = ReadArgument(data, value);
+      visitor(key.m_string, value);
+    }
+  }
+
+  // Replaces every "{}" in format with the next argument. "{{" and "}}" are literal braces.
+  void Format(const char * format, std::string & output) const;
+
+  // Appends the text of a single argument starting at data and returns the position after it.
+  static const char * FormatArgument(const char * data, std::string & output);
+
+  // Decodes the argument starting at data and returns the position after it.
+  static const char * ReadArgument(const char * data, LogArgumentValue & value);
+  // Appends the text of a decoded argument, as used by Format.
+  static void AppendValue(const LogArgumentValue & value, std::string & output);
+
+ private:
+  void Assign(const LogArguments & other);
+  void Assign(LogArguments && other) noexcept;
+  void AddString(const char * value, std::size_t length);
+  void Put(LogArgumentType type, const void * value, std::size_t length) {
+    char * destination = Reserve(1 + length);
+    destination[0] = static_cast<char>(type);
+    std::memcpy(destination + 1, value, length);
+    ++m_count;
+  }
+  char * Reserve(std::size_t length) {
+    if (m_size + length > m_capacity) {
+      Grow(m_size + length);
+    }
+    char * destination = (m_heap ? m_heap.get() : m_inline) + m_size;
+    m_size += length;
+    return destination;
+  }
+  void Grow(std::size_t required);
+
+  std::size_t m_size = 0;
+  std::size_t m_count = 0;
+  std::size_t m_capacity = kInlineCapacity;
+  std::unique_ptr<char[]> m_heap;
+  char m_inline[kInlineCapacity];
+};
+
+// Number of "{}" placeholders in a format string, usable in static_assert.
+constexpr std::size_t CountFormatPlaceholders(const char * format) {
+  std::size_t count = 0;
+  while (*format != '\0') {
+    if (format[0] == '{' && format[1] == '{') {
+      format += 2;
+    } else if (format[0] == '{' && format[1] == '}') {
+      ++count;
+      format += 2;
+    } else {
+      ++format;
+    }
+  }
+  return count;
+}
+
+template <class... Args>
+std::integral_constant<std::size_t, sizeof...(Args)> CountFormatArguments(const Args &...);
+
+}  // namespace logging
+
+#endif  // INCLUDE_LOGGING_LOG_ARGUMENTS_H_
@@ -0,0 +1,83 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef INCLUDE_LOGGING_LOG_CLOCK_H_
+#define INCLUDE_LOGGING_LOG_CLOCK_H_
+
+#include <cstdint>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define LOGGING_HAVE_RDTSC 1
+#endif
+
+namespace logging {
+
+// Timestamp source of LogEvent. Now() reads the TSC where it is invariant (a few ns) and
+// steady_clock otherwise. Ticks are converted to wall clock time with a calibration taken once
+// at startup, so conversion only happens when an event is formatted.
+class LogClock {
+ public:
+  static uint64_t Now() {
+#ifdef LOGGING_HAVE_RDTSC
+    if (GetInstance().m_use_tsc) {
+      return __rdtsc();
+    }
+#endif
+    return SteadyNow();
+  }
+
+  // Nanoseconds since the Unix epoch of a value returned by Now().
+  static int64_t ToUnixNanos(uint64_t ticks) {
+    const LogClock & clock = GetInstance();
+    return clock.m_base_unix_nanos + static_cast<int64_t>(static_cast<double>(static_cast<int64_t>(ticks - clock.m_base_ticks)) * clock.m_nanos_per_tick);
+  }
+
+  // Ticks in a duration, for intervals measured with Now().
+  static uint64_t SecondsToTicks(double seconds) {
+    return static_cast<uint64_t>(seconds * GetInstance().m_ticks_per_second);
+  }
+
+  // Nanoseconds in a number of ticks.
+  static double TicksToNanos(double ticks) {
+    return ticks * GetInstance().m_nanos_per_tick;
+  }
+
+  static bool IsUsingTsc() { return GetInstance().m_use_tsc; }
+
+ private:
+  LogClock();
+  static const LogClock & GetInstance() {
+    static const LogClock clock;
+    return clock;
+  }
+  static uint64_t SteadyNow();
+
+  bool m_use_tsc;
+  uint64_t m_base_ticks;
+  int64_t m_base_unix_nanos;
+  double m_nanos_per_tick;
+  double m_ticks_per_second;
+};
+
+}  // namespace logging
+
+#endif  // INCLUDE_LOGGING_LOG_CLOCK_H_
@@ -0,0 +1,110 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef INCLUDE_LOGGING_LOG_DEDUPLICATOR_H_
+#define INCLUDE_LOGGING_LOG_DEDUPLICATOR_H_
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include "logging/log_event.h"
+#include "logging/log_level.h"
+#include "logging/periodic_task.h"
+
+namespace logging {
+
+// "last message repeated N times" owed for a suppressed streak, m_count is 0 if there is none.
+struct RepeatSummary {
+  uint64_t m_count = 0;
+  LogLevel m_log_level = LogLevel::NOT_SELECTED;
+  std::string m_logger_name;
+};
+
+// Drops exact repeats of the last event at or above the dedup level written by an appender. An event
+// with the same logger, level and message as the previous one within the window is counted instead
+// of written. Deferred events (LOG_*_FMT) count as the same message if format and arguments are, they
+// are not formatted for the comparison. Any other event, deduplicated or not, ends the streak. The count is reported before
+// the next event which is written, once per window while the repeats go on, on
+// TakeExpiredRepeats() once the window has passed and on TakePendingRepeats(), called from Flush().
+class LogDeduplicator {
+ public:
+  ~LogDeduplicator();
+
+  // LogLevel::OFF disables deduplication.
+  void SetConfig(LogLevel dedup_level, uint32_t window_ms);
+
+  // Returns false if log_event is a repeat and must not be written. summary receives a streak which
+  // has to be reported before log_event.
+  bool Check(const LogEvent & log_event, RepeatSummary & summary) {
+    if ((m_level_mask.load(std::memory_order_relaxed) & LogLevelBit(log_event.m_log_level)) == 0) {
+      if (m_has_last.load(std::memory_order_relaxed)) {
+        EndStreak(summary);
+      }
+      return true;
+    }
+    return CheckRepeat(log_event, summary);
+  }
+
+  // Takes the count of a streak still going on, false if there is none.
+  bool TakePendingRepeats(RepeatSummary & summary);
+  // Like TakePendingRepeats() but only once the window of the streak has passed at now (LogClock
+  // ticks). Later repeats are counted in a new window.
+  bool TakeExpiredRepeats(uint64_t now, RepeatSummary & summary);
+
+  // Deduplicators of the process with suppressed repeats waiting to be reported.
+  static uint32_t GetNumOpenStreaks() { return m_num_open_streaks.load(std::memory_order_acquire); }
+  // task is woken up whenever the first streak opens while none was open, nullptr for none.
+  static void SetReportTask(PeriodicTask * task) { m_report_task.store(task, std::memory_order_release); }
+
+ private:
+  bool CheckRepeat(const LogEvent & log_event, RepeatSummary & summary);
+  // Takes the pending count and forgets the last event, so its next occurrence is written.
+  void EndStreak(RepeatSummary & summary);
+  // Requires m_mtx to be held.
+  void TakeRepeatsLocked(RepeatSummary & summary);
+  // Requires m_mtx to be held. Counts the first suppressed repeat of a streak.
+  void OpenStreakLocked();
+
+  static std::atomic<uint32_t> m_num_open_streaks;
+  static std::atomic<PeriodicTask *> m_report_task;
+
+  std::atomic<uint32_t> m_level_mask {0};
+  // Set while suppressed repeats wait to be reported, lets other levels skip the lock.
+  std::atomic<bool> m_has_repeats {false};
+  std::mutex m_mtx;
+  uint64_t m_window_ticks = 0;
+  // Written under m_mtx, lets events which bypass deduplication skip the lock when there is no streak.
+  std::atomic<bool> m_has_last {false};
+  uint64_t m_last_hash = 0;
+  LogLevel m_last_level = LogLevel::NOT_SELECTED;
+  std::string m_last_logger_name;
+  // The message of the last event, or for a deferred event its format and the bytes of its arguments.
+  const char * m_last_format = nullptr;
+  std::string m_last_content;
+  uint64_t m_window_end = 0;
+  uint64_t m_repeats = 0;
+};
+
+}  // namespace logging
+
+#endif  // INCLUDE_LOGGING_LOG_DEDUPLICATOR_H_
@@ -25,14 +25,40 @@
 
 #include<string>
 #include "logging/logger_config.h"
+#include "logging/log_arguments.h"
+#include "logging/log_clock.h"
+#include "logging/source_location.h"
 
 namespace logging {
 
 class LogEvent {
  public:
+  // Deferred events (m_format != nullptr) are formatted on first access, i.e. on the thread
+  // which writes to the appenders and only if an appender accepts the event.
+  const std::string & GetMessage() const {
+    if (m_format != nullptr && !m_is_formatted) {
+      m_arguments.Format(m_format, m_message);
+      m_is_formatted = true;
+    }
+    return m_message;
+  }
+
   LogLevel m_log_level;
-  std::string m_message;
+  // LogClock ticks taken when the event was created, see LogClock::ToUnixNanos.
+  uint64_t m_timestamp = 0;
+  // GetCurrentThreadId() of the thread which logged the event.
+  uint32_t m_thread_id = 0;
+  // Set by the LOG_* macros, empty for direct Logger calls such as LogInfo().
+  SourceLocation m_location;
+  mutable std::string m_message;
   std::string m_logger_name;
+  const char * m_format = nullptr;
+  LogArguments m_arguments;
+  // Structured key/value fields (LOG_*_KV), rendered by the format policy of each appender.
+  LogArguments m_fields;
+
+ private:
+  mutable bool m_is_formatted = false;
 };
 
 const inline std::string LogLevelToString(LogLevel log_level) {
@@ -24,6 +24,7 @@
 #define INCLUDE_LOGGING_LOG_LEVEL_H_
 
 #include <string>
+#include <stdexcept>
 #include <cstdint>
 
 namespace logging {
@@ -39,6 +40,34 @@ enum class LogLevel : uint8_t {
   NOT_SELECTED = 8
 };
 
+// Bit of a single level (FATAL..VERBOSE) in level masks.
+constexpr uint32_t LogLevelBit(LogLevel log_level) { return 1u << static_cast<uint8_t>(log_level); }
+
+constexpr uint32_t kAllLogLevelsMask = LogLevelBit(LogLevel::FATAL) | LogLevelBit(LogLevel::ERROR) | LogLevelBit(LogLevel::WARN) |
+                                       LogLevelBit(LogLevel::INFO) | LogLevelBit(LogLevel::DEBUG) | LogLevelBit(LogLevel::VERBOSE);
+
+// Levels passing a threshold: FATAL up to threshold, nothing for OFF and everything for NOT_SELECTED.
+inline uint32_t LogLevelMask(LogLevel threshold) {
+  if (threshold == LogLevel::OFF) return 0;
+  if (threshold == LogLevel::NOT_SELECTED) return kAllLogLevelsMask;
+  return (LogLevelBit(threshold) << 1) - LogLevelBit(LogLevel::FATAL);
+}
+
+// Same names as LogLevellToString without building a std::string.
+inline const char * LogLevelToCString(LogLevel log_level) {
+  switch (log_level) {
+    case LogLevel::FATAL: return "FATAL";
+    case LogLevel::ERROR: return "ERROR";
+    case LogLevel::WARN: return "WARN";
+    case LogLevel::INFO: return "INFO";
+    case LogLevel::DEBUG: return "DEBUG";
+    case LogLevel::VERBOSE: return "VERBOSE";
+    case LogLevel::OFF: return "OFF";
+    case LogLevel::NOT_SELECTED: return "NOT_SELECTED";
+    default: return "Default";
+  }
+}
+
 const inline std::string LogLevellToString(LogLevel log_level) {
   std::string result = "Default";
   if (log_level == LogLevel::FATAL) result = "FATAL";
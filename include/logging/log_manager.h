@@ -23,11 +23,17 @@
 #ifndef INCLUDE_LOGGING_LOG_MANAGER_H_
 #define INCLUDE_LOGGING_LOG_MANAGER_H_
 
+#include <map>
+#include <mutex>
 #include <string>
 #include <memory>
+#include <vector>
+#include "logging/async_log_worker.h"
+#include "logging/config_file_watcher.h"
 #include "logging/logger.h"
 #include "logging/logger_map.h"
 #include "logging/logging_configurator.h"
+#include "logging/periodic_task.h"
 
 namespace logging {
 
@@ -47,8 +53,31 @@ class LogManager {
   bool IsLoggerExists(const std::string& name) const;
   std::size_t GetNumLoggers() const;
 
+  // Drains pending asynchronous events, then closes and removes all appenders and loggers.
   void Shutdown();
+
+  // Opt-in asynchronous mode. Logger::Write only enqueues the event and a backend thread
+  // writes it to the appenders. Returns false if asynchronous mode is already running.
+  bool StartAsync(std::size_t queue_capacity = AsyncLogWorker::kDefaultQueueCapacity);
+  // Writes all pending events and goes back to synchronous mode.
+  void StopAsync();
+  // Blocks until every event logged before this call has been written to the appenders,
+  // then flushes buffered appenders.
+  void Flush();
+  bool IsAsync() const { return m_async_worker.IsRunning(); }
+
   void InitFromLogConfigFile(const std::string& file_name);
+
+  // Applies the file again without clearing loggers. Only what changed since the file was last
+  // applied is touched: levels are set, appenders whose config changed are reconfigured in place
+  // or replaced, appenders and loggers no longer in the file are removed or reset. Appenders added
+  // in code are kept. Logging threads are not blocked. Returns false and changes nothing if the
+  // file can't be read or parsed.
+  bool ReloadLogConfigFile(const std::string& file_name);
+  // Opt-in: reloads the file on a background thread whenever it is saved.
+  // Returns false if a file is already watched or the file can't be watched.
+  bool WatchLogConfigFile(const std::string& file_name);
+  void StopWatchingLogConfigFile();
   bool IsDefaultAppenderExist(const std::string & appender_name) const;
   std::size_t GetNumDefaultAppenders() const;
 
@@ -57,14 +86,39 @@ class LogManager {
 
   void PrintSummaryOfLogConfig() const;
 
+  // Counters of all loggers and of the appenders currently configured, default appenders first.
+  // Only reads atomics, can be called while logging. FormatPrometheusText() renders the result.
+  LogStatistics GetStatistics() const;
+
  private:
   friend class Logger;
-  LogManager() : m_logger_map() {}
+  // How often repeat counts whose window has passed are written, while there are suppressed repeats.
+  static constexpr uint32_t kRepeatReportIntervalMs = 1000;
+
+  LogManager();
   void WriteToDefaultAppenders(const LogEvent& log_event);
+  bool EnqueueAsync(const Logger * logger, LogEvent & log_event);
   void ConfigureLogging();
+  // Adds, reconfigures or replaces the appender named in appender_config.
+  void ApplyAppenderConfig(IAppenderAddable & target, std::unique_ptr<AppenderConfig> appender_config);
+
+  // What the config file set up, so a reload can tell what to remove.
+  struct FileLoggerState {
+    // Level of the logger before the file set it, restored when the logger leaves the file.
+    LogLevel m_previous_level;
+    bool m_previous_additivity;
+    std::vector<std::string> m_appender_names;
+  };
 
   mutable LoggerMap m_logger_map;
   LoggingConfigurator m_logging_configurator;
+  AsyncLogWorker m_async_worker;
+  // Serializes applying config files.
+  std::mutex m_config_mtx;
+  std::vector<std::string> m_file_default_appenders;
+  std::map<std::string, FileLoggerState> m_file_loggers;
+  ConfigFileWatcher m_config_file_watcher;
+  PeriodicTask m_repeat_report_task;
 };
 
 }  // namespace logging
@@ -0,0 +1,139 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef INCLUDE_LOGGING_LOG_SAMPLING_H_
+#define INCLUDE_LOGGING_LOG_SAMPLING_H_
+
+#include <atomic>
+#include <cstdint>
+#include "logging/log_clock.h"
+
+namespace logging {
+
+// Per call site state of LOG_EVERY_N, LOG_FIRST_N, LOG_EVERY_T and LOG_RATE_LIMITED. Each macro
+// keeps one in a function local static; the constructors are constexpr so it is initialized
+// without a guard and Sample() is a few relaxed atomic operations. Sample() returns true if the
+// statement should be written and then sets suppressed to the number of calls skipped since the
+// previous one that was written.
+
+class LogEveryN {
+ public:
+  constexpr LogEveryN() : m_count(0) {}
+
+  // Writes the 1st, (n + 1)th, (2n + 1)th ... call.
+  bool Sample(uint64_t n, uint64_t & suppressed) {
+    uint64_t count = m_count.fetch_add(1, std::memory_order_relaxed);
+    if (n <= 1) {
+      suppressed = 0;
+      return true;
+    }
+    if (count % n != 0) {
+      return false;
+    }
+    suppressed = count == 0 ? 0 : n - 1;
+    return true;
+  }
+
+ private:
+  std::atomic<uint64_t> m_count;
+};
+
+class LogFirstN {
+ public:
+  constexpr LogFirstN() : m_count(0) {}
+
+  // Writes the first n calls. Nothing is written afterwards, so suppressed is always 0.
+  bool Sample(uint64_t n, uint64_t & suppressed) {
+    // Stop incrementing once past n so hot call sites only read the shared cache line.
+    if (m_count.load(std::memory_order_relaxed) >= n) {
+      return false;
+    }
+    suppressed = 0;
+    return m_count.fetch_add(1, std::memory_order_relaxed) < n;
+  }
+
+ private:
+  std::atomic<uint64_t> m_count;
+};
+
+class LogEveryT {
+ public:
+  constexpr LogEveryT() : m_next_ticks(0), m_suppressed(0) {}
+
+  // Writes at most one call per period, every call for a period <= 0.
+  bool Sample(double seconds, uint64_t & suppressed) {
+    uint64_t now = LogClock::Now();
+    uint64_t period = seconds > 0.0 ? LogClock::SecondsToTicks(seconds) : 0;
+    uint64_t next_ticks = m_next_ticks.load(std::memory_order_relaxed);
+    if (now < next_ticks ||
+        !m_next_ticks.compare_exchange_strong(next_ticks, now + period, std::memory_order_relaxed)) {
+      m_suppressed.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    suppressed = m_suppressed.exchange(0, std::memory_order_relaxed);
+    return true;
+  }
+
+ private:
+  std::atomic<uint64_t> m_next_ticks;
+  std::atomic<uint64_t> m_suppressed;
+};
+
+// Token bucket refilled with per_second tokens per second and holding up to one second worth of
+// them (at least one). Implemented as a virtual scheduling (GCRA) limiter, so the whole bucket is a
+// single timestamp updated with compare and swap. A rate <= 0 (or NaN) writes nothing.
+class LogRateLimiter {
+ public:
+  constexpr LogRateLimiter() : m_theoretical_arrival(0), m_suppressed(0) {}
+
+  bool Sample(double per_second, uint64_t & suppressed) {
+    if (!(per_second > 0.0)) {
+      m_suppressed.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    uint64_t now = LogClock::Now();
+    // Capped at about three years so tiny rates don't overflow the tick arithmetic.
+    double interval_seconds = 1.0 / per_second;
+    uint64_t interval = LogClock::SecondsToTicks(interval_seconds < 1e8 ? interval_seconds : 1e8);
+    uint64_t burst = per_second > 1.0 ? LogClock::SecondsToTicks(1.0) : interval;
+    uint64_t limit = now + burst;
+    uint64_t arrival = m_theoretical_arrival.load(std::memory_order_relaxed);
+    uint64_t next_arrival = 0;
+    do {
+      next_arrival = (arrival > now ? arrival : now) + interval;
+      if (next_arrival > limit) {
+        m_suppressed.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      }
+    } while (!m_theoretical_arrival.compare_exchange_weak(arrival, next_arrival, std::memory_order_relaxed));
+    suppressed = m_suppressed.exchange(0, std::memory_order_relaxed);
+    return true;
+  }
+
+ private:
+  std::atomic<uint64_t> m_theoretical_arrival;
+  std::atomic<uint64_t> m_suppressed;
+};
+
+}  // namespace logging
+
+#endif  // INCLUDE_LOGGING_LOG_SAMPLING_H_
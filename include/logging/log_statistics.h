@@ -0,0 +1,177 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef INCLUDE_LOGGING_LOG_STATISTICS_H_
+#define INCLUDE_LOGGING_LOG_STATISTICS_H_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include "logging/log_level.h"
+#include "logging/source_location.h"
+
+namespace logging {
+
+// Index of a level in the per level counters, FATAL (1) to VERBOSE (6). Index 0 is unused.
+constexpr std::size_t kNumStatisticLevels = static_cast<std::size_t>(LogLevel::VERBOSE) + 1;
+// Counters are spread over this many cache line aligned shards and each thread only writes the
+// shard picked by its GetCurrentThreadId(), so up to kNumStatisticShards threads never share a
+// line. Reading sums the shards. Must be a power of two.
+constexpr std::size_t kNumStatisticShards = 8;
+
+inline std::size_t GetStatisticShard() {
+  return GetCurrentThreadId() & (kNumStatisticShards - 1);
+}
+
+// N counters, sharded per thread. Add() is a relaxed fetch_add on a line owned by the calling thread.
+template <std::size_t N>
+class ShardedCounters {
+ public:
+  void Add(std::size_t index, uint64_t value = 1) {
+    m_shards[GetStatisticShard()].m_values[index].fetch_add(value, std::memory_order_relaxed);
+  }
+
+  uint64_t Load(std::size_t index) const {
+    uint64_t total = 0;
+    for (const auto & shard : m_shards) {
+      total += shard.m_values[index].load(std::memory_order_relaxed);
+    }
+    return total;
+  }
+
+ private:
+  struct alignas(64) Shard {
+    std::array<std::atomic<uint64_t>, N> m_values {};
+  };
+  std::array<Shard, kNumStatisticShards> m_shards;
+};
+
+// Distribution of a latency snapshot. Bucket bounds are in nanoseconds.
+struct LatencySnapshot {
+  // Exclusive upper bound of each non empty bucket and the number of samples in it, ascending.
+  std::vector<std::pair<double, uint64_t>> m_buckets;
+  uint64_t m_count = 0;
+  double m_sum_nanos = 0;
+
+  // Number of samples below nanos. Samples in the bucket containing nanos are not counted.
+  uint64_t CountBelow(double nanos) const;
+  // Upper bound of the bucket holding the quantile q (0 to 1), within 25% of the sample. 0 if empty.
+  double Quantile(double q) const;
+};
+
+// Log-linear histogram of LogClock tick intervals: one bucket per value below 16 ticks, then four
+// linear buckets per power of two, so the relative error stays under 25% over the full range.
+// Record() is a bucket lookup with one count leading zeros and two relaxed adds on the shard of the
+// calling thread; ticks are only converted to nanoseconds when a snapshot is taken.
+//
+// Reading the clock twice costs more than the rest of the bookkeeping, so callers time only the
+// calls for which ShouldSample() returns true: the first and then every kSampleInterval-th call
+// per shard.
+class LatencyHistogram {
+ public:
+  static constexpr std::size_t kNumLinearBuckets = 16;
+  static constexpr std::size_t kSubBucketBits = 2;
+  static constexpr std::size_t kNumBuckets = kNumLinearBuckets + (64 - 4) * (1 << kSubBucketBits);
+  static constexpr uint32_t kSampleInterval = 16;
+
+  bool ShouldSample() {
+    // Threads sharing a shard may race on the countdown, which only shifts the samples.
+    std::atomic<uint32_t> & countdown = m_shards[GetStatisticShard()].m_countdown;
+    uint32_t remaining = countdown.load(std::memory_order_relaxed);
+    countdown.store(remaining == 0 ? kSampleInterval - 1 : remaining - 1, std::memory_order_relaxed);
+    return remaining == 0;
+  }
+
+  void Record(uint64_t ticks) {
+    Shard & shard = m_shards[GetStatisticShard()];
+    shard.m_buckets[GetBucket(ticks)].fetch_add(1, std::memory_order_relaxed);
+    shard.m_sum_ticks.fetch_add(ticks, std::memory_order_relaxed);
+  }
+
+  LatencySnapshot GetSnapshot() const;
+
+  static std::size_t GetBucket(uint64_t ticks) {
+    if (ticks < kNumLinearBuckets) {
+      return static_cast<std::size_t>(ticks);
+    }
+    const std::size_t exponent = 63 - __builtin_clzll(ticks);
+    const std::size_t sub_bucket = (ticks >> (exponent - kSubBucketBits)) & ((1 << kSubBucketBits) - 1);
+    return kNumLinearBuckets + ((exponent - 4) << kSubBucketBits) + sub_bucket;
+  }
+  // Exclusive upper bound of a bucket in ticks.
+  static double GetBucketUpperBound(std::size_t bucket);
+
+ private:
+  struct alignas(64) Shard {
+    std::array<std::atomic<uint64_t>, kNumBuckets> m_buckets {};
+    std::atomic<uint64_t> m_sum_ticks {0};
+    std::atomic<uint32_t> m_countdown {0};
+  };
+  std::array<Shard, kNumStatisticShards> m_shards;
+};
+
+struct LoggerStatistics {
+  std::string m_name;
+  // Events submitted through the logger, indexed by level.
+  std::array<uint64_t, kNumStatisticLevels> m_events {};
+
+  uint64_t GetEvents(LogLevel log_level) const { return m_events[static_cast<std::size_t>(log_level)]; }
+  uint64_t GetEvents() const;
+};
+
+struct AppenderStatistics {
+  // Empty for the default appenders.
+  std::string m_logger_name;
+  std::string m_appender_name;
+  // Events written by the appender, indexed by level.
+  std::array<uint64_t, kNumStatisticLevels> m_events {};
+  uint64_t m_bytes_written = 0;
+  // Events dropped by the queue in front of the appender (see OverflowPolicy).
+  uint64_t m_dropped = 0;
+  // Repeated events held back by the deduplication stage.
+  uint64_t m_suppressed = 0;
+  uint64_t m_flushes = 0;
+  // Time spent in IAppender::Send for the events the appender accepts, sampled (see LatencyHistogram).
+  LatencySnapshot m_send_latency;
+
+  uint64_t GetEvents(LogLevel log_level) const { return m_events[static_cast<std::size_t>(log_level)]; }
+  uint64_t GetEvents() const;
+};
+
+// Snapshot returned by LogManager::GetStatistics(). Counters of one object are read one by one
+// while logging goes on, so they are not a consistent cut.
+struct LogStatistics {
+  std::vector<LoggerStatistics> m_loggers;
+  std::vector<AppenderStatistics> m_appenders;
+};
+
+// Prometheus text exposition format (version 0.0.4) of a snapshot, metric names prefixed by "logging_".
+std::string FormatPrometheusText(const LogStatistics & statistics);
+
+}  // namespace logging
+
+#endif  // INCLUDE_LOGGING_LOG_STATISTICS_H_
@@ -0,0 +1,93 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef INCLUDE_LOGGING_LOG_TRACE_H_
+#define INCLUDE_LOGGING_LOG_TRACE_H_
+
+#include <cstdint>
+#include <istream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include "logging/log_level.h"
+
+namespace logging {
+
+// Traffic trace written by TraceAppender and replayed by the loadgen tool. A text file starting
+// with kTraceHeader, then one line per event:
+//   <unix nanoseconds> <thread id> <level> <message size> <logger name>
+// The logger name is the rest of the line. Lines starting with '#' are comments.
+constexpr char kTraceHeader[] = "# logging trace v1";
+
+struct TraceRecord {
+  int64_t m_unix_nanos = 0;
+  uint32_t m_thread_id = 0;
+  LogLevel m_log_level = LogLevel::INFO;
+  std::size_t m_message_size = 0;
+  std::string m_logger_name;
+};
+
+inline void AppendTraceRecord(const TraceRecord & record, std::string & output) {
+  output += std::to_string(record.m_unix_nanos);
+  output += ' ';
+  output += std::to_string(record.m_thread_id);
+  output += ' ';
+  output += LogLevelToCString(record.m_log_level);
+  output += ' ';
+  output += std::to_string(record.m_message_size);
+  output += ' ';
+  output += record.m_logger_name;
+  output += '\n';
+}
+
+// Reads the next record, skipping comments and blank lines. False at the end of the input or on a
+// malformed line, which leaves the input in a failed state.
+inline bool ReadTraceRecord(std::istream & input, TraceRecord & record) {
+  std::string line;
+  while (std::getline(input, line)) {
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+    std::istringstream fields(line);
+    std::string level;
+    if (!(fields >> record.m_unix_nanos >> record.m_thread_id >> level >> record.m_message_size)) {
+      input.setstate(std::ios::failbit);
+      return false;
+    }
+    try {
+      record.m_log_level = LogLevellFromString(level);
+    }
+    catch (std::invalid_argument &) {
+      input.setstate(std::ios::failbit);
+      return false;
+    }
+    fields.get();
+    std::getline(fields, record.m_logger_name);
+    return true;
+  }
+  return false;
+}
+
+}  // namespace logging
+
+#endif  // INCLUDE_LOGGING_LOG_TRACE_H_
@@ -27,13 +27,19 @@
 #include <memory>
 #include <mutex>
 #include <atomic>
+#include <cstdint>
 #include <iostream>
 
 #include "logging/appender_addable_interface.h"
+#include "logging/log_sampling.h"
+#include "logging/snapshot_appender_list.h"
 
 namespace logging {
 
 class Logger;
+class LoggerMap;
+// Loggers form a hierarchy by their dotted names: "a" and "a.b" are the ancestors of "a.b.c".
+constexpr char kLoggerNameSeparator = '.';
 using LoggerRawPtr = Logger*;
 using LoggerRef = Logger &;
 using LoggerUnqPtr = std::unique_ptr<Logger>;
@@ -49,90 +55,341 @@ class Logger : public IAppenderAddable {
   void LogInfoRawBuffer(const std::string &message) const;
   void LogDebug(const std::string &message) const;
   void LogVerbose(const std::string &message) const;
-  bool IsFatalEnabled() const;
-  bool IsErrorEnabled() const;
-  bool IsWarnEnabled() const;
-  bool IsInfoEnabled() const;
-  bool IsDebugEnabled() const;
-  bool IsVerboseEnabled() const;
+  // Level of this logger only, regardless of appenders.
+  bool IsFatalEnabled() const { return IsLevelEnabled(LogLevel::FATAL); }
+  bool IsErrorEnabled() const { return IsLevelEnabled(LogLevel::ERROR); }
+  bool IsWarnEnabled() const { return IsLevelEnabled(LogLevel::WARN); }
+  bool IsInfoEnabled() const { return IsLevelEnabled(LogLevel::INFO); }
+  bool IsDebugEnabled() const { return IsLevelEnabled(LogLevel::DEBUG); }
+  bool IsVerboseEnabled() const { return IsLevelEnabled(LogLevel::VERBOSE); }
+
+  // True if the logger level allows log_level and at least one of its appenders (or the default
+  // appenders) would write it. Used by the LOG_* macros, costs one relaxed load.
+  bool ShouldLog(LogLevel log_level) const {
+    return (m_level_mask.load(std::memory_order_relaxed) & (LogLevelBit(log_level) << kEffectiveLevelShift)) != 0;
+  }
+
+  void Write(LogLevel log_level, const std::string & message, const SourceLocation & location = SourceLocation()) const;
+
+  // Captures the arguments now and formats the message later on the appender side.
+  // format has to outlive the event, normally it is a string literal (see LOG_*_FMT).
+  template <class... Args>
+  void WriteFormat(LogLevel log_level, const char * format, const Args &... args) const {
+    WriteFormat(log_level, SourceLocation(), format, args...);
+  }
 
-  void Write(LogLevel log_level, const std::string & message) const;
+  template <class... Args>
+  void WriteFormat(LogLevel log_level, const SourceLocation & location, const char * format, const Args &... args) const {
+    LogEvent log_event;
+    log_event.m_timestamp = LogClock::Now();
+    log_event.m_thread_id = GetCurrentThreadId();
+    log_event.m_location = location;
+    log_event.m_log_level = log_level;
+    log_event.m_logger_name = GetName();
+    log_event.m_format = format;
+    log_event.m_arguments.Add(args...);
+    Submit(log_event);
+  }
+
+  // Message with structured fields given as key, value, key, value, ... (see LOG_*_KV).
+  template <class... Fields>
+  void WriteFields(LogLevel log_level, const SourceLocation & location, const std::string & message, const Fields &... fields) const {
+    LogEvent log_event;
+    log_event.m_timestamp = LogClock::Now();
+    log_event.m_thread_id = GetCurrentThreadId();
+    log_event.m_location = location;
+    log_event.m_log_level = log_level;
+    log_event.m_message = message;
+    log_event.m_logger_name = GetName();
+    log_event.m_fields.AddFields(fields...);
+    Submit(log_event);
+  }
 
   void CloseAllAppenders();
+  void FlushAllAppenders();
+  void ReportExpiredRepeats();
 
   const std::string & GetName() const { return m_name;}
+  // Level set on this logger, NOT_SELECTED if it takes the level of its nearest ancestor which has one.
   LogLevel GetLogLevel() const { return m_level;}
+  // Level of the [LevelOverride] pattern matching the name, used while no level is set on this logger.
+  LogLevel GetOverrideLogLevel() const { return m_override_level;}
+  // Level in use, resolved from the ancestors whenever the hierarchy changes.
+  LogLevel GetEffectiveLogLevel() const { return m_effective_level.load(std::memory_order_relaxed); }
   bool GetUseDefaultAppender() const { return m_use_default_appender; }
+  bool GetAdditivity() const { return m_additivity; }
 
   // In case it is configured from logging config file, this call doesn't overwrite.
   // Normally, it is better to use this function to set LogLevel in code so that it can be changed
   // By config file if it is needed.
-  void SetLogLevel(const LogLevel log_level) {
-    if (m_level == LogLevel::NOT_SELECTED) {
-      m_level = log_level;
-    }
-  }
+  void SetLogLevel(const LogLevel log_level);
+
+  void SetUseDefaultAppender(bool use_default_appender);
 
-  void SetUseDefaultAppender(bool use_default_appender) { m_use_default_appender = use_default_appender; }
+  // Events also go to the appenders of the ancestors, up to and including the first ancestor
+  // without additivity. True by default, false keeps this logger and its descendants to their own appenders.
+  void SetAdditivity(bool additivity);
+
+  // Recomputes the cached level mask. Called internally whenever levels or appenders change,
+  // only needed after changing the config of an appender through GetAppender().
+  void UpdateLevelMask();
 
   AppenderAddableError AddAppender(std::unique_ptr<AppenderConfig> new_appender_config) final;
   AppenderAddableError AddAppender(AppenderUnqPtr new_appender) final;
 
-  AppenderList& GetAllAppenders() final;
+  AppenderListPtr GetAllAppenders() final;
+
+  // Appenders which receive the events of this logger: its own, then those inherited from ancestors.
+  // Default appenders are not included.
+  AppenderListPtr GetEffectiveAppenders() const { return m_effective_appenders.Load(); }
 
   AppenderList GetDefaultAppenders() const;
 
   AppenderRawPtr GetAppender(const std::string& name) const final;
 
   bool AppenderExist(const std::string & appender_name) final;
-  std::size_t GetNumAppenders() const { return m_appenders.size(); }
+  std::size_t GetNumAppenders() const { return m_appenders.Load()->size(); }
+
+  // Events submitted through this logger, see also LogManager::GetStatistics().
+  LoggerStatistics GetStatistics() const;
 
   void RemoveAllAppenders() final;
 
   void RemoveAppender(const std::string& name) final;
 
+  AppenderAddableError ReplaceAppender(std::unique_ptr<AppenderConfig> new_appender_config) final;
+
  protected:
+  // Fans the event out to the default appenders and the appenders of this logger.
+  // Called on the caller thread in synchronous mode and on the backend thread in asynchronous mode.
+  void Dispatch(const LogEvent & log_event) const;
+  // Hands the event to the asynchronous backend if it is running, otherwise dispatches it.
+  void Submit(LogEvent & log_event) const;
   void WriteToAllAppenders(const LogEvent & log_event) const;
-  AppenderList m_appenders;
+  SnapshotAppenderList m_appenders;
 
  private:
   friend class LoggerMap;
   friend class LogManager;
-  explicit Logger(const std::string &name, const LogLevel level, const bool use_default_appender = true);
+  friend class AsyncLogWorker;
+  Logger(const LoggerMap & logger_map, const std::string &name, const LogLevel level, const bool use_default_appender = true);
   // This function will overwrite the log_level in any case.
-  void SetLogLevelForce(const LogLevel log_level) {m_level = log_level;}
-
-  std::string m_name;
-  LogLevel m_level;
+  void SetLogLevelForce(const LogLevel log_level);
+  // Called by LoggerMap when the override matching the name changes.
+  void SetOverrideLevel(const LogLevel log_level);
+  // The level set on this logger, else its override level. Descendants inherit it.
+  LogLevel GetAssignedLogLevel() const {
+    const LogLevel log_level = m_level;
+    return log_level != LogLevel::NOT_SELECTED ? log_level : m_override_level.load();
+  }
+  bool IsLevelEnabled(LogLevel log_level) const {
+    return (m_level_mask.load(std::memory_order_relaxed) & LogLevelBit(log_level)) != 0;
+  }
+  // Requires m_mtx to be held.
+  void UpdateLevelMaskLocked();
+  // Requires m_mtx to be held.
+  void PublishEffectiveAppendersLocked();
+  // Called by LoggerMap with what this logger takes from its ancestors.
+  void SetInherited(LogLevel inherited_level, AppenderListPtr inherited_appenders);
+  // Lets loggers below this one pick up changes of its level, appenders or additivity.
+  void ResolveDescendants();
+
+  // m_level_mask holds the levels allowed by m_level in the low bits and, shifted by kEffectiveLevelShift,
+  // the levels which are also accepted by at least one appender. It is read on every log statement,
+  // so it lives on its own cache line.
+  static constexpr uint32_t kEffectiveLevelShift = 16;
+  alignas(64) std::atomic<uint32_t> m_level_mask;
+  alignas(64) std::string m_name;
+  // The map which created this logger and resolves its hierarchy.
+  const LoggerMap * const m_logger_map;
+  std::atomic<LogLevel> m_level;
+  std::atomic<LogLevel> m_override_level;
+  std::atomic<LogLevel> m_effective_level;
   std::atomic<bool> m_use_default_appender;
+  std::atomic<bool> m_additivity;
+  // Resolved by LoggerMap, guarded by m_mtx.
+  LogLevel m_inherited_level = LogLevel::NOT_SELECTED;
+  AppenderListPtr m_inherited_appenders;
+  // m_appenders followed by m_inherited_appenders, the list Dispatch() writes to.
+  SnapshotAppenderList m_effective_appenders;
+  // Serializes modifications of levels and appenders. Writing log events doesn't lock.
   mutable std::mutex m_mtx;
+  // Events per level, updated by Submit().
+  mutable ShardedCounters<kNumStatisticLevels> m_event_counters;
 };
 
 }  // namespace logging
 
-// These could throw exception.
-#define LOG_FATAL(logger, message) {\
-        if (logger.IsFatalEnabled()) {\
-           logger.LogFatal(message); }} \
+// Compile time threshold. Statements less severe than LOGGING_COMPILED_LEVEL expand to an empty block,
+// their arguments are not evaluated. Set with -DLOGGING_COMPILED_LEVEL=<FATAL..VERBOSE|NONE> in CMake.
+#define LOGGING_LEVEL_NONE 0
+#define LOGGING_LEVEL_FATAL 1
+#define LOGGING_LEVEL_ERROR 2
+#define LOGGING_LEVEL_WARN 3
+#define LOGGING_LEVEL_INFO 4
+#define LOGGING_LEVEL_DEBUG 5
+#define LOGGING_LEVEL_VERBOSE 6
+
+#ifndef LOGGING_COMPILED_LEVEL
+#define LOGGING_COMPILED_LEVEL LOGGING_LEVEL_VERBOSE
+#endif
+
+#if LOGGING_COMPILED_LEVEL >= LOGGING_LEVEL_FATAL
+#define LOGGING_IF_COMPILED_FATAL(...) __VA_ARGS__
+#else
+#define LOGGING_IF_COMPILED_FATAL(...) {}
+#endif
+
+#if LOGGING_COMPILED_LEVEL >= LOGGING_LEVEL_ERROR
+#define LOGGING_IF_COMPILED_ERROR(...) __VA_ARGS__
+#else
+#define LOGGING_IF_COMPILED_ERROR(...) {}
+#endif
+
+#if LOGGING_COMPILED_LEVEL >= LOGGING_LEVEL_WARN
+#define LOGGING_IF_COMPILED_WARN(...) __VA_ARGS__
+#else
+#define LOGGING_IF_COMPILED_WARN(...) {}
+#endif
+
+#if LOGGING_COMPILED_LEVEL >= LOGGING_LEVEL_INFO
+#define LOGGING_IF_COMPILED_INFO(...) __VA_ARGS__
+#else
+#define LOGGING_IF_COMPILED_INFO(...) {}
+#endif
+
+#if LOGGING_COMPILED_LEVEL >= LOGGING_LEVEL_DEBUG
+#define LOGGING_IF_COMPILED_DEBUG(...) __VA_ARGS__
+#else
+#define LOGGING_IF_COMPILED_DEBUG(...) {}
+#endif
+
+#if LOGGING_COMPILED_LEVEL >= LOGGING_LEVEL_VERBOSE
+#define LOGGING_IF_COMPILED_VERBOSE(...) __VA_ARGS__
+#else
+#define LOGGING_IF_COMPILED_VERBOSE(...) {}
+#endif
 
-#define LOG_ERROR(logger, message) {\
-        if (logger.IsErrorEnabled()) {\
-           logger.LogError(message); }} \
-
-#define LOG_WARN(logger, message) {\
-        if (logger.IsWarnEnabled()) {\
-           logger.LogWarn(message); }} \
-
-#define LOG_INFO(logger, message) { \
-        if (logger.IsInfoEnabled()) {\
-           logger.LogInfo(message); }} \
-
-#define LOG_DEBUG(logger, message) {\
-        if (logger.IsDebugEnabled()) {\
-           logger.LogDebug(message); }} \
-
-#define LOG_VERBOSE(logger, message) {\
-        if (logger.IsVerboseEnabled()) {\
-           logger.LogVerbose(message); }} \
+// These could throw exception.
+#define LOG_FATAL(logger, message) LOGGING_IF_COMPILED_FATAL({\
+        if (logger.ShouldLog(::logging::LogLevel::FATAL)) {\
+           logger.Write(::logging::LogLevel::FATAL, message, LOGGING_SOURCE_LOCATION); }}) \
+
+#define LOG_ERROR(logger, message) LOGGING_IF_COMPILED_ERROR({\
+        if (logger.ShouldLog(::logging::LogLevel::ERROR)) {\
+           logger.Write(::logging::LogLevel::ERROR, message, LOGGING_SOURCE_LOCATION); }}) \
+
+#define LOG_WARN(logger, message) LOGGING_IF_COMPILED_WARN({\
+        if (logger.ShouldLog(::logging::LogLevel::WARN)) {\
+           logger.Write(::logging::LogLevel::WARN, message, LOGGING_SOURCE_LOCATION); }}) \
+
+#define LOG_INFO(logger, message) LOGGING_IF_COMPILED_INFO({\
+        if (logger.ShouldLog(::logging::LogLevel::INFO)) {\
+           logger.Write(::logging::LogLevel::INFO, message, LOGGING_SOURCE_LOCATION); }}) \
+
+#define LOG_DEBUG(logger, message) LOGGING_IF_COMPILED_DEBUG({\
+        if (logger.ShouldLog(::logging::LogLevel::DEBUG)) {\
+           logger.Write(::logging::LogLevel::DEBUG, message, LOGGING_SOURCE_LOCATION); }}) \
+
+#define LOG_VERBOSE(logger, message) LOGGING_IF_COMPILED_VERBOSE({\
+        if (logger.ShouldLog(::logging::LogLevel::VERBOSE)) {\
+           logger.Write(::logging::LogLevel::VERBOSE, message, LOGGING_SOURCE_LOCATION); }}) \
+
+// Deferred formatting, e.g. LOG_INFO_FMT(logger, "user {} took {} us", user_id, latency).
+// Only the arguments are copied on the calling thread, the text is built on the appender side.
+#define LOGGING_WRITE_FORMAT(logger, log_level, format, ...) {\
+        static_assert(::logging::CountFormatPlaceholders(format) == \
+                      decltype(::logging::CountFormatArguments(__VA_ARGS__))::value, \
+                      "Number of {} placeholders doesn't match the number of arguments."); \
+        logger.WriteFormat(log_level, LOGGING_SOURCE_LOCATION, format, ##__VA_ARGS__); } \
+
+#define LOG_FATAL_FMT(logger, format, ...) LOGGING_IF_COMPILED_FATAL({\
+        if (logger.ShouldLog(::logging::LogLevel::FATAL)) {\
+           LOGGING_WRITE_FORMAT(logger, ::logging::LogLevel::FATAL, format, ##__VA_ARGS__) }}) \
+
+#define LOG_ERROR_FMT(logger, format, ...) LOGGING_IF_COMPILED_ERROR({\
+        if (logger.ShouldLog(::logging::LogLevel::ERROR)) {\
+           LOGGING_WRITE_FORMAT(logger, ::logging::LogLevel::ERROR, format, ##__VA_ARGS__) }}) \
+
+#define LOG_WARN_FMT(logger, format, ...) LOGGING_IF_COMPILED_WARN({\
+        if (logger.ShouldLog(::logging::LogLevel::WARN)) {\
+           LOGGING_WRITE_FORMAT(logger, ::logging::LogLevel::WARN, format, ##__VA_ARGS__) }}) \
+
+#define LOG_INFO_FMT(logger, format, ...) LOGGING_IF_COMPILED_INFO({\
+        if (logger.ShouldLog(::logging::LogLevel::INFO)) {\
+           LOGGING_WRITE_FORMAT(logger, ::logging::LogLevel::INFO, format, ##__VA_ARGS__) }}) \
+
+#define LOG_DEBUG_FMT(logger, format, ...) LOGGING_IF_COMPILED_DEBUG({\
+        if (logger.ShouldLog(::logging::LogLevel::DEBUG)) {\
+           LOGGING_WRITE_FORMAT(logger, ::logging::LogLevel::DEBUG, format, ##__VA_ARGS__) }}) \
+
+#define LOG_VERBOSE_FMT(logger, format, ...) LOGGING_IF_COMPILED_VERBOSE({\
+        if (logger.ShouldLog(::logging::LogLevel::VERBOSE)) {\
+           LOGGING_WRITE_FORMAT(logger, ::logging::LogLevel::VERBOSE, format, ##__VA_ARGS__) }}) \
+
+// Structured logging, e.g. LOG_INFO_KV(logger, "request done", "user_id", user_id, "latency_us", latency).
+// Keys must be string literals, values are stored typed and rendered by each appender.
+#define LOGGING_WRITE_FIELDS(logger, log_level, message, ...) {\
+        static_assert(decltype(::logging::CountFormatArguments(__VA_ARGS__))::value % 2 == 0, \
+                      "Fields have to be given as key, value pairs."); \
+        logger.WriteFields(log_level, LOGGING_SOURCE_LOCATION, message, __VA_ARGS__); } \
+
+
+#define LOG_FATAL_KV(logger, message, ...) LOGGING_IF_COMPILED_FATAL({\
+        if (logger.ShouldLog(::logging::LogLevel::FATAL)) {\
+           LOGGING_WRITE_FIELDS(logger, ::logging::LogLevel::FATAL, message, __VA_ARGS__) }}) \
+
+#define LOG_ERROR_KV(logger, message, ...) LOGGING_IF_COMPILED_ERROR({\
+        if (logger.ShouldLog(::logging::LogLevel::ERROR)) {\
+           LOGGING_WRITE_FIELDS(logger, ::logging::LogLevel::ERROR, message, __VA_ARGS__) }}) \
+
+#define LOG_WARN_KV(logger, message, ...) LOGGING_IF_COMPILED_WARN({\
+        if (logger.ShouldLog(::logging::LogLevel::WARN)) {\
+           LOGGING_WRITE_FIELDS(logger, ::logging::LogLevel::WARN, message, __VA_ARGS__) }}) \
+
+#define LOG_INFO_KV(logger, message, ...) LOGGING_IF_COMPILED_INFO({\
+        if (logger.ShouldLog(::logging::LogLevel::INFO)) {\
+           LOGGING_WRITE_FIELDS(logger, ::logging::LogLevel::INFO, message, __VA_ARGS__) }}) \
+
+#define LOG_DEBUG_KV(logger, message, ...) LOGGING_IF_COMPILED_DEBUG({\
+        if (logger.ShouldLog(::logging::LogLevel::DEBUG)) {\
+           LOGGING_WRITE_FIELDS(logger, ::logging::LogLevel::DEBUG, message, __VA_ARGS__) }}) \
+
+#define LOG_VERBOSE_KV(logger, message, ...) LOGGING_IF_COMPILED_VERBOSE({\
+        if (logger.ShouldLog(::logging::LogLevel::VERBOSE)) {\
+           LOGGING_WRITE_FIELDS(logger, ::logging::LogLevel::VERBOSE, message, __VA_ARGS__) }}) \
+
+// Sampled statements, e.g. LOG_EVERY_N(WARN, logger, 1000, "queue full: " + name). level is one of
+// FATAL..VERBOSE. The state lives in a static per call site and is only touched when the level is
+// enabled; message is only evaluated for statements which are written. The number of statements
+// skipped before a written one is attached to it as the structured field "suppressed".
+#define LOGGING_WRITE_SAMPLED(logger, log_level, message, sampler_type, parameter) {\
+        static sampler_type logging_sampler; \
+        uint64_t logging_suppressed = 0; \
+        if (logging_sampler.Sample(parameter, logging_suppressed)) {\
+          if (logging_suppressed == 0) {\
+            logger.Write(log_level, message, LOGGING_SOURCE_LOCATION);\
+          } else {\
+            logger.WriteFields(log_level, LOGGING_SOURCE_LOCATION, message, "suppressed", logging_suppressed); }}} \
+
+// The 1st, (n + 1)th, (2n + 1)th ... time.
+#define LOG_EVERY_N(level, logger, n, message) LOGGING_IF_COMPILED_##level({\
+        if (logger.ShouldLog(::logging::LogLevel::level)) {\
+           LOGGING_WRITE_SAMPLED(logger, ::logging::LogLevel::level, message, ::logging::LogEveryN, n) }}) \
+
+// The first n times only.
+#define LOG_FIRST_N(level, logger, n, message) LOGGING_IF_COMPILED_##level({\
+        if (logger.ShouldLog(::logging::LogLevel::level)) {\
+           LOGGING_WRITE_SAMPLED(logger, ::logging::LogLevel::level, message, ::logging::LogFirstN, n) }}) \
+
+// At most once every seconds (a double).
+#define LOG_EVERY_T(level, logger, seconds, message) LOGGING_IF_COMPILED_##level({\
+        if (logger.ShouldLog(::logging::LogLevel::level)) {\
+           LOGGING_WRITE_SAMPLED(logger, ::logging::LogLevel::level, message, ::logging::LogEveryT, seconds) }}) \
+
+// Token bucket: per_second statements per second on average, bursts of up to one second worth.
+#define LOG_RATE_LIMITED(level, logger, per_second, message) LOGGING_IF_COMPILED_##level({\
+        if (logger.ShouldLog(::logging::LogLevel::level)) {\
+           LOGGING_WRITE_SAMPLED(logger, ::logging::LogLevel::level, message, ::logging::LogRateLimiter, per_second) }}) \
 
 #endif  // INCLUDE_LOGGING_LOGGER_H_
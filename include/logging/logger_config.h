@@ -33,11 +33,20 @@ namespace logging {
 
 struct LoggerConfig {
  public:
-  LogLevel m_log_level;
+  LogLevel m_log_level = LogLevel::NOT_SELECTED;
+  // Names the logger and, through the dotted hierarchy, the default for the loggers below it.
   std::string m_name;
+  bool m_additivity = true;
   std::vector<std::unique_ptr<AppenderConfig>> m_appender_configs;
 };
 
+// [LevelOverride] section: level of all loggers whose name matches m_pattern (see LevelOverrides).
+struct LevelOverrideConfig {
+ public:
+  std::string m_pattern;
+  LogLevel m_log_level = LogLevel::NOT_SELECTED;
+};
+
 }  // namespace logging
 
 #endif  // INCLUDE_LOGGING_LOGGER_CONFIG_H_
@@ -26,13 +26,16 @@
 #include <thread>
 #include <string>
 #include <memory>
-#include <map>
 #include <vector>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include "logging/level_overrides.h"
 #include "logging/logger.h"
+#include "logging/logger_registry.h"
 
 namespace logging {
 
-using LoggerPtrMap = std::map<std::string, std::unique_ptr<Logger>>;
 using LoggerList = std::vector<LoggerRawPtr>;
 
 class LoggerMap : public IAppenderAddable {
@@ -42,43 +45,80 @@ class LoggerMap : public IAppenderAddable {
 
   bool IsLoggerExists(const std::string& name) const;
 
-  std::size_t GetNumLoggers() const { return m_loggers->size(); }
+  std::size_t GetNumLoggers() const { return m_loggers.GetSize(); }
 
   LoggerRef GetLogger(const std::string& name) const;
 
   AppenderAddableError AddAppender(std::unique_ptr<AppenderConfig> new_appender_config) final;
 
-  AppenderList& GetAllAppenders() override;
+  AppenderListPtr GetAllAppenders() override;
 
   AppenderRawPtr GetAppender(const std::string& name) const final;
 
   bool AddLogger(const std::string& name, LogLevel log_level = LogLevel::NOT_SELECTED);
 
   bool AppenderExist(const std::string & appender_name) final;
-  std::size_t GetNumDefaultAppenders() const { return m_defalut_appenders.size(); }
+  std::size_t GetNumDefaultAppenders() const { return m_defalut_appenders.Load()->size(); }
+  // Levels written by at least one default appender.
+  uint32_t GetDefaultAppendersLevelMask() const { return m_default_appenders_level_mask.load(std::memory_order_relaxed); }
 
   void RemoveAllAppenders() final;
 
   void RemoveAppender(const std::string& name) final;
 
+  AppenderAddableError ReplaceAppender(std::unique_ptr<AppenderConfig> new_appender_config) final;
+
   void WriteToDefaultAppenders(const LogEvent& log_event);
 
+  // Flushes the default appenders and the appenders of all loggers.
+  void FlushAppenders();
+  // Reports the expired repeat counts of the default appenders and the appenders of all loggers.
+  // Can run concurrently with Clear().
+  void ReportExpiredRepeats();
+
   void Clear();
   void ClearDefaultAppenders();
   void ClearLoggers();
   LoggerList GetCurrentLoggers() const;
 
+  // Recomputes the default appenders level mask and the cached level masks of all loggers.
+  void UpdateLevelMasks();
+
+  // Replaces the pattern based levels. Matching loggers use the level of their pattern while no level
+  // is set on them, loggers created later get it in GetLogger(). Only loggers whose match changed are updated.
+  void SetLevelOverrides(std::shared_ptr<const LevelOverrides> level_overrides);
+
  private:
+  friend class Logger;
+  // Resolves what logger and the loggers below it inherit. Called whenever the level, appenders
+  // or additivity of logger change, so that logging never has to walk the hierarchy.
+  void ResolveSubtree(Logger & logger) const;
+  // Requires m_hierarchy_mtx to be held.
+  void ResolveSubtreeLocked(Logger & logger) const;
+  // Sets the inherited level and appenders of logger from the existing ancestors.
+  void ResolveInheritance(Logger & logger) const;
+  // Requires m_hierarchy_mtx to be held. Level of the override matching name, NOT_SELECTED if there is none.
+  LogLevel GetOverrideLevelLocked(const std::string & name) const;
+  // Requires m_hierarchy_mtx to be held. Adds a logger created by the registry to m_sorted_loggers
+  // and gives it the level of its override.
+  void IndexLoggerLocked(Logger & logger) const;
+  // Closes the default appenders and removes them from the list.
   void CloseDefaultAppenders();
   void CloseLoggers();
   void AddAppenderToLogger(const AppenderConfig& appender_config);
   AppenderAddableError AddAppender(AppenderUnqPtr new_appender) final;
 
-  std::unique_ptr<LoggerPtrMap> m_loggers;
-  AppenderList m_defalut_appenders;
+  mutable LoggerRegistry m_loggers;
+  SnapshotAppenderList m_defalut_appenders;
+  std::atomic<uint32_t> m_default_appenders_level_mask;
 
   mutable std::mutex m_mtx;
-  mutable std::recursive_mutex m_rmtx;
+  // Orders resolutions, so the last one sees all completed changes of the ancestors.
+  // Also guards m_sorted_loggers and m_level_overrides.
+  mutable std::mutex m_hierarchy_mtx;
+  // The loggers ordered by name, the descendants of "a" are the range of names starting with "a.".
+  mutable std::map<std::string, Logger *> m_sorted_loggers;
+  std::shared_ptr<const LevelOverrides> m_level_overrides;
 };
 
 }  // namespace logging
@@ -0,0 +1,105 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef INCLUDE_LOGGING_LOGGER_REGISTRY_H_
+#define INCLUDE_LOGGING_LOGGER_REGISTRY_H_
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace logging {
+
+class Logger;
+
+// Hash table of loggers by name. Lookups are lock free, insertions are serialized by a mutex.
+// Buckets are singly linked lists which only ever grow at the front, so readers always see a
+// consistent list. When the table grows a new one is built and published with a single store;
+// the old one stays valid for readers still walking it until Clear(). Loggers are owned by the
+// registry and never move, so references handed out stay valid until Clear().
+class LoggerRegistry {
+ public:
+  LoggerRegistry();
+  ~LoggerRegistry();
+
+  LoggerRegistry(const LoggerRegistry&) = delete;
+  LoggerRegistry& operator = (const LoggerRegistry&) = delete;
+
+  // Lock free. Returns nullptr if there is no logger with that name.
+  Logger * Find(const std::string & name) const;
+
+  // Returns the existing logger or inserts the one created by factory.
+  template <class Factory>
+  Logger & FindOrInsert(const std::string & name, Factory factory) {
+    Logger * logger = Find(name);
+    if (logger == nullptr) {
+      std::lock_guard<std::mutex> lock(m_mtx);
+      logger = Find(name);
+      if (logger == nullptr) {
+        logger = InsertLocked(name, factory());
+      }
+    }
+    return *logger;
+  }
+
+  std::size_t GetSize() const { return m_size.load(std::memory_order_relaxed); }
+
+  // Loggers in insertion order.
+  std::vector<Logger*> GetAll() const;
+
+  // Destroys all loggers. Must not run concurrently with lookups.
+  void Clear();
+
+ private:
+  struct Node {
+    std::string m_name;
+    std::size_t m_hash;
+    Logger * m_logger;
+    std::atomic<Node*> m_next;
+  };
+
+  struct Table {
+    explicit Table(std::size_t num_buckets);
+    std::size_t m_mask;
+    std::unique_ptr<std::atomic<Node*>[]> m_buckets;
+    std::vector<std::unique_ptr<Node>> m_nodes;
+  };
+
+  static constexpr std::size_t kInitialNumBuckets = 64;
+
+  Logger * InsertLocked(const std::string & name, std::unique_ptr<Logger> logger);
+  static void Link(Table & table, const std::string & name, std::size_t hash, Logger * logger);
+
+  std::atomic<Table*> m_table;
+  std::atomic<std::size_t> m_size;
+  // Current and retired tables.
+  std::vector<std::unique_ptr<Table>> m_tables;
+  std::vector<std::unique_ptr<Logger>> m_loggers;
+  mutable std::mutex m_mtx;
+};
+
+}  // namespace logging
+
+#endif  // INCLUDE_LOGGING_LOGGER_REGISTRY_H_
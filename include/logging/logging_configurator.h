@@ -39,9 +39,11 @@ class LoggingConfigurator {
 
   const std::vector<std::unique_ptr<AppenderConfig>>& GetDefaultAppenderConfig() {return m_default_appender_configs;}
   const std::vector<std::unique_ptr<LoggerConfig>>& GetLoggerConfig() {return m_logger_configs;}
+  const std::vector<LevelOverrideConfig>& GetLevelOverrideConfig() {return m_level_override_configs;}
 
   std::vector<std::unique_ptr<AppenderConfig>> m_default_appender_configs;
   std::vector<std::unique_ptr<LoggerConfig>> m_logger_configs;
+  std::vector<LevelOverrideConfig> m_level_override_configs;
 };
 
 }  // namespace logging
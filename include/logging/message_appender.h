@@ -24,6 +24,7 @@
 #define INCLUDE_LOGGING_MESSAGE_APPENDER_H_
 
 
+#include <cstddef>
 #include <string>
 #include <utility>
 
@@ -39,24 +40,28 @@ namespace logging {
 template <class FormatPolicy, class LogHeader = DefaultLogHeader>
 class MessageAppender: public FormatPolicy, LogHeader {
  public:
+  // Returns the number of characters written.
   template <class OutPutChannel>
-  void SendMessage(OutPutChannel && output_channel, const LogEvent & event) {
-    std::string message { FormatPolicy::FormatMessage(event) };
+  std::size_t SendMessage(OutPutChannel && output_channel, const LogEvent & event) {
+    // Policies may return a reference to their own buffer instead of a new string.
+    const auto & message = FormatPolicy::FormatMessage(event);
     std::forward<OutPutChannel>(output_channel) << message;
+    return message.size();
   }
 
 #ifdef ARALOG
   // Ara::log overload
   void SendMessage(ara_log::LogStream && output_channel, const LogEvent & event) {
-    std::string message { FormatPolicy::FormatMessage(event) };
+    const auto & message = FormatPolicy::FormatMessage(event);
     std::forward<ara_log::LogStream>(output_channel) << message;
   }
 #endif
 
   template <class OutPutChannel>
-  void AddHeader(OutPutChannel && output_channel) {
+  std::size_t AddHeader(OutPutChannel && output_channel) {
     std::string header { LogHeader::GetHeader() };
     std::forward<OutPutChannel>(output_channel) << header;
+    return header.size();
   }
 };
 
@@ -0,0 +1,122 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef INCLUDE_LOGGING_MPSC_QUEUE_H_
+#define INCLUDE_LOGGING_MPSC_QUEUE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace logging {
+
+// Bounded lock-free multi-producer/single-consumer ring buffer.
+// Every cell carries a sequence number which tells producers and the consumer whether the cell is
+// free or holds a value for the current lap (D. Vyukov's bounded queue). Capacity is rounded up to
+// a power of two.
+template <class T>
+class MpscQueue {
+ public:
+  explicit MpscQueue(std::size_t capacity) : m_capacity(RoundUpToPowerOfTwo(capacity)), m_mask(m_capacity - 1),
+    m_cells(new Cell[m_capacity]), m_enqueue_pos(0), m_dequeue_pos(0) {
+    for (std::size_t i = 0; i < m_capacity; ++i) {
+      m_cells[i].m_sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  MpscQueue(const MpscQueue&) = delete;
+  MpscQueue& operator = (const MpscQueue&) = delete;
+
+  // Can be called from any thread. Returns false if the queue is full, value is left untouched then.
+  bool TryPush(T && value) {
+    Cell * cell;
+    std::size_t pos = m_enqueue_pos.load(std::memory_order_relaxed);
+    for (;;) {
+      cell = &m_cells[pos & m_mask];
+      std::size_t seq = cell->m_sequence.load(std::memory_order_acquire);
+      std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+      if (diff == 0) {
+        if (m_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = m_enqueue_pos.load(std::memory_order_relaxed);
+      }
+    }
+    cell->m_data = std::move(value);
+    cell->m_sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Must only be called from the single consumer thread.
+  bool TryPop(T & value) {
+    Cell & cell = m_cells[m_dequeue_pos & m_mask];
+    std::size_t seq = cell.m_sequence.load(std::memory_order_acquire);
+    if (seq != m_dequeue_pos + 1) {
+      return false;
+    }
+    value = std::move(cell.m_data);
+    cell.m_sequence.store(m_dequeue_pos + m_capacity, std::memory_order_release);
+    ++m_dequeue_pos;
+    return true;
+  }
+
+  // Must only be called from the single consumer thread.
+  bool IsEmpty() const {
+    const Cell & cell = m_cells[m_dequeue_pos & m_mask];
+    return cell.m_sequence.load(std::memory_order_acquire) != m_dequeue_pos + 1;
+  }
+
+  // Number of slots reserved by producers so far. Used as a ticket for flushing.
+  std::size_t GetEnqueuedCount() const { return m_enqueue_pos.load(std::memory_order_acquire); }
+
+  std::size_t GetCapacity() const { return m_capacity; }
+
+ private:
+  struct Cell {
+    std::atomic<std::size_t> m_sequence;
+    T m_data;
+  };
+
+  static std::size_t RoundUpToPowerOfTwo(std::size_t value) {
+    std::size_t result = 2;
+    while (result < value) {
+      result <<= 1;
+    }
+    return result;
+  }
+
+  const std::size_t m_capacity;
+  const std::size_t m_mask;
+  std::unique_ptr<Cell[]> m_cells;
+
+  // Producers and the consumer touch different cache lines.
+  alignas(64) std::atomic<std::size_t> m_enqueue_pos;
+  alignas(64) std::size_t m_dequeue_pos;
+};
+
+}  // namespace logging
+
+#endif  // INCLUDE_LOGGING_MPSC_QUEUE_H_
@@ -0,0 +1,52 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef INCLUDE_LOGGING_PATTERN_FORMAT_POLICY_H_
+#define INCLUDE_LOGGING_PATTERN_FORMAT_POLICY_H_
+
+#include <string>
+#include "logging/log_event.h"
+#include "logging/pattern_layout.h"
+
+namespace logging {
+
+// Formats through a PatternLayout into a buffer owned by the policy, so the returned string is
+// only valid until the next call. Appenders call it under their own lock.
+class PatternFormatPolicy {
+ public:
+  void SetPattern(const std::string & pattern) { m_layout.SetPattern(pattern); }
+  const std::string & GetPattern() const { return m_layout.GetPattern(); }
+
+  const std::string & FormatMessage(const LogEvent & log_event) {
+    m_buffer.clear();
+    m_layout.Render(log_event, m_buffer);
+    return m_buffer;
+  }
+
+ private:
+  PatternLayout m_layout;
+  std::string m_buffer;
+};
+
+}  // namespace logging
+
+#endif  // INCLUDE_LOGGING_PATTERN_FORMAT_POLICY_H_
@@ -0,0 +1,93 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef INCLUDE_LOGGING_PATTERN_LAYOUT_H_
+#define INCLUDE_LOGGING_PATTERN_LAYOUT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "logging/log_event.h"
+#include "logging/timestamp_formatter.h"
+
+namespace logging {
+
+// Layout of a log line given as a pattern, e.g. "%d [%l][%c] %m%n". The pattern is parsed once into
+// a list of tokens; Render() only appends to the output string.
+//
+//   %d  local time "YYYY-MM-DD HH:MM:SS.uuuuuu"
+//   %l  level        %c  logger name   %m  message
+//   %t  thread id    %F  source file   %L  source line   %f  function
+//   %k  structured fields as " key=value" each, strings with spaces, '"' or '=' are quoted
+//   %n  newline      %%  percent sign
+//
+// Source location fields are empty for events not logged through the LOG_* macros.
+//
+// Anything else, including unknown conversions, is copied literally.
+class PatternLayout {
+ public:
+  static constexpr const char * kDefaultPattern = "%d [%l][%c] %m%k%n";
+
+  PatternLayout();
+  explicit PatternLayout(const std::string & pattern);
+
+  void SetPattern(const std::string & pattern);
+  const std::string & GetPattern() const { return m_pattern; }
+
+  // Appends the formatted event to output. Not thread safe because of the cached date.
+  void Render(const LogEvent & log_event, std::string & output) const;
+
+ private:
+  enum class TokenType : uint8_t {
+    LITERAL,
+    DATE,
+    LEVEL,
+    LOGGER_NAME,
+    MESSAGE,
+    THREAD_ID,
+    FILE,
+    LINE,
+    FUNCTION,
+    FIELDS,
+    NEWLINE
+  };
+
+  struct Token {
+    TokenType m_type;
+    // Range in m_literals for LITERAL tokens.
+    uint32_t m_offset;
+    uint32_t m_length;
+  };
+
+  void AddLiteral(const char * data, std::size_t length);
+  void AddToken(TokenType type);
+
+  std::string m_pattern;
+  std::string m_literals;
+  std::vector<Token> m_tokens;
+  mutable TimestampFormatter m_timestamp_formatter;
+};
+
+}  // namespace logging
+
+#endif  // INCLUDE_LOGGING_PATTERN_LAYOUT_H_
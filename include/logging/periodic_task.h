@@ -0,0 +1,70 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef INCLUDE_LOGGING_PERIODIC_TASK_H_
+#define INCLUDE_LOGGING_PERIODIC_TASK_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace logging {
+
+// Runs a callback on its own thread every interval, or earlier when woken up, until stopped.
+// Used by appenders for background housekeeping such as flushing or rotating files.
+class PeriodicTask {
+ public:
+  PeriodicTask() = default;
+  ~PeriodicTask();
+
+  PeriodicTask(const PeriodicTask&) = delete;
+  PeriodicTask& operator = (const PeriodicTask&) = delete;
+
+  // Returns false if the task is already running.
+  bool Start(std::chrono::milliseconds interval, std::function<void()> task);
+  // Wakes the thread up and joins it. The callback is not run again after Stop returns.
+  void Stop();
+  // Runs the callback as soon as possible instead of waiting for the rest of the interval.
+  void Wake();
+  // Waits for the next Wake() instead of the interval, e.g. from the callback when there is nothing to do.
+  // Waking up resumes the interval.
+  void Pause();
+  bool IsRunning() const { return m_thread.joinable(); }
+
+ private:
+  void Run();
+
+  std::chrono::milliseconds m_interval {0};
+  std::function<void()> m_task;
+  std::thread m_thread;
+  bool m_stop_requested = false;
+  bool m_wake_requested = false;
+  bool m_is_paused = false;
+  std::mutex m_mtx;
+  std::condition_variable m_cv;
+};
+
+}  // namespace logging
+
+#endif  // INCLUDE_LOGGING_PERIODIC_TASK_H_
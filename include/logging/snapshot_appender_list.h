@@ -0,0 +1,135 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef INCLUDE_LOGGING_SNAPSHOT_APPENDER_LIST_H_
+#define INCLUDE_LOGGING_SNAPSHOT_APPENDER_LIST_H_
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include "logging/appender_interface.h"
+
+namespace logging {
+
+// How long a replaced appender waits for the writers of older snapshots before it is left to its destructor.
+constexpr std::chrono::milliseconds kReplacedAppenderReleaseTimeout(100);
+
+// Copy-on-write list of appenders. Readers take an immutable snapshot without locking and keep the
+// appenders in it alive for as long as they hold it. Modifications publish a new snapshot; callers
+// have to serialize modifications themselves.
+class SnapshotAppenderList {
+ public:
+  SnapshotAppenderList() : m_appenders(std::make_shared<const AppenderList>()) {}
+
+  AppenderListPtr Load() const { return std::atomic_load_explicit(&m_appenders, std::memory_order_acquire); }
+
+  AppenderSharedPtr Find(const std::string & name) const {
+    AppenderListPtr appenders = Load();
+    auto it = std::find_if(appenders->begin(), appenders->end(), [&name](const AppenderSharedPtr & appender) {
+      return appender->GetAppenderName() == name;
+    });
+    return it == appenders->end() ? nullptr : *it;
+  }
+
+  // Returns false if an appender with the same name already exists.
+  bool Add(AppenderSharedPtr new_appender) {
+    if (Find(new_appender->GetAppenderName()) != nullptr) {
+      return false;
+    }
+    std::shared_ptr<AppenderList> appenders = std::make_shared<AppenderList>(*Load());
+    appenders->push_back(std::move(new_appender));
+    Publish(std::move(appenders));
+    return true;
+  }
+
+  // Returns the removed appender or nullptr.
+  AppenderSharedPtr Remove(const std::string & name) {
+    std::shared_ptr<AppenderList> appenders = std::make_shared<AppenderList>(*Load());
+    auto it = std::find_if(appenders->begin(), appenders->end(), [&name](const AppenderSharedPtr & appender) {
+      return appender->GetAppenderName() == name;
+    });
+    if (it == appenders->end()) {
+      return nullptr;
+    }
+    AppenderSharedPtr removed = *it;
+    appenders->erase(it);
+    Publish(std::move(appenders));
+    return removed;
+  }
+
+  // Puts new_appender in place of the appender with the same name, or at the end if there is none.
+  // Readers see either the old or the new appender. Returns the replaced appender or nullptr.
+  AppenderSharedPtr Replace(AppenderSharedPtr new_appender) {
+    std::shared_ptr<AppenderList> appenders = std::make_shared<AppenderList>(*Load());
+    const std::string name = new_appender->GetAppenderName();
+    auto it = std::find_if(appenders->begin(), appenders->end(), [&name](const AppenderSharedPtr & appender) {
+      return appender->GetAppenderName() == name;
+    });
+    AppenderSharedPtr replaced;
+    if (it == appenders->end()) {
+      appenders->push_back(std::move(new_appender));
+    } else {
+      replaced = std::move(*it);
+      *it = std::move(new_appender);
+    }
+    Publish(std::move(appenders));
+    return replaced;
+  }
+
+  void Assign(AppenderList appenders) {
+    Publish(std::make_shared<AppenderList>(std::move(appenders)));
+  }
+
+  // Flushes and closes an appender which was removed from all lists, once the readers of older snapshots
+  // are done with it. Snapshots kept for longer keep it open, it is then closed by its destructor.
+  static void CloseWhenReleased(AppenderSharedPtr appender) {
+    auto deadline = std::chrono::steady_clock::now() + kReplacedAppenderReleaseTimeout;
+    while (appender.use_count() > 1) {
+      if (std::chrono::steady_clock::now() >= deadline) {
+        return;
+      }
+      std::this_thread::yield();
+    }
+    appender->Flush();
+    appender->Close();
+  }
+
+  // Returns the snapshot which was replaced by the empty list.
+  AppenderListPtr Clear() {
+    AppenderListPtr empty = std::make_shared<const AppenderList>();
+    return std::atomic_exchange_explicit(&m_appenders, empty, std::memory_order_acq_rel);
+  }
+
+ private:
+  void Publish(std::shared_ptr<AppenderList> appenders) {
+    std::atomic_store_explicit(&m_appenders, AppenderListPtr(std::move(appenders)), std::memory_order_release);
+  }
+
+  AppenderListPtr m_appenders;
+};
+
+}  // namespace logging
+
+#endif  // INCLUDE_LOGGING_SNAPSHOT_APPENDER_LIST_H_
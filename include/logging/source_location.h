@@ -0,0 +1,51 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef INCLUDE_LOGGING_SOURCE_LOCATION_H_
+#define INCLUDE_LOGGING_SOURCE_LOCATION_H_
+
+#include <atomic>
+#include <cstdint>
+
+namespace logging {
+
+// Where a log statement is. All pointers refer to static strings (__FILE__, __func__), so copying
+// a location is three stores.
+struct SourceLocation {
+  const char * m_file = nullptr;
+  uint32_t m_line = 0;
+  const char * m_function = nullptr;
+};
+
+// Small sequential id of the calling thread, starting at 1. Assigned on first use and cached in a
+// thread local.
+inline uint32_t GetCurrentThreadId() {
+  static std::atomic<uint32_t> next_thread_id {1};
+  static thread_local const uint32_t thread_id = next_thread_id.fetch_add(1, std::memory_order_relaxed);
+  return thread_id;
+}
+
+}  // namespace logging
+
+#define LOGGING_SOURCE_LOCATION (::logging::SourceLocation{__FILE__, static_cast<uint32_t>(__LINE__), __func__})
+
+#endif  // INCLUDE_LOGGING_SOURCE_LOCATION_H_
@@ -0,0 +1,48 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef INCLUDE_LOGGING_TIMESTAMP_FORMATTER_H_
+#define INCLUDE_LOGGING_TIMESTAMP_FORMATTER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace logging {
+
+// Appends "YYYY-MM-DD HH:MM:SS.uuuuuu" in local time. The date and time part is rendered with
+// localtime_r only when the second changes, otherwise only the microsecond digits are written.
+// Not thread safe, every layout owns one.
+class TimestampFormatter {
+ public:
+  static constexpr std::size_t kFormattedSize = 26;
+
+  void Format(int64_t unix_nanos, std::string & output);
+
+ private:
+  int64_t m_cached_second = INT64_MIN;
+  char m_cached_prefix[20] = {};
+};
+
+}  // namespace logging
+
+#endif  // INCLUDE_LOGGING_TIMESTAMP_FORMATTER_H_
@@ -0,0 +1,60 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef INCLUDE_LOGGING_TRACE_APPENDER_H_
+#define INCLUDE_LOGGING_TRACE_APPENDER_H_
+
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include "logging/appender_base.h"
+
+namespace logging {
+
+// Captures the shape of the traffic instead of the messages: time, thread, level, message size and
+// logger of every event, in the format of log_trace.h, to <prefix>.trace. Configured with a
+// FileAppenderConfig of type TRACE; the file is always truncated and written through a buffer
+// which is flushed on Flush() and Close(). Replay the file with "loadgen -R".
+class TraceAppender : public AppenderBase {
+ public:
+  explicit TraceAppender(std::unique_ptr<AppenderConfig> appender_config, bool is_closed = false);
+  void Close() override;
+
+  const std::string & GetFileName() const { return m_filename; }
+
+ protected:
+  void HookedDoSend(const LogEvent & log_event) final;
+  void HookedFlush() final;
+
+ private:
+  std::mutex m_mtx;
+  std::string m_filename;
+  std::ofstream m_ofs;
+  // Reused for every event.
+  std::string m_line;
+};
+
+}  // namespace logging
+
+#endif  // INCLUDE_LOGGING_TRACE_APPENDER_H_
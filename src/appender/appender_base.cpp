@@ -25,21 +25,90 @@
 namespace logging {
 
 AppenderBase::AppenderBase()
-  : m_is_closed(false) {
+  : m_is_closed(false), m_level(LogLevel::NOT_SELECTED) {
 }
 
-AppenderBase::AppenderBase(std::unique_ptr<AppenderConfig> appender_config, bool is_closed) : m_appender_config (std::move(appender_config)), m_is_closed(is_closed) {}
+AppenderBase::AppenderBase(std::unique_ptr<AppenderConfig> appender_config, bool is_closed)
+  : m_appender_config (std::move(appender_config)), m_is_closed(is_closed), m_level(m_appender_config->m_level) {
+  m_deduplicator.SetConfig(m_appender_config->m_dedup_level, m_appender_config->m_dedup_window_ms);
+}
+
+void AppenderBase::SetAppenderConfig(std::unique_ptr<AppenderConfig> appender_config) {
+  m_deduplicator.SetConfig(appender_config->m_dedup_level, appender_config->m_dedup_window_ms);
+  m_level.store(appender_config->m_level, std::memory_order_relaxed);
+  m_appender_config = std::move(appender_config);
+}
+
+// m_appender_config stays as it is, writers read it without synchronization.
+bool AppenderBase::Reconfigure(const AppenderConfig & appender_config) {
+  if (!m_appender_config->IsReconfigurableTo(appender_config)) {
+    return false;
+  }
+  m_deduplicator.SetConfig(appender_config.m_dedup_level, appender_config.m_dedup_window_ms);
+  m_level.store(appender_config.m_level, std::memory_order_relaxed);
+  return true;
+}
+
+constexpr std::size_t AppenderBase::kBytesWrittenCounter;
+constexpr std::size_t AppenderBase::kSuppressedCounter;
+constexpr std::size_t AppenderBase::kFlushesCounter;
 
 void AppenderBase::Send(const LogEvent & log_event) {
-  /////////////////////////
-  // TODO Add pre filtering/formatting.
-  /////////////////////////
-  if (m_appender_config->m_level == LogLevel::NOT_SELECTED || m_appender_config->m_level == LogLevel::OFF) {
-    return;
+  if (AppenderLevelMask(m_level.load(std::memory_order_relaxed)) & LogLevelBit(log_event.m_log_level)) {
+    const bool is_timed = m_send_latency.ShouldSample();
+    const uint64_t start = is_timed ? LogClock::Now() : 0;
+    RepeatSummary summary;
+    bool is_new = m_deduplicator.Check(log_event, summary);
+    if (summary.m_count > 0) {
+      SendRepeatSummary(summary);
+    }
+    if (is_new) {
+      HookedDoSend(log_event);
+      m_counters.Add(static_cast<std::size_t>(log_event.m_log_level));
+    } else {
+      m_counters.Add(kSuppressedCounter);
+    }
+    if (is_timed) {
+      m_send_latency.Record(LogClock::Now() - start);
+    }
   }
-  if (m_appender_config->m_level >= log_event.m_log_level) {
-    HookedDoSend(log_event);
+}
+
+void AppenderBase::CollectStatistics(AppenderStatistics & statistics) const {
+  statistics.m_appender_name = m_appender_config->m_name;
+  for (std::size_t level = 1; level < kNumStatisticLevels; ++level) {
+    statistics.m_events[level] += m_counters.Load(level);
   }
+  statistics.m_bytes_written += m_counters.Load(kBytesWrittenCounter);
+  statistics.m_suppressed += m_counters.Load(kSuppressedCounter);
+  statistics.m_flushes += m_counters.Load(kFlushesCounter);
+  statistics.m_send_latency = m_send_latency.GetSnapshot();
+}
+
+void AppenderBase::Flush() {
+  RepeatSummary summary;
+  if (m_deduplicator.TakePendingRepeats(summary)) {
+    SendRepeatSummary(summary);
+  }
+  HookedFlush();
+  m_counters.Add(kFlushesCounter);
+}
+
+void AppenderBase::ReportExpiredRepeats() {
+  RepeatSummary summary;
+  if (m_deduplicator.TakeExpiredRepeats(LogClock::Now(), summary)) {
+    SendRepeatSummary(summary);
+  }
+}
+
+void AppenderBase::SendRepeatSummary(const RepeatSummary & summary) {
+  LogEvent log_event;
+  log_event.m_timestamp = LogClock::Now();
+  log_event.m_thread_id = GetCurrentThreadId();
+  log_event.m_log_level = summary.m_log_level;
+  log_event.m_logger_name = summary.m_logger_name;
+  log_event.m_message = "last message repeated " + std::to_string(summary.m_count) + " times";
+  HookedDoSend(log_event);
 }
 
 }  // namespace logging
@@ -35,6 +35,12 @@ bool AppenderConfig::IsValidConfig() {
   return ((m_appender_type != AppenderType::NONE) && (m_name != ""));
 }
 
+bool AppenderConfig::IsReconfigurableTo(const AppenderConfig & other) const {
+  return m_appender_type == other.m_appender_type && m_name == other.m_name && m_layout == other.m_layout
+      && m_pattern == other.m_pattern && m_queue_size == other.m_queue_size && m_overflow_policy == other.m_overflow_policy
+      && m_overflow_keep_level == other.m_overflow_keep_level;
+}
+
 AraLogAppenderConfig::AraLogAppenderConfig(AppenderType appender_type, std::string name) : AppenderConfig::AppenderConfig(appender_type, name) {}
 
 AraLogAppenderConfig::AraLogAppenderConfig(AppenderType appender_type, std::string name, std::string app_id, std::string app_description, std::string log_mode, std::string directory_path)
@@ -71,13 +77,76 @@ void AraLogAppenderConfig::InitFromCustomParametersStr(const std::string & custo
   std::cout << "CustomParameters: " << m_app_id << ", " << m_app_description << ", " << m_log_mode << ", " << m_directory_path << std::endl;
 }
 
-FileAppenderConfig::FileAppenderConfig(AppenderType appender_type, std::string name) : AppenderConfig::AppenderConfig(appender_type, name), m_output_file_path("/tmp/"), m_add_timestamp_to_file_name("TRUE"), m_file_name_prefix("default_prefix_"),  m_open_mode("") {}
+bool AraLogAppenderConfig::IsReconfigurableTo(const AppenderConfig & other) const {
+  const AraLogAppenderConfig * other_config = dynamic_cast<const AraLogAppenderConfig*>(&other);
+  return other_config != nullptr && AppenderConfig::IsReconfigurableTo(other) && m_app_id == other_config->m_app_id
+      && m_app_description == other_config->m_app_description && m_log_mode == other_config->m_log_mode
+      && m_directory_path == other_config->m_directory_path;
+}
+
+constexpr uint32_t AppenderConfig::kDefaultDedupWindowMs;
+
+constexpr std::size_t ConsoleAppenderConfig::kDefaultBufferSize;
+constexpr uint32_t ConsoleAppenderConfig::kDefaultFlushIntervalMs;
+
+ConsoleAppenderConfig::ConsoleAppenderConfig(AppenderType appender_type, std::string name, LogLevel level)
+  : AppenderConfig::AppenderConfig(appender_type, name, level) {}
+
+void ConsoleAppenderConfig::InitFromCustomParametersStr(const std::string & custom_parameters) {
+  std::stringstream ss(custom_parameters);
+  std::vector<std::string> custom_parameter_key_values;
+  while ( ss.good() ) {
+    std::string parameter;
+    std::getline(ss, parameter, ',');
+    custom_parameter_key_values.push_back(parameter);
+  }
+
+  for (auto key_value : custom_parameter_key_values) {
+    auto delimiterPos = key_value.find(":");
+    auto name = key_value.substr(0, delimiterPos);
+    auto value = key_value.substr(delimiterPos + 1);
+
+    if (name == "OutputMode") {
+      m_output_mode = value;
+    } else if (name == "Buffering") {
+      m_buffering = value;
+    } else if (name == "BufferSize") {
+      m_buffer_size = std::stoul(value);
+    } else if (name == "FlushIntervalMs") {
+      m_flush_interval_ms = std::stoul(value);
+    } else if (name == "ErrorsToStderr") {
+      m_errors_to_stderr = value;
+    } else {
+    }
+  }
+}
+
+bool ConsoleAppenderConfig::IsReconfigurableTo(const AppenderConfig & other) const {
+  const ConsoleAppenderConfig * other_config = dynamic_cast<const ConsoleAppenderConfig*>(&other);
+  return other_config != nullptr && AppenderConfig::IsReconfigurableTo(other) && m_output_mode == other_config->m_output_mode
+      && m_buffering == other_config->m_buffering && m_buffer_size == other_config->m_buffer_size
+      && m_flush_interval_ms == other_config->m_flush_interval_ms && m_errors_to_stderr == other_config->m_errors_to_stderr;
+}
+
+constexpr std::size_t FileAppenderConfig::kDefaultBufferSize;
+constexpr uint32_t FileAppenderConfig::kDefaultFlushIntervalMs;
+
+namespace {
+
+// Text log files keep the flush after every message unless a buffer is configured.
+std::size_t GetDefaultBufferSize(AppenderType appender_type) {
+  return appender_type == AppenderType::FILE ? 0 : FileAppenderConfig::kDefaultBufferSize;
+}
+
+}  // namespace
+
+FileAppenderConfig::FileAppenderConfig(AppenderType appender_type, std::string name) : AppenderConfig::AppenderConfig(appender_type, name), m_output_file_path("/tmp/"), m_add_timestamp_to_file_name("TRUE"), m_file_name_prefix("default_prefix_"),  m_open_mode(""), m_buffer_size(GetDefaultBufferSize(appender_type)) {}
 
 FileAppenderConfig::FileAppenderConfig(AppenderType appender_type, std::string name, std::string output_file_path, std::string add_timestamp_to_file_name = "TRUE", std::string file_name_prefix = "default_prefix_", std::string open_mode = "APPEND")
-  : AppenderConfig::AppenderConfig(appender_type, name), m_output_file_path(output_file_path), m_add_timestamp_to_file_name(add_timestamp_to_file_name), m_file_name_prefix(file_name_prefix), m_open_mode(open_mode) {}
+  : AppenderConfig::AppenderConfig(appender_type, name), m_output_file_path(output_file_path), m_add_timestamp_to_file_name(add_timestamp_to_file_name), m_file_name_prefix(file_name_prefix), m_open_mode(open_mode), m_buffer_size(GetDefaultBufferSize(appender_type)) {}
 
 FileAppenderConfig::FileAppenderConfig(AppenderType appender_type, std::string name, LogLevel level, std::string output_file_path, std::string add_timestamp_to_file_name = "TRUE", std::string file_name_prefix = "default_prefix_", std::string open_mode = "APPEND")
-  : AppenderConfig::AppenderConfig(appender_type, name, level), m_output_file_path(output_file_path), m_add_timestamp_to_file_name(add_timestamp_to_file_name), m_file_name_prefix(file_name_prefix), m_open_mode(open_mode) {}
+  : AppenderConfig::AppenderConfig(appender_type, name, level), m_output_file_path(output_file_path), m_add_timestamp_to_file_name(add_timestamp_to_file_name), m_file_name_prefix(file_name_prefix), m_open_mode(open_mode), m_buffer_size(GetDefaultBufferSize(appender_type)) {}
 
 bool FileAppenderConfig::IsValidConfig() { return ((m_appender_type != AppenderType::NONE) && (m_name != "") && (m_output_file_path != "")); }
 
@@ -103,10 +172,49 @@ void FileAppenderConfig::InitFromCustomParametersStr(const std::string & custom_
       m_file_name_prefix = value;
     } else if (name == "FileOpenMode") {
       m_open_mode = value;
+    } else if (name == "BufferSize") {
+      m_buffer_size = std::stoul(value);
+    } else if (name == "FlushIntervalMs") {
+      m_flush_interval_ms = std::stoul(value);
+    } else if (name == "FlushLevel") {
+      m_flush_level = LogLevellFromString(value);
+    } else if (name == "MaxFileSize") {
+      m_max_file_size = std::stoul(value);
+    } else if (name == "RotationIntervalSec") {
+      m_rotation_interval_sec = std::stoul(value);
+    } else if (name == "MaxFiles") {
+      m_max_files = std::stoul(value);
+    } else if (name == "Compression") {
+      m_compression = CompressionTypeFromString(value);
+    } else if (name == "MaxCompressionJobs") {
+      m_max_compression_jobs = std::stoul(value);
     } else {
     }
   }
-  std::cout << "CustomParameters: " << m_output_file_path << ", " << m_add_timestamp_to_file_name << ", " << m_file_name_prefix << ", " << m_open_mode << std::endl;
+  std::cout << "CustomParameters: " << m_output_file_path << ", " << m_add_timestamp_to_file_name << ", " << m_file_name_prefix << ", " << m_open_mode
+            << ", " << m_buffer_size << ", " << m_flush_interval_ms << ", " << LogLevellToString(m_flush_level)
+            << ", " << m_max_file_size << ", " << m_rotation_interval_sec << ", " << m_max_files
+            << ", " << static_cast<int>(m_compression) << ", " << m_max_compression_jobs << std::endl;
+}
+
+bool FileAppenderConfig::IsReconfigurableTo(const AppenderConfig & other) const {
+  const FileAppenderConfig * other_config = dynamic_cast<const FileAppenderConfig*>(&other);
+  return other_config != nullptr && AppenderConfig::IsReconfigurableTo(other) && m_output_file_path == other_config->m_output_file_path
+      && m_add_timestamp_to_file_name == other_config->m_add_timestamp_to_file_name && m_file_name_prefix == other_config->m_file_name_prefix
+      && m_open_mode == other_config->m_open_mode && m_buffer_size == other_config->m_buffer_size
+      && m_flush_interval_ms == other_config->m_flush_interval_ms && m_flush_level == other_config->m_flush_level
+      && m_max_file_size == other_config->m_max_file_size && m_rotation_interval_sec == other_config->m_rotation_interval_sec
+      && m_max_files == other_config->m_max_files && m_compression == other_config->m_compression
+      && m_max_compression_jobs == other_config->m_max_compression_jobs;
+}
+
+void FileAppenderConfig::ContinueOutputOf(const AppenderConfig & replaced) {
+  const FileAppenderConfig * replaced_config = dynamic_cast<const FileAppenderConfig*>(&replaced);
+  if (m_appender_type == AppenderType::FILE && replaced_config != nullptr && replaced_config->m_appender_type == AppenderType::FILE
+      && m_output_file_path == replaced_config->m_output_file_path && m_file_name_prefix == replaced_config->m_file_name_prefix
+      && m_add_timestamp_to_file_name == replaced_config->m_add_timestamp_to_file_name) {
+    m_open_mode = "APPEND";
+  }
 }
 
 }  // namespace logging
@@ -0,0 +1,236 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <utility>
+#include "logging/async_appender.h"
+#include "logging/log_clock.h"
+
+namespace logging {
+
+namespace {
+
+bool IsLessSevere(LogLevel log_level, LogLevel other) {
+  return static_cast<uint8_t>(log_level) > static_cast<uint8_t>(other);
+}
+
+}  // namespace
+
+AsyncAppender::AsyncAppender(AppenderUnqPtr appender)
+  : m_appender(std::move(appender)),
+    m_capacity(m_appender->GetAppenderConfig().m_queue_size > 0 ? m_appender->GetAppenderConfig().m_queue_size : 1),
+    m_overflow_policy(m_appender->GetAppenderConfig().m_overflow_policy),
+    m_overflow_keep_level(m_appender->GetAppenderConfig().m_overflow_keep_level) {
+  m_thread = std::thread(&AsyncAppender::Run, this);
+}
+
+AsyncAppender::~AsyncAppender() {
+  Stop();
+}
+
+void AsyncAppender::Send(const LogEvent & log_event) {
+  if ((AppenderLevelMask(m_appender->GetAppenderLogLevel()) & LogLevelBit(log_event.m_log_level)) == 0) {
+    return;
+  }
+  if (m_is_stopped.load(std::memory_order_acquire)) {
+    m_appender->Send(log_event);
+    return;
+  }
+  std::unique_lock<std::mutex> lock(m_mtx);
+  if (m_queue_size >= m_capacity && !MakeRoomLocked(lock, log_event)) {
+    CountDropLocked(log_event.m_log_level);
+    return;
+  }
+  // Only once the writer thread has finished, so the event can't overtake queued ones.
+  if (m_is_stopped.load(std::memory_order_relaxed)) {
+    lock.unlock();
+    m_appender->Send(log_event);
+    return;
+  }
+  bool was_empty = m_queue_size == 0;
+  m_queues[static_cast<std::size_t>(log_event.m_log_level)].push_back(QueuedEvent{m_next_sequence++, log_event});
+  ++m_queue_size;
+  ++m_accepted_count;
+  lock.unlock();
+  if (was_empty) {
+    m_not_empty_cv.notify_one();
+  }
+}
+
+bool AsyncAppender::MakeRoomLocked(std::unique_lock<std::mutex> & lock, const LogEvent & log_event) {
+  switch (m_overflow_policy) {
+    case (OverflowPolicy::DROP_NEWEST) : {
+      return false;
+    }
+    case (OverflowPolicy::DROP_OLDEST) : {
+      std::size_t oldest_level = FindOldest(m_queues);
+      m_queues[oldest_level].pop_front();
+      --m_queue_size;
+      ++m_done_count;
+      CountDropLocked(static_cast<LogLevel>(oldest_level));
+      return true;
+    }
+    case (OverflowPolicy::DROP_BELOW_LEVEL) : {
+      if (DropLessSevereLocked(log_event.m_log_level)) {
+        return true;
+      }
+      if (IsLessSevere(log_event.m_log_level, m_overflow_keep_level)) {
+        return false;
+      }
+      break;
+    }
+    default : {
+      break;
+    }
+  }
+  m_not_full_cv.wait(lock, [this] { return m_queue_size < m_capacity || m_is_stopped.load(std::memory_order_relaxed); });
+  return true;
+}
+
+bool AsyncAppender::DropLessSevereLocked(LogLevel log_level) {
+  for (std::size_t level = kNumLevels - 1; level > 0; --level) {
+    LogLevel victim_level = static_cast<LogLevel>(level);
+    if (!IsLessSevere(victim_level, log_level) || !IsLessSevere(victim_level, m_overflow_keep_level)) {
+      return false;
+    }
+    if (m_queues[level].empty()) {
+      continue;
+    }
+    m_queues[level].pop_front();
+    --m_queue_size;
+    ++m_done_count;
+    CountDropLocked(victim_level);
+    return true;
+  }
+  return false;
+}
+
+std::size_t AsyncAppender::FindOldest(const LevelQueues & queues) {
+  std::size_t oldest = kNumLevels;
+  for (std::size_t level = 0; level < kNumLevels; ++level) {
+    if (!queues[level].empty() &&
+        (oldest == kNumLevels || queues[level].front().m_sequence < queues[oldest].front().m_sequence)) {
+      oldest = level;
+    }
+  }
+  return oldest;
+}
+
+void AsyncAppender::CountDropLocked(LogLevel log_level) {
+  m_dropped_per_level[static_cast<std::size_t>(log_level)].fetch_add(1, std::memory_order_relaxed);
+  if (m_unreported_drops == 0 || IsLessSevere(m_unreported_level, log_level)) {
+    m_unreported_level = log_level;
+  }
+  ++m_unreported_drops;
+}
+
+uint64_t AsyncAppender::GetDroppedCount(LogLevel log_level) const {
+  std::size_t level = static_cast<std::size_t>(log_level);
+  return level < kNumLevels ? m_dropped_per_level[level].load(std::memory_order_relaxed) : 0;
+}
+
+void AsyncAppender::CollectStatistics(AppenderStatistics & statistics) const {
+  m_appender->CollectStatistics(statistics);
+  statistics.m_dropped += GetDroppedCount();
+}
+
+uint64_t AsyncAppender::GetDroppedCount() const {
+  uint64_t count = 0;
+  for (const auto & dropped : m_dropped_per_level) {
+    count += dropped.load(std::memory_order_relaxed);
+  }
+  return count;
+}
+
+void AsyncAppender::Run() {
+  LevelQueues batch;
+  std::unique_lock<std::mutex> lock(m_mtx);
+  for (;;) {
+    m_not_empty_cv.wait(lock, [this] { return m_queue_size > 0 || m_unreported_drops > 0 || m_stop_requested; });
+    if (m_queue_size == 0 && m_unreported_drops == 0 && m_stop_requested) {
+      // Under the lock, so no event is queued after the last batch.
+      m_is_stopped.store(true, std::memory_order_release);
+      break;
+    }
+    // Takes everything queued at once, so callers only contend for the swap.
+    batch.swap(m_queues);
+    std::size_t written = m_queue_size;
+    m_queue_size = 0;
+    uint64_t drops = m_unreported_drops;
+    LogLevel drop_level = m_unreported_level;
+    m_unreported_drops = 0;
+    lock.unlock();
+    m_not_full_cv.notify_all();
+
+    if (drops > 0) {
+      SendDropReport(drops, drop_level);
+    }
+    for (std::size_t level = FindOldest(batch); level < kNumLevels; level = FindOldest(batch)) {
+      m_appender->Send(batch[level].front().m_log_event);
+      batch[level].pop_front();
+    }
+
+    lock.lock();
+    m_done_count += written;
+    m_written_cv.notify_all();
+  }
+}
+
+void AsyncAppender::SendDropReport(uint64_t count, LogLevel log_level) {
+  LogEvent log_event;
+  log_event.m_timestamp = LogClock::Now();
+  log_event.m_thread_id = GetCurrentThreadId();
+  log_event.m_log_level = log_level;
+  log_event.m_logger_name = m_appender->GetAppenderName();
+  log_event.m_message = std::to_string(count) + " events dropped";
+  m_appender->Send(log_event);
+}
+
+void AsyncAppender::Flush() {
+  {
+    std::unique_lock<std::mutex> lock(m_mtx);
+    const uint64_t target = m_accepted_count;
+    m_written_cv.wait(lock, [this, target] { return m_done_count >= target || m_is_stopped.load(); });
+  }
+  m_appender->Flush();
+}
+
+void AsyncAppender::Stop() {
+  {
+    std::lock_guard<std::mutex> lock(m_mtx);
+    if (m_stop_requested) {
+      return;
+    }
+    m_stop_requested = true;
+  }
+  m_not_empty_cv.notify_one();
+  m_thread.join();
+  std::lock_guard<std::mutex> lock(m_mtx);
+  m_not_full_cv.notify_all();
+  m_written_cv.notify_all();
+}
+
+void AsyncAppender::Close() {
+  Stop();
+  m_appender->Close();
+}
+
+}  // namespace logging
@@ -0,0 +1,237 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <unistd.h>
+#include <cstring>
+#include <iostream>
+#include "logging/binary_appender.h"
+#include "logging/binary_log_format.h"
+#include "logging/file_appender.h"
+#include "logging/log_clock.h"
+
+namespace logging {
+
+BinaryAppender::BinaryAppender(std::unique_ptr<AppenderConfig> appender_config, bool is_closed) :
+AppenderBase::AppenderBase(std::move(appender_config), is_closed) {
+  FileAppenderConfig * file_appender_config = dynamic_cast<FileAppenderConfig*>(m_appender_config.get());
+  std::string file_name;
+  if (file_appender_config->m_add_timestamp_to_file_name == "TRUE") {
+    file_name = GetTimeStampedFileName(file_appender_config->m_file_name_prefix);
+  } else {
+    file_name = file_appender_config->m_file_name_prefix;
+  }
+  m_filename = file_appender_config->m_output_file_path;
+  if (m_filename.back() != '/') {
+    m_filename += '/';
+  }
+  m_filename += file_name + ".bin";
+
+  std::lock_guard<std::mutex> lock(m_mtx);
+  std::size_t buffer_size = file_appender_config->m_buffer_size;
+  if (buffer_size > 0) {
+    // Has to be installed before open() to take effect.
+    m_buffer.reset(new char[buffer_size]);
+    m_ofs.rdbuf()->pubsetbuf(m_buffer.get(), buffer_size);
+    m_flush_level_mask = LogLevelMask(file_appender_config->m_flush_level);
+  } else {
+    m_flush_level_mask = kAllLogLevelsMask;
+  }
+  m_bytes_written = 0;
+  m_has_unflushed = false;
+  m_last_timestamp = 0;
+  m_next_string_id = 1;
+  try {
+    m_ofs.open(m_filename, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+  }
+  catch(std::exception& error) {
+    std::cout << "Exception: " << error.what() << std::endl;
+  }
+  WriteHeader();
+
+  if (buffer_size > 0 && file_appender_config->m_flush_interval_ms > 0) {
+    m_flush_task.Start(std::chrono::milliseconds(file_appender_config->m_flush_interval_ms), [this] { Flush(); });
+  }
+}
+
+BinaryAppender::~BinaryAppender() {
+  m_flush_task.Stop();
+}
+
+void BinaryAppender::Close() {
+  m_flush_task.Stop();
+  std::lock_guard<std::mutex> lock(m_mtx);
+  try { m_ofs.close(); } catch(...) {}
+}
+
+void BinaryAppender::HookedFlush() {
+  std::lock_guard<std::mutex> lock(m_mtx);
+  if (m_has_unflushed) {
+    m_ofs << std::flush;
+    m_has_unflushed = false;
+  }
+}
+
+uint64_t BinaryAppender::GetBytesWritten() {
+  std::lock_guard<std::mutex> lock(m_mtx);
+  return m_bytes_written;
+}
+
+void BinaryAppender::WriteHeader() {
+  m_last_timestamp = LogClock::ToUnixNanos(LogClock::Now());
+  std::string metadata = "appender=" + m_appender_config->m_name + "\npid=" + std::to_string(::getpid()) + "\n";
+  std::string header(kBinaryLogMagic, kBinaryLogMagicSize);
+  header += static_cast<char>(kBinaryLogVersion);
+  AppendVarint(static_cast<uint64_t>(m_last_timestamp), header);
+  AppendVarint(metadata.size(), header);
+  header += metadata;
+  m_ofs.write(header.data(), header.size());
+  m_ofs << std::flush;
+  m_bytes_written += header.size();
+  AddBytesWritten(header.size());
+}
+
+void BinaryAppender::WriteRecord(const std::string & record) {
+  // At most 10 bytes, stays in the small string buffer.
+  std::string length;
+  AppendVarint(record.size(), length);
+  m_ofs.write(length.data(), length.size());
+  m_ofs.write(record.data(), record.size());
+  m_bytes_written += length.size() + record.size();
+  AddBytesWritten(length.size() + record.size());
+}
+
+uint64_t BinaryAppender::GetLoggerId(const std::string & logger_name) {
+  auto it = m_logger_ids.find(logger_name);
+  if (it != m_logger_ids.end()) {
+    return it->second;
+  }
+  uint64_t id = m_logger_ids.size() + 1;
+  m_logger_ids.emplace(logger_name, id);
+  m_definition.clear();
+  m_definition += static_cast<char>(BinaryRecordType::LOGGER);
+  AppendVarint(id, m_definition);
+  m_definition += logger_name;
+  WriteRecord(m_definition);
+  return id;
+}
+
+uint64_t BinaryAppender::GetStringId(const char * value) {
+  m_string_key.assign(value);
+  auto it = m_string_ids.find(m_string_key);
+  if (it != m_string_ids.end()) {
+    return it->second;
+  }
+  uint64_t id = DefineString(m_string_key.data(), m_string_key.size());
+  m_string_ids.emplace(m_string_key, id);
+  return id;
+}
+
+uint64_t BinaryAppender::DefineString(const char * value, std::size_t length) {
+  uint64_t id = m_next_string_id++;
+  m_definition.clear();
+  m_definition += static_cast<char>(BinaryRecordType::STRING);
+  AppendVarint(id, m_definition);
+  m_definition.append(value, length);
+  WriteRecord(m_definition);
+  return id;
+}
+
+void BinaryAppender::AppendArguments(const LogArguments & arguments, std::string & output) {
+  const char * data = arguments.GetData();
+  const char * data_end = data + arguments.GetSize();
+  LogArgumentValue value;
+  while (data < data_end) {
+    data = LogArguments::ReadArgument(data, value);
+    output += static_cast<char>(value.m_type);
+    switch (value.m_type) {
+      case (LogArgumentType::BOOL) : {
+        output += static_cast<char>(value.m_bool);
+        break;
+      }
+      case (LogArgumentType::CHAR) : {
+        output += value.m_char;
+        break;
+      }
+      case (LogArgumentType::INT64) : {
+        AppendZigZag(value.m_int64, output);
+        break;
+      }
+      case (LogArgumentType::UINT64) : {
+        AppendVarint(value.m_uint64, output);
+        break;
+      }
+      case (LogArgumentType::POINTER) : {
+        AppendVarint(reinterpret_cast<uintptr_t>(value.m_pointer), output);
+        break;
+      }
+      case (LogArgumentType::DOUBLE) : {
+        char bytes[sizeof(double)];
+        std::memcpy(bytes, &value.m_double, sizeof(bytes));
+        output.append(bytes, sizeof(bytes));
+        break;
+      }
+      case (LogArgumentType::KEY) : {
+        AppendVarint(GetStringId(value.m_string), output);
+        break;
+      }
+      default : {
+        AppendVarint(value.m_length, output);
+        output.append(value.m_string, value.m_length);
+        break;
+      }
+    }
+  }
+}
+
+void BinaryAppender::HookedDoSend(const LogEvent & log_event) {
+  std::lock_guard<std::mutex> lock(m_mtx);
+  uint64_t logger_id = GetLoggerId(log_event.m_logger_name);
+  // Plain messages are written inline, only format strings are worth a table entry.
+  uint64_t format_id = log_event.m_format != nullptr ? GetStringId(log_event.m_format) : 0;
+  int64_t timestamp = log_event.m_timestamp != 0 ? LogClock::ToUnixNanos(log_event.m_timestamp) : m_last_timestamp;
+
+  m_record.clear();
+  m_record += static_cast<char>(BinaryRecordType::EVENT);
+  m_record += static_cast<char>(log_event.m_log_level);
+  AppendVarint(logger_id, m_record);
+  AppendZigZag(timestamp - m_last_timestamp, m_record);
+  AppendVarint(log_event.m_thread_id, m_record);
+  AppendVarint(format_id, m_record);
+  if (format_id == 0) {
+    AppendVarint(log_event.m_message.size(), m_record);
+    m_record += log_event.m_message;
+  }
+  AppendVarint(log_event.m_arguments.GetCount(), m_record);
+  AppendArguments(log_event.m_arguments, m_record);
+  AppendArguments(log_event.m_fields, m_record);
+  m_last_timestamp = timestamp;
+  WriteRecord(m_record);
+
+  if (m_flush_level_mask & LogLevelBit(log_event.m_log_level)) {
+    m_ofs << std::flush;
+    m_has_unflushed = false;
+  } else {
+    m_has_unflushed = true;
+  }
+}
+
+}  // namespace logging
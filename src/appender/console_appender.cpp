@@ -20,26 +20,115 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include <errno.h>
+#include <unistd.h>
 #include <iostream>
+#include <sstream>
 #include "logging/console_appender.h"
 
 namespace logging {
 
-ConsoleAppender::ConsoleAppender() : AppenderBase::AppenderBase(std::make_unique<AppenderConfig>(AppenderType::CONSOLE, "ConcoleAppender")), m_message_appender_host() {
+namespace {
+
+void WriteToFd(int fd, const char * data, std::size_t size) {
+  while (size > 0) {
+    ssize_t written = ::write(fd, data, size);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return;
+    }
+    data += written;
+    size -= static_cast<std::size_t>(written);
+  }
+}
+
+}  // namespace
+
+ConsoleAppender::ConsoleAppender() : AppenderBase::AppenderBase(std::make_unique<AppenderConfig>(AppenderType::CONSOLE, "ConcoleAppender")), m_message_appender_host(),
+  m_is_direct(false), m_is_line_buffered(true), m_errors_to_stderr(false), m_buffer_size(0) {
 }
 
 ConsoleAppender::ConsoleAppender(std::unique_ptr<AppenderConfig> appender_config, bool is_closed) :
-AppenderBase::AppenderBase(std::move(appender_config), is_closed) {
-  m_message_appender_host.AddHeader(std::cout);
+AppenderBase::AppenderBase(std::move(appender_config), is_closed), m_is_direct(false), m_is_line_buffered(true), m_errors_to_stderr(false), m_buffer_size(0) {
+  m_message_appender_host.SetLayout(m_appender_config->m_layout);
+  if (!m_appender_config->m_pattern.empty()) {
+    m_message_appender_host.SetPattern(m_appender_config->m_pattern);
+  }
+  ConsoleAppenderConfig * console_appender_config = dynamic_cast<ConsoleAppenderConfig*>(m_appender_config.get());
+  if (console_appender_config != nullptr && console_appender_config->m_output_mode == "DIRECT") {
+    m_is_direct = true;
+    if (console_appender_config->m_buffering == "LINE") {
+      m_is_line_buffered = true;
+    } else if (console_appender_config->m_buffering == "BLOCK") {
+      m_is_line_buffered = false;
+    } else {
+      // Terminals want to see lines right away, pipes (e.g. container log capture) prefer batches.
+      m_is_line_buffered = ::isatty(STDOUT_FILENO) != 0;
+    }
+    m_errors_to_stderr = console_appender_config->m_errors_to_stderr == "TRUE";
+    m_buffer_size = console_appender_config->m_buffer_size;
+    m_buffer.reserve(m_buffer_size);
+    if (m_message_appender_host.HasHeader()) {
+      std::ostringstream header;
+      m_message_appender_host.AddHeader(header);
+      m_buffer += header.str();
+    }
+    FlushLocked();
+    if (!m_is_line_buffered && console_appender_config->m_flush_interval_ms > 0) {
+      m_flush_task.Start(std::chrono::milliseconds(console_appender_config->m_flush_interval_ms), [this] { Flush(); });
+    }
+  } else if (m_message_appender_host.HasHeader()) {
+    m_message_appender_host.AddHeader(std::cout);
+  }
+}
+
+ConsoleAppender::~ConsoleAppender() {
+  m_flush_task.Stop();
+  Flush();
 }
 
 void ConsoleAppender::Close() {
+  m_flush_task.Stop();
+  Flush();
   m_is_closed = true;
 }
 
+void ConsoleAppender::HookedFlush() {
+  std::lock_guard<std::mutex> lock(m_mtx);
+  FlushLocked();
+}
+
+void ConsoleAppender::FlushLocked() {
+  if (m_is_direct) {
+    WriteToFd(STDOUT_FILENO, m_buffer.data(), m_buffer.size());
+    AddBytesWritten(m_buffer.size());
+    m_buffer.clear();
+  } else {
+    std::cout << std::flush;
+  }
+}
+
 void ConsoleAppender::HookedDoSend(const LogEvent & log_event) {
-  m_message_appender_host.SendMessage(std::cout, log_event);
-  Flush();
+  std::lock_guard<std::mutex> lock(m_mtx);
+  if (!m_is_direct) {
+    AddBytesWritten(m_message_appender_host.SendMessage(std::cout, log_event));
+    FlushLocked();
+    return;
+  }
+  if (m_errors_to_stderr && (log_event.m_log_level == LogLevel::ERROR || log_event.m_log_level == LogLevel::FATAL)) {
+    // Keeps the order of stdout and stderr lines when both end up in the same place.
+    FlushLocked();
+    const std::string & message = m_message_appender_host.FormatMessage(log_event);
+    WriteToFd(STDERR_FILENO, message.data(), message.size());
+    AddBytesWritten(message.size());
+    return;
+  }
+  m_buffer += m_message_appender_host.FormatMessage(log_event);
+  if (m_is_line_buffered || m_buffer.size() >= m_buffer_size) {
+    FlushLocked();
+  }
 }
 
 }  // namespace logging
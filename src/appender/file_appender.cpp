@@ -20,9 +20,14 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
 #include <iostream>
 #include <stdio.h>
 #include <time.h>
+#include <algorithm>
 #include <mutex>
 #include "logging/file_appender.h"
 
@@ -60,35 +65,231 @@ AppenderBase::AppenderBase(std::move(appender_config), is_closed) {
     file_name = file_appender_config->m_file_name_prefix;
   }
 
-  std::string file_name_with_path;
-
   if (file_appender_config->m_output_file_path.back() != '/') {
-    file_name_with_path = file_appender_config->m_output_file_path + '/' + file_name + ".txt";
+    m_directory = file_appender_config->m_output_file_path + '/';
   } else {
-    file_name_with_path = file_appender_config->m_output_file_path + file_name + ".txt";
+    m_directory = file_appender_config->m_output_file_path;
+  }
+  m_message_appender_host.SetLayout(file_appender_config->m_layout);
+  if (!file_appender_config->m_pattern.empty()) {
+    m_message_appender_host.SetPattern(file_appender_config->m_pattern);
   }
+  m_file_stem = file_name;
+  m_filename = m_directory + m_file_stem + ".txt";
+  m_buffer_size = file_appender_config->m_buffer_size;
+  m_max_file_size = file_appender_config->m_max_file_size;
+  m_rotation_interval = std::chrono::seconds(file_appender_config->m_rotation_interval_sec);
+  m_max_files = file_appender_config->m_max_files;
+  m_compression = file_appender_config->m_compression;
+  if (!FileCompressor::IsSupported(m_compression)) {
+    std::cout << "Compression type is not supported by this build, rotated files are kept uncompressed." << std::endl;
+    m_compression = CompressionType::NONE;
+  }
+  m_rotation_requested = false;
+  m_next_sequence = 0;
+
   std::unique_lock<std::mutex> lock(m_mtx);
+  if (m_buffer_size > 0) {
+    m_flush_level_mask = LogLevelMask(file_appender_config->m_flush_level);
+  } else {
+    m_flush_level_mask = kAllLogLevelsMask;
+  }
+  m_has_unflushed = false;
+  m_file = OpenOutputFile(file_appender_config->m_open_mode);
+  lock.unlock();
+
+  if (m_buffer_size > 0 && file_appender_config->m_flush_interval_ms > 0) {
+    m_flush_task.Start(std::chrono::milliseconds(file_appender_config->m_flush_interval_ms), [this] { Flush(); });
+  }
+  if (IsRotationEnabled()) {
+    std::vector<uint64_t> rotated_files = ListRotatedFiles();
+    if (!rotated_files.empty()) {
+      m_next_sequence = rotated_files.back() + 1;
+    }
+    m_next_rotation_time = std::chrono::steady_clock::now() + m_rotation_interval;
+    if (m_compression != CompressionType::NONE) {
+      // Old files are pruned once their compression has finished, not while it is still running.
+      m_compressor.Start(m_compression, file_appender_config->m_max_compression_jobs, [this] { RemoveOldRotatedFiles(); });
+    }
+    m_rotation_task.Start(std::chrono::seconds(1), [this] { RotateIfNeeded(); });
+  }
+}
+
+FileAppender::~FileAppender() {
+  m_rotation_task.Stop();
+  m_flush_task.Stop();
+  m_compressor.Stop();
+}
+
+void FileAppender::Close() {
+  m_rotation_task.Stop();
+  m_flush_task.Stop();
+  m_compressor.Stop();
+  std::lock_guard<std::mutex> lock(m_mtx);
+  try { m_file->m_ofs.close(); } catch(...) {}
+}
+
+void FileAppender::HookedFlush() {
+  std::lock_guard<std::mutex> lock(m_mtx);
+  if (m_has_unflushed) {
+    FlushLocked();
+  }
+}
+
+void FileAppender::FlushLocked() {
+  m_file->m_ofs << std::flush;
+  m_has_unflushed = false;
+}
+
+std::unique_ptr<FileAppender::OutputFile> FileAppender::OpenOutputFile(const std::string & open_mode) {
+  std::unique_ptr<OutputFile> file(new OutputFile());
+  if (m_buffer_size > 0) {
+    // Has to be installed before open() to take effect.
+    file->m_buffer.reset(new char[m_buffer_size]);
+    file->m_ofs.rdbuf()->pubsetbuf(file->m_buffer.get(), m_buffer_size);
+  }
   try {
-     m_ofs.open(file_name_with_path, std::ofstream::out | LogModeStrToOpenMode(file_appender_config->m_open_mode));
+    std::ofstream::openmode mode = LogModeStrToOpenMode(open_mode);
+    // Always written in append mode, so an appender replacing this one on the same file (see
+    // Logger::ReplaceAppender) never overwrites what this one still writes, or the other way round.
+    if ((mode & std::ofstream::app) == 0 && ::truncate(m_filename.c_str(), 0) != 0 && errno != ENOENT) {
+      std::cout << "Failed to truncate " << m_filename << std::endl;
+    }
+    file->m_ofs.open(m_filename, std::ofstream::out | std::ofstream::app | (mode & std::ofstream::binary));
   }
   catch(std::exception& error) {
     std::cout << "Exception: " << error.what() << std::endl;
-    try { m_ofs.close(); }
+    try { file->m_ofs.close(); }
     catch(...) {
     }
   }
-  m_message_appender_host.AddHeader(m_ofs);
-  lock.unlock();
-}
-
-void FileAppender::Close() {
-  try { m_ofs.close(); } catch(...) {}
+  // In APPEND mode the file counts towards MaxFileSize with what it already holds.
+  struct stat file_stat;
+  if (::stat(m_filename.c_str(), &file_stat) == 0) {
+    file->m_size = static_cast<std::size_t>(file_stat.st_size);
+  }
+  file->m_has_messages = file->m_size > 0;
+  if (m_message_appender_host.HasHeader()) {
+    std::size_t header_size = m_message_appender_host.AddHeader(file->m_ofs);
+    file->m_size += header_size;
+    AddBytesWritten(header_size);
+  }
+  file->m_ofs << std::flush;
+  return file;
 }
 
 void FileAppender::HookedDoSend(const LogEvent & log_event) {
   std::lock_guard<std::mutex> lock(m_mtx);
-  m_message_appender_host.SendMessage(m_ofs, log_event);
-  Flush();
+  std::size_t bytes = m_message_appender_host.SendMessage(m_file->m_ofs, log_event);
+  m_file->m_size += bytes;
+  m_file->m_has_messages = true;
+  AddBytesWritten(bytes);
+  if (m_flush_level_mask & LogLevelBit(log_event.m_log_level)) {
+    FlushLocked();
+  } else {
+    m_has_unflushed = true;
+  }
+  if (m_max_file_size > 0 && m_file->m_size >= m_max_file_size && !m_rotation_requested) {
+    m_rotation_requested = true;
+    m_rotation_task.Wake();
+  }
+}
+
+void FileAppender::RotateIfNeeded() {
+  bool rotate = false;
+  bool has_messages = false;
+  {
+    std::lock_guard<std::mutex> lock(m_mtx);
+    rotate = m_rotation_requested;
+    has_messages = m_file->m_has_messages;
+  }
+  if (m_rotation_interval.count() > 0 && std::chrono::steady_clock::now() >= m_next_rotation_time) {
+    // Files without messages are kept for the next interval instead of being rotated empty.
+    if (has_messages) {
+      rotate = true;
+    } else {
+      m_next_rotation_time = std::chrono::steady_clock::now() + m_rotation_interval;
+    }
+  }
+  if (rotate) {
+    Rotate();
+    m_next_rotation_time = std::chrono::steady_clock::now() + m_rotation_interval;
+  }
+}
+
+void FileAppender::Rotate() {
+  // Writers keep going into the renamed file until the new one is swapped in.
+  std::string rotated_file_name = GetRotatedFileName(m_next_sequence++);
+  if (::rename(m_filename.c_str(), rotated_file_name.c_str()) != 0) {
+    std::cout << "Failed to rotate " << m_filename << std::endl;
+  }
+  std::unique_ptr<OutputFile> file = OpenOutputFile("TRUNCATE");
+  {
+    std::lock_guard<std::mutex> lock(m_mtx);
+    m_file.swap(file);
+    m_has_unflushed = false;
+    m_rotation_requested = false;
+  }
+  try { file->m_ofs.close(); } catch(...) {}
+  file.reset();
+  if (m_compression != CompressionType::NONE) {
+    m_compressor.Submit(rotated_file_name);
+  } else {
+    RemoveOldRotatedFiles();
+  }
+}
+
+std::string FileAppender::GetRotatedFileName(uint64_t sequence) const {
+  return m_directory + m_file_stem + "." + std::to_string(sequence) + ".txt";
+}
+
+std::vector<uint64_t> FileAppender::ListRotatedFiles() const {
+  std::vector<uint64_t> sequences;
+  DIR * dir = ::opendir(m_directory.c_str());
+  if (dir == nullptr) {
+    return sequences;
+  }
+  const std::string prefix = m_file_stem + ".";
+  while (struct dirent * entry = ::readdir(dir)) {
+    std::string name(entry->d_name);
+    if (name.compare(0, prefix.size(), prefix) != 0) {
+      continue;
+    }
+    // <n>.txt, or <n>.txt.gz / <n>.txt.zst once compressed.
+    std::size_t suffix_pos = name.find(".txt", prefix.size());
+    if (suffix_pos == std::string::npos || suffix_pos == prefix.size()) {
+      continue;
+    }
+    std::string suffix = name.substr(suffix_pos);
+    if (suffix != ".txt" && suffix != ".txt.gz" && suffix != ".txt.zst") {
+      continue;
+    }
+    std::string sequence = name.substr(prefix.size(), suffix_pos - prefix.size());
+    if (sequence.find_first_not_of("0123456789") == std::string::npos) {
+      sequences.push_back(std::stoull(sequence));
+    }
+  }
+  ::closedir(dir);
+  std::sort(sequences.begin(), sequences.end());
+  sequences.erase(std::unique(sequences.begin(), sequences.end()), sequences.end());
+  return sequences;
+}
+
+void FileAppender::RemoveOldRotatedFiles() {
+  if (m_max_files == 0) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(m_prune_mtx);
+  std::vector<uint64_t> rotated_files = ListRotatedFiles();
+  for (std::size_t i = 0; i + m_max_files < rotated_files.size(); ++i) {
+    std::string rotated_file_name = GetRotatedFileName(rotated_files[i]);
+    if (m_compression != CompressionType::NONE && m_compressor.IsPending(rotated_file_name)) {
+      continue;
+    }
+    ::remove(rotated_file_name.c_str());
+    ::remove((rotated_file_name + FileCompressor::GetFileExtension(CompressionType::GZIP)).c_str());
+    ::remove((rotated_file_name + FileCompressor::GetFileExtension(CompressionType::ZSTD)).c_str());
+  }
 }
 
 }  // namespace logging
@@ -0,0 +1,229 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <stdio.h>
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <vector>
+#ifdef __linux__
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#ifdef LOGGING_HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef LOGGING_HAVE_ZSTD
+#include <zstd.h>
+#endif
+#include "logging/file_compressor.h"
+
+namespace logging {
+
+namespace {
+
+constexpr std::size_t kChunkSize = 64 * 1024;
+
+#ifdef LOGGING_HAVE_ZLIB
+bool CompressGzip(std::ifstream & ifs, const std::string & compressed_file_name) {
+  gzFile gz = gzopen(compressed_file_name.c_str(), "wb6");
+  if (gz == nullptr) {
+    return false;
+  }
+  std::vector<char> buffer(kChunkSize);
+  bool result = true;
+  while (result && ifs) {
+    ifs.read(buffer.data(), buffer.size());
+    std::streamsize size = ifs.gcount();
+    if (size > 0 && gzwrite(gz, buffer.data(), static_cast<unsigned>(size)) != size) {
+      result = false;
+    }
+  }
+  return gzclose(gz) == Z_OK && result;
+}
+#endif
+
+#ifdef LOGGING_HAVE_ZSTD
+bool CompressZstd(std::ifstream & ifs, const std::string & compressed_file_name) {
+  std::ofstream ofs(compressed_file_name, std::ofstream::binary | std::ofstream::trunc);
+  ZSTD_CCtx * cctx = ZSTD_createCCtx();
+  if (!ofs || cctx == nullptr) {
+    ZSTD_freeCCtx(cctx);
+    return false;
+  }
+  std::vector<char> in_buffer(ZSTD_CStreamInSize());
+  std::vector<char> out_buffer(ZSTD_CStreamOutSize());
+  bool result = true;
+  bool last_chunk = false;
+  while (result && !last_chunk) {
+    ifs.read(in_buffer.data(), in_buffer.size());
+    last_chunk = !ifs;
+    ZSTD_inBuffer input = { in_buffer.data(), static_cast<std::size_t>(ifs.gcount()), 0 };
+    ZSTD_EndDirective mode = last_chunk ? ZSTD_e_end : ZSTD_e_continue;
+    bool finished = false;
+    while (result && !finished) {
+      ZSTD_outBuffer output = { out_buffer.data(), out_buffer.size(), 0 };
+      std::size_t remaining = ZSTD_compressStream2(cctx, &output, &input, mode);
+      if (ZSTD_isError(remaining)) {
+        result = false;
+      }
+      ofs.write(out_buffer.data(), output.pos);
+      finished = last_chunk ? (remaining == 0) : (input.pos == input.size);
+    }
+  }
+  ZSTD_freeCCtx(cctx);
+  ofs.close();
+  return result && ofs;
+}
+#endif
+
+void LowerThreadPriority() {
+#ifdef __linux__
+  // Linux applies nice values per thread.
+  setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), 19);
+#endif
+}
+
+}  // namespace
+
+FileCompressor::~FileCompressor() {
+  Stop();
+}
+
+bool FileCompressor::IsSupported(CompressionType compression_type) {
+  switch (compression_type) {
+    case CompressionType::NONE:
+      return true;
+#ifdef LOGGING_HAVE_ZLIB
+    case CompressionType::GZIP:
+      return true;
+#endif
+#ifdef LOGGING_HAVE_ZSTD
+    case CompressionType::ZSTD:
+      return true;
+#endif
+    default:
+      return false;
+  }
+}
+
+std::string FileCompressor::GetFileExtension(CompressionType compression_type) {
+  if (compression_type == CompressionType::GZIP) return ".gz";
+  else if (compression_type == CompressionType::ZSTD) return ".zst";
+  else return "";
+}
+
+bool FileCompressor::CompressFile(CompressionType compression_type, const std::string & file_name, const std::string & compressed_file_name) {
+  std::ifstream ifs(file_name, std::ifstream::binary);
+  if (!ifs) {
+    return false;
+  }
+  bool result = false;
+#ifdef LOGGING_HAVE_ZLIB
+  if (compression_type == CompressionType::GZIP) {
+    result = CompressGzip(ifs, compressed_file_name);
+  }
+#endif
+#ifdef LOGGING_HAVE_ZSTD
+  if (compression_type == CompressionType::ZSTD) {
+    result = CompressZstd(ifs, compressed_file_name);
+  }
+#endif
+  return result;
+}
+
+bool FileCompressor::Start(CompressionType compression_type, std::size_t max_jobs, std::function<void()> on_compressed) {
+  std::lock_guard<std::mutex> lock(m_mtx);
+  if (!m_threads.empty()) {
+    return false;
+  }
+  m_compression_type = compression_type;
+  m_on_compressed = std::move(on_compressed);
+  m_stop_requested = false;
+  for (std::size_t i = 0; i < std::max<std::size_t>(max_jobs, 1); ++i) {
+    m_threads.emplace_back(&FileCompressor::Run, this);
+  }
+  return true;
+}
+
+void FileCompressor::Stop() {
+  std::vector<std::thread> threads;
+  {
+    std::lock_guard<std::mutex> lock(m_mtx);
+    m_stop_requested = true;
+    threads.swap(m_threads);
+  }
+  m_cv.notify_all();
+  for (auto & thread : threads) {
+    thread.join();
+  }
+}
+
+void FileCompressor::Submit(const std::string & file_name) {
+  {
+    std::lock_guard<std::mutex> lock(m_mtx);
+    m_pending.push_back(file_name);
+  }
+  m_cv.notify_one();
+}
+
+bool FileCompressor::IsPending(const std::string & file_name) {
+  std::lock_guard<std::mutex> lock(m_mtx);
+  return m_in_progress.count(file_name) > 0 ||
+      std::find(m_pending.begin(), m_pending.end(), file_name) != m_pending.end();
+}
+
+void FileCompressor::Run() {
+  LowerThreadPriority();
+  std::unique_lock<std::mutex> lock(m_mtx);
+  while (true) {
+    m_cv.wait(lock, [this] { return m_stop_requested || !m_pending.empty(); });
+    if (m_pending.empty()) {
+      break;
+    }
+    std::string file_name = std::move(m_pending.front());
+    m_pending.pop_front();
+    m_in_progress.insert(file_name);
+    lock.unlock();
+
+    // Written under a temporary name so a partial file is never mistaken for a finished one.
+    std::string compressed_file_name = file_name + GetFileExtension(m_compression_type);
+    std::string temporary_file_name = compressed_file_name + ".tmp";
+    if (CompressFile(m_compression_type, file_name, temporary_file_name) &&
+        ::rename(temporary_file_name.c_str(), compressed_file_name.c_str()) == 0) {
+      ::remove(file_name.c_str());
+    } else {
+      ::remove(temporary_file_name.c_str());
+      std::cout << "Failed to compress " << file_name << std::endl;
+    }
+    lock.lock();
+    m_in_progress.erase(file_name);
+    if (m_on_compressed) {
+      lock.unlock();
+      m_on_compressed();
+      lock.lock();
+    }
+  }
+}
+
+}  // namespace logging
@@ -0,0 +1,86 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <iostream>
+#include "logging/trace_appender.h"
+#include "logging/file_appender.h"
+#include "logging/log_clock.h"
+#include "logging/log_trace.h"
+
+namespace logging {
+
+TraceAppender::TraceAppender(std::unique_ptr<AppenderConfig> appender_config, bool is_closed) :
+AppenderBase::AppenderBase(std::move(appender_config), is_closed) {
+  FileAppenderConfig * file_appender_config = dynamic_cast<FileAppenderConfig*>(m_appender_config.get());
+  std::string file_name;
+  if (file_appender_config->m_add_timestamp_to_file_name == "TRUE") {
+    file_name = GetTimeStampedFileName(file_appender_config->m_file_name_prefix);
+  } else {
+    file_name = file_appender_config->m_file_name_prefix;
+  }
+  m_filename = file_appender_config->m_output_file_path;
+  if (m_filename.back() != '/') {
+    m_filename += '/';
+  }
+  m_filename += file_name + ".trace";
+
+  std::lock_guard<std::mutex> lock(m_mtx);
+  try {
+    m_ofs.open(m_filename, std::ofstream::out | std::ofstream::trunc);
+  }
+  catch(std::exception& error) {
+    std::cout << "Exception: " << error.what() << std::endl;
+  }
+  m_line = kTraceHeader;
+  m_line += '\n';
+  m_ofs << m_line;
+  AddBytesWritten(m_line.size());
+}
+
+void TraceAppender::Close() {
+  std::lock_guard<std::mutex> lock(m_mtx);
+  try { m_ofs.close(); } catch(...) {}
+}
+
+void TraceAppender::HookedFlush() {
+  std::lock_guard<std::mutex> lock(m_mtx);
+  m_ofs << std::flush;
+}
+
+void TraceAppender::HookedDoSend(const LogEvent & log_event) {
+  TraceRecord record;
+  record.m_unix_nanos = LogClock::ToUnixNanos(log_event.m_timestamp);
+  record.m_thread_id = log_event.m_thread_id;
+  record.m_log_level = log_event.m_log_level;
+  // Formats deferred messages, which the replay needs the size of.
+  record.m_message_size = log_event.GetMessage().size();
+  record.m_logger_name = log_event.m_logger_name;
+
+  std::lock_guard<std::mutex> lock(m_mtx);
+  m_line.clear();
+  AppendTraceRecord(record, m_line);
+  m_ofs << m_line;
+  AddBytesWritten(m_line.size());
+}
+
+}  // namespace logging
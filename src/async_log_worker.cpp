@@ -0,0 +1,142 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <chrono>
+#include <utility>
+#include "logging/async_log_worker.h"
+#include "logging/logger.h"
+
+namespace logging {
+
+AsyncLogWorker::~AsyncLogWorker() {
+  Stop();
+}
+
+bool AsyncLogWorker::Start(std::size_t queue_capacity) {
+  std::lock_guard<std::mutex> lock(m_start_stop_mtx);
+  if (m_thread.joinable()) {
+    return false;
+  }
+  m_queue.reset(new MpscQueue<AsyncLogRecord>(queue_capacity));
+  m_processed_count.store(0);
+  m_stop_requested.store(false);
+  m_thread = std::thread(&AsyncLogWorker::Run, this);
+  m_accepting.store(true);
+  return true;
+}
+
+void AsyncLogWorker::Stop() {
+  std::lock_guard<std::mutex> lock(m_start_stop_mtx);
+  if (!m_thread.joinable()) {
+    return;
+  }
+  m_accepting.store(false);
+  m_stop_requested.store(true);
+  WakeUpBackend();
+  m_thread.join();
+  m_queue.reset();
+}
+
+void AsyncLogWorker::Flush() {
+  std::lock_guard<std::mutex> start_stop_lock(m_start_stop_mtx);
+  if (!m_thread.joinable() || std::this_thread::get_id() == m_thread.get_id()) {
+    return;
+  }
+  const std::size_t target = m_queue->GetEnqueuedCount();
+  m_flush_waiters.fetch_add(1);
+  WakeUpBackend();
+  std::unique_lock<std::mutex> lock(m_mtx);
+  m_flush_cv.wait(lock, [this, target] { return m_processed_count.load(std::memory_order_acquire) >= target; });
+  m_flush_waiters.fetch_sub(1);
+}
+
+bool AsyncLogWorker::Enqueue(const Logger * logger, LogEvent & log_event) {
+  // Every synchronous log statement passes here, so it only reads the flag until asynchronous mode is started.
+  if (!m_accepting.load(std::memory_order_acquire)) {
+    return false;
+  }
+  m_active_producers.fetch_add(1);
+  if (!m_accepting.load()) {
+    m_active_producers.fetch_sub(1);
+    return false;
+  }
+
+  AsyncLogRecord record;
+  record.m_logger = logger;
+  record.m_log_event = std::move(log_event);
+  while (!m_queue->TryPush(std::move(record))) {
+    if (std::this_thread::get_id() == m_backend_thread_id.load(std::memory_order_relaxed)) {
+      // An appender logging from the backend thread would wait for itself, it writes the event directly.
+      log_event = std::move(record.m_log_event);
+      m_active_producers.fetch_sub(1);
+      return false;
+    }
+    // Queue is full. Make sure the backend is awake and give it time to catch up.
+    WakeUpBackend();
+    std::this_thread::yield();
+  }
+  if (m_backend_waiting.load()) {
+    WakeUpBackend();
+  }
+  m_active_producers.fetch_sub(1);
+  return true;
+}
+
+void AsyncLogWorker::Run() {
+  m_backend_thread_id.store(std::this_thread::get_id(), std::memory_order_relaxed);
+  AsyncLogRecord record;
+  for (;;) {
+    if (m_queue->TryPop(record)) {
+      record.m_logger->Dispatch(record.m_log_event);
+      m_processed_count.fetch_add(1, std::memory_order_release);
+      if (m_flush_waiters.load(std::memory_order_relaxed) > 0) {
+        std::lock_guard<std::mutex> lock(m_mtx);
+        m_flush_cv.notify_all();
+      }
+      continue;
+    }
+
+    // Producers which passed the accepting check before Stop() finish their push before leaving,
+    // so once none is active an empty queue stays empty.
+    if (m_stop_requested.load() && m_active_producers.load() == 0 && m_queue->IsEmpty()) {
+      break;
+    }
+
+    std::unique_lock<std::mutex> lock(m_mtx);
+    m_flush_cv.notify_all();
+    m_backend_waiting.store(true);
+    if (m_queue->IsEmpty() && !m_stop_requested.load()) {
+      m_backend_cv.wait_for(lock, std::chrono::milliseconds(10));
+    }
+    m_backend_waiting.store(false);
+  }
+
+  std::lock_guard<std::mutex> lock(m_mtx);
+  m_flush_cv.notify_all();
+}
+
+void AsyncLogWorker::WakeUpBackend() {
+  { std::lock_guard<std::mutex> lock(m_mtx); }
+  m_backend_cv.notify_one();
+}
+
+}  // namespace logging
@@ -0,0 +1,237 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include "logging/binary_log_format.h"
+#include "logging/binary_log_reader.h"
+
+namespace logging {
+
+namespace {
+
+bool ReadInputVarint(std::istream & input, uint64_t & value) {
+  value = 0;
+  for (unsigned shift = 0; shift < 64; shift += 7) {
+    int byte = input.get();
+    if (byte == std::char_traits<char>::eof()) {
+      return false;
+    }
+    value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Grows output with the bytes actually read, so a corrupt size can't allocate more than the input holds.
+bool ReadInputBytes(std::istream & input, uint64_t size, std::string & output) {
+  constexpr uint64_t kChunkSize = 64 * 1024;
+  output.clear();
+  while (output.size() < size) {
+    std::size_t offset = output.size();
+    std::size_t chunk = static_cast<std::size_t>(std::min<uint64_t>(size - offset, kChunkSize));
+    output.resize(offset + chunk);
+    if (!input.read(&output[offset], chunk)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+bool BinaryLogReader::ReadHeader() {
+  char magic[kBinaryLogMagicSize];
+  if (!m_input.read(magic, sizeof(magic)) || std::memcmp(magic, kBinaryLogMagic, sizeof(magic)) != 0) {
+    return false;
+  }
+  if (m_input.get() != kBinaryLogVersion) {
+    return false;
+  }
+  uint64_t start_time = 0;
+  uint64_t metadata_size = 0;
+  if (!ReadInputVarint(m_input, start_time) || !ReadInputVarint(m_input, metadata_size)) {
+    return false;
+  }
+  m_start_time = static_cast<int64_t>(start_time);
+  m_last_timestamp = m_start_time;
+  return metadata_size <= kBinaryLogMaxMetadataSize && ReadInputBytes(m_input, metadata_size, m_metadata);
+}
+
+bool BinaryLogReader::ReadRecord() {
+  uint64_t size = 0;
+  if (m_input.peek() == std::char_traits<char>::eof()) {
+    m_is_at_end = true;
+    return false;
+  }
+  if (!ReadInputVarint(m_input, size) || size == 0 || size > kBinaryLogMaxRecordSize) {
+    return false;
+  }
+  return ReadInputBytes(m_input, size, m_record);
+}
+
+bool BinaryLogReader::ReadEvent(LogEvent & log_event, int64_t & unix_nanos) {
+  while (ReadRecord()) {
+    const char * data = m_record.data();
+    const char * data_end = data + m_record.size();
+    BinaryRecordType type = static_cast<BinaryRecordType>(*data++);
+    if (type == BinaryRecordType::EVENT) {
+      return ParseEvent(data, data_end, log_event, unix_nanos);
+    }
+    if (type == BinaryRecordType::LOGGER || type == BinaryRecordType::STRING) {
+      uint64_t id = 0;
+      data = ReadVarint(data, data_end, id);
+      if (data == nullptr) {
+        return false;
+      }
+      auto & names = type == BinaryRecordType::LOGGER ? m_loggers : m_strings;
+      names[id].assign(data, data_end);
+    }
+  }
+  return false;
+}
+
+bool BinaryLogReader::ParseEvent(const char * data, const char * data_end, LogEvent & log_event, int64_t & unix_nanos) {
+  log_event = LogEvent();
+  uint64_t logger_id = 0;
+  int64_t timestamp_delta = 0;
+  uint64_t thread_id = 0;
+  uint64_t format_id = 0;
+  uint64_t count = 0;
+  if (data >= data_end) {
+    return false;
+  }
+  log_event.m_log_level = static_cast<LogLevel>(*data++);
+  if ((data = ReadVarint(data, data_end, logger_id)) == nullptr ||
+      (data = ReadZigZag(data, data_end, timestamp_delta)) == nullptr ||
+      (data = ReadVarint(data, data_end, thread_id)) == nullptr ||
+      (data = ReadVarint(data, data_end, format_id)) == nullptr) {
+    return false;
+  }
+  auto logger = m_loggers.find(logger_id);
+  if (logger == m_loggers.end()) {
+    return false;
+  }
+  log_event.m_logger_name = logger->second;
+  log_event.m_thread_id = static_cast<uint32_t>(thread_id);
+  m_last_timestamp += timestamp_delta;
+  unix_nanos = m_last_timestamp;
+
+  if (format_id == 0) {
+    uint64_t length = 0;
+    data = ReadVarint(data, data_end, length);
+    if (data == nullptr || length > static_cast<uint64_t>(data_end - data)) {
+      return false;
+    }
+    log_event.m_message.assign(data, length);
+    data += length;
+  } else {
+    auto format = m_strings.find(format_id);
+    if (format == m_strings.end()) {
+      return false;
+    }
+    log_event.m_format = format->second.c_str();
+  }
+  if ((data = ReadVarint(data, data_end, count)) == nullptr ||
+      (data = ReadArguments(data, data_end, count, log_event.m_arguments)) == nullptr) {
+    return false;
+  }
+  return ReadArguments(data, data_end, std::numeric_limits<uint64_t>::max(), log_event.m_fields) != nullptr;
+}
+
+const char * BinaryLogReader::ReadArguments(const char * data, const char * data_end, uint64_t count, LogArguments & arguments) {
+  for (uint64_t i = 0; i < count && data < data_end; ++i) {
+    LogArgumentType type = static_cast<LogArgumentType>(*data++);
+    uint64_t value = 0;
+    switch (type) {
+      case (LogArgumentType::BOOL) :
+      case (LogArgumentType::CHAR) : {
+        if (data >= data_end) {
+          return nullptr;
+        }
+        if (type == LogArgumentType::BOOL) {
+          arguments.AddArgument(*data != 0);
+        } else {
+          arguments.AddArgument(*data);
+        }
+        ++data;
+        break;
+      }
+      case (LogArgumentType::INT64) : {
+        int64_t signed_value = 0;
+        data = ReadZigZag(data, data_end, signed_value);
+        arguments.AddArgument(signed_value);
+        break;
+      }
+      case (LogArgumentType::UINT64) : {
+        data = ReadVarint(data, data_end, value);
+        arguments.AddArgument(value);
+        break;
+      }
+      case (LogArgumentType::POINTER) : {
+        data = ReadVarint(data, data_end, value);
+        arguments.AddArgument(reinterpret_cast<const void *>(static_cast<uintptr_t>(value)));
+        break;
+      }
+      case (LogArgumentType::DOUBLE) : {
+        double double_value = 0;
+        if (data_end - data < static_cast<std::ptrdiff_t>(sizeof(double_value))) {
+          return nullptr;
+        }
+        std::memcpy(&double_value, data, sizeof(double_value));
+        data += sizeof(double_value);
+        arguments.AddArgument(double_value);
+        break;
+      }
+      case (LogArgumentType::STRING) : {
+        data = ReadVarint(data, data_end, value);
+        if (data == nullptr || value > static_cast<uint64_t>(data_end - data)) {
+          return nullptr;
+        }
+        arguments.AddArgument(std::string(data, value));
+        data += value;
+        break;
+      }
+      case (LogArgumentType::KEY) : {
+        data = ReadVarint(data, data_end, value);
+        auto key = m_strings.find(value);
+        if (key == m_strings.end()) {
+          return nullptr;
+        }
+        arguments.AddKey(key->second.c_str());
+        break;
+      }
+      default : {
+        return nullptr;
+      }
+    }
+    if (data == nullptr) {
+      return nullptr;
+    }
+  }
+  return data;
+}
+
+}  // namespace logging
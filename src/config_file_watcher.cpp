@@ -0,0 +1,174 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <unistd.h>
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#else
+#include <sys/stat.h>
+#endif
+#include <cerrno>
+#include <utility>
+#include "logging/config_file_watcher.h"
+
+namespace logging {
+
+constexpr int ConfigFileWatcher::kDebounceMs;
+constexpr int ConfigFileWatcher::kPollIntervalMs;
+
+namespace {
+
+std::string DirectoryOf(const std::string & file_name) {
+  auto slash = file_name.find_last_of('/');
+  if (slash == std::string::npos) {
+    return ".";
+  }
+  return slash == 0 ? "/" : file_name.substr(0, slash);
+}
+
+std::string BaseNameOf(const std::string & file_name) {
+  auto slash = file_name.find_last_of('/');
+  return slash == std::string::npos ? file_name : file_name.substr(slash + 1);
+}
+
+}  // namespace
+
+ConfigFileWatcher::~ConfigFileWatcher() {
+  Stop();
+}
+
+#ifdef __linux__
+
+bool ConfigFileWatcher::Start(const std::string & file_name, std::function<void()> on_change) {
+  if (IsRunning()) {
+    return false;
+  }
+  m_inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (m_inotify_fd < 0) {
+    return false;
+  }
+  // The directory is watched, replacing the file by a rename drops a watch on the file itself.
+  if (inotify_add_watch(m_inotify_fd, DirectoryOf(file_name).c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0 ||
+      pipe(m_stop_pipe) != 0) {
+    close(m_inotify_fd);
+    m_inotify_fd = -1;
+    return false;
+  }
+  m_file_name = file_name;
+  m_on_change = std::move(on_change);
+  m_thread = std::thread(&ConfigFileWatcher::Run, this);
+  return true;
+}
+
+void ConfigFileWatcher::Stop() {
+  if (!m_thread.joinable()) {
+    return;
+  }
+  char stop = 0;
+  while (write(m_stop_pipe[1], &stop, 1) < 0 && errno == EINTR) {
+  }
+  m_thread.join();
+  close(m_inotify_fd);
+  close(m_stop_pipe[0]);
+  close(m_stop_pipe[1]);
+  m_inotify_fd = -1;
+  m_stop_pipe[0] = m_stop_pipe[1] = -1;
+}
+
+void ConfigFileWatcher::Run() {
+  const std::string base_name = BaseNameOf(m_file_name);
+  pollfd fds[2] = {{m_inotify_fd, POLLIN, 0}, {m_stop_pipe[0], POLLIN, 0}};
+  bool changed = false;
+  while (true) {
+    // Once the file changed, waits until it has been quiet for kDebounceMs.
+    int ready = poll(fds, 2, changed ? kDebounceMs : -1);
+    if (ready < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      break;
+    }
+    if (ready == 0) {
+      changed = false;
+      m_on_change();
+      continue;
+    }
+    if (fds[1].revents != 0) {
+      break;
+    }
+    alignas(inotify_event) char buffer[4096];
+    ssize_t length;
+    while ((length = read(m_inotify_fd, buffer, sizeof(buffer))) > 0) {
+      for (char * position = buffer; position < buffer + length;) {
+        const inotify_event * event = reinterpret_cast<const inotify_event *>(position);
+        if (event->len > 0 && base_name == event->name) {
+          changed = true;
+        }
+        position += sizeof(inotify_event) + event->len;
+      }
+    }
+  }
+}
+
+void ConfigFileWatcher::PollModificationTime() {
+}
+
+#else
+
+bool ConfigFileWatcher::Start(const std::string & file_name, std::function<void()> on_change) {
+  if (IsRunning()) {
+    return false;
+  }
+  m_file_name = file_name;
+  m_on_change = std::move(on_change);
+  struct stat file_stat;
+  if (stat(m_file_name.c_str(), &file_stat) == 0) {
+    m_modification_time = file_stat.st_mtime;
+    m_file_size = file_stat.st_size;
+  }
+  return m_poll_task.Start(std::chrono::milliseconds(kPollIntervalMs), [this] { PollModificationTime(); });
+}
+
+void ConfigFileWatcher::Stop() {
+  m_poll_task.Stop();
+}
+
+void ConfigFileWatcher::Run() {
+}
+
+// The modification time has a resolution of one second here, so the size is compared as well.
+void ConfigFileWatcher::PollModificationTime() {
+  struct stat file_stat;
+  if (stat(m_file_name.c_str(), &file_stat) != 0) {
+    return;
+  }
+  if (file_stat.st_mtime != m_modification_time || file_stat.st_size != m_file_size) {
+    m_modification_time = file_stat.st_mtime;
+    m_file_size = file_stat.st_size;
+    m_on_change();
+  }
+}
+
+#endif
+
+}  // namespace logging
@@ -0,0 +1,144 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define LOGGING_HAVE_X86_SIMD 1
+#endif
+#include "logging/json_escape.h"
+
+namespace logging {
+
+namespace {
+
+inline bool NeedsEscape(unsigned char c) {
+  return c < 0x20 || c == '"' || c == '\\';
+}
+
+void AppendEscapedChar(unsigned char c, std::string & output) {
+  static const char kHexDigits[] = "0123456789abcdef";
+  switch (c) {
+    case '"': output.append("\\\"", 2); break;
+    case '\\': output.append("\\\\", 2); break;
+    case '\n': output.append("\\n", 2); break;
+    case '\r': output.append("\\r", 2); break;
+    case '\t': output.append("\\t", 2); break;
+    case '\b': output.append("\\b", 2); break;
+    case '\f': output.append("\\f", 2); break;
+    default: {
+      char escaped[6] = {'\\', 'u', '0', '0', kHexDigits[c >> 4], kHexDigits[c & 0xf]};
+      output.append(escaped, sizeof(escaped));
+      break;
+    }
+  }
+}
+
+#ifdef LOGGING_HAVE_X86_SIMD
+// Length of the prefix of data which needs no escaping, 16 bytes at a time.
+std::size_t FindEscapeSse2(const char * data, std::size_t length) {
+  const __m128i quote = _mm_set1_epi8('"');
+  const __m128i backslash = _mm_set1_epi8('\\');
+  // c < 0x20 as a signed compare: bytes >= 0x80 are negative, so they are excluded with a second test.
+  const __m128i control_limit = _mm_set1_epi8(0x20);
+  std::size_t i = 0;
+  for (; i + 16 <= length; i += 16) {
+    __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+    __m128i is_control = _mm_andnot_si128(_mm_cmplt_epi8(chunk, _mm_setzero_si128()), _mm_cmplt_epi8(chunk, control_limit));
+    __m128i matches = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)), is_control);
+    int mask = _mm_movemask_epi8(matches);
+    if (mask != 0) {
+      return i + __builtin_ctz(static_cast<unsigned>(mask));
+    }
+  }
+  return i;
+}
+
+__attribute__((target("avx2")))
+std::size_t FindEscapeAvx2(const char * data, std::size_t length) {
+  const __m256i quote = _mm256_set1_epi8('"');
+  const __m256i backslash = _mm256_set1_epi8('\\');
+  const __m256i control_max = _mm256_set1_epi8(0x1f);
+  std::size_t i = 0;
+  for (; i + 32 <= length; i += 32) {
+    __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+    // Unsigned c <= 0x1f is min(c, 0x1f) == c.
+    __m256i is_control = _mm256_cmpeq_epi8(_mm256_min_epu8(chunk, control_max), chunk);
+    __m256i matches = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote), _mm256_cmpeq_epi8(chunk, backslash)), is_control);
+    unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(matches));
+    if (mask != 0) {
+      return i + __builtin_ctz(mask);
+    }
+  }
+  return i;
+}
+
+using FindEscapeFunction = std::size_t (*)(const char *, std::size_t);
+
+FindEscapeFunction SelectFindEscape() {
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2") ? FindEscapeAvx2 : FindEscapeSse2;
+}
+#endif
+
+}  // namespace
+
+void AppendJsonEscapedScalar(const char * data, std::size_t length, std::string & output) {
+  std::size_t run_begin = 0;
+  for (std::size_t i = 0; i < length; ++i) {
+    unsigned char c = static_cast<unsigned char>(data[i]);
+    if (NeedsEscape(c)) {
+      output.append(data + run_begin, i - run_begin);
+      AppendEscapedChar(c, output);
+      run_begin = i + 1;
+    }
+  }
+  output.append(data + run_begin, length - run_begin);
+}
+
+void AppendJsonEscaped(const char * data, std::size_t length, std::string & output) {
+#ifdef LOGGING_HAVE_X86_SIMD
+  static const FindEscapeFunction find_escape = SelectFindEscape();
+  while (length > 0) {
+    // Either the position of a byte to escape or the start of a tail shorter than a vector.
+    std::size_t clean = find_escape(data, length);
+    output.append(data, clean);
+    data += clean;
+    length -= clean;
+    if (length == 0) {
+      break;
+    }
+    unsigned char c = static_cast<unsigned char>(*data);
+    if (NeedsEscape(c)) {
+      AppendEscapedChar(c, output);
+      ++data;
+      --length;
+    } else {
+      AppendJsonEscapedScalar(data, length, output);
+      break;
+    }
+  }
+#else
+  AppendJsonEscapedScalar(data, length, output);
+#endif
+}
+
+}  // namespace logging
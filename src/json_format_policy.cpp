@@ -0,0 +1,123 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include "logging/json_escape.h"
+#include "logging/json_format_policy.h"
+
+namespace logging {
+
+namespace {
+
+void AppendJsonString(const char * data, std::size_t length, std::string & output) {
+  output += '"';
+  AppendJsonEscaped(data, length, output);
+  output += '"';
+}
+
+void AppendJsonString(const std::string & value, std::string & output) {
+  AppendJsonString(value.data(), value.size(), output);
+}
+
+void AppendJsonKey(const char * key, std::string & output) {
+  AppendJsonString(key, std::strlen(key), output);
+  output += ':';
+}
+
+void AppendJsonValue(const LogArgumentValue & value, std::string & output) {
+  char buffer[32];
+  int length = 0;
+  switch (value.m_type) {
+    case (LogArgumentType::BOOL) :
+    case (LogArgumentType::INT64) :
+    case (LogArgumentType::UINT64) : {
+      LogArguments::AppendValue(value, output);
+      break;
+    }
+    case (LogArgumentType::DOUBLE) : {
+      if (std::isfinite(value.m_double)) {
+        length = std::snprintf(buffer, sizeof(buffer), "%.17g", value.m_double);
+        output.append(buffer, length);
+      } else {
+        output.append("null");
+      }
+      break;
+    }
+    case (LogArgumentType::CHAR) : {
+      AppendJsonString(&value.m_char, 1, output);
+      break;
+    }
+    case (LogArgumentType::POINTER) : {
+      length = std::snprintf(buffer, sizeof(buffer), "%p", value.m_pointer);
+      AppendJsonString(buffer, length, output);
+      break;
+    }
+    default : {
+      AppendJsonString(value.m_string, value.m_length, output);
+      break;
+    }
+  }
+}
+
+}  // namespace
+
+void JsonFormatPolicy::Render(const LogEvent & log_event, std::string & output) {
+  output.append("{\"time\":\"");
+  m_timestamp_formatter.Format(LogClock::ToUnixNanos(log_event.m_timestamp), output);
+  output.append("\",\"level\":\"");
+  output.append(LogLevelToCString(log_event.m_log_level));
+  output.append("\",\"logger\":");
+  AppendJsonString(log_event.m_logger_name, output);
+  output.append(",\"thread\":");
+  output.append(std::to_string(log_event.m_thread_id));
+  output.append(",\"message\":");
+  AppendJsonString(log_event.GetMessage(), output);
+  if (log_event.m_location.m_file != nullptr) {
+    output.append(",\"file\":");
+    AppendJsonString(log_event.m_location.m_file, std::strlen(log_event.m_location.m_file), output);
+    output.append(",\"line\":");
+    output.append(std::to_string(log_event.m_location.m_line));
+    if (log_event.m_location.m_function != nullptr) {
+      output.append(",\"function\":");
+      AppendJsonString(log_event.m_location.m_function, std::strlen(log_event.m_location.m_function), output);
+    }
+  }
+  if (!log_event.m_fields.IsEmpty()) {
+    output.append(",\"fields\":{");
+    bool first = true;
+    log_event.m_fields.ForEachField([&output, &first](const char * key, const LogArgumentValue & value) {
+      if (!first) {
+        output += ',';
+      }
+      first = false;
+      AppendJsonKey(key, output);
+      AppendJsonValue(value, output);
+    });
+    output += '}';
+  }
+  output.append("}\n");
+}
+
+}  // namespace logging
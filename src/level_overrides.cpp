@@ -0,0 +1,121 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "logging/level_overrides.h"
+
+namespace logging {
+
+constexpr const char * LevelOverrides::kRegexPrefix;
+
+namespace {
+
+// Regular expression matching the same names as glob.
+std::string GlobToRegex(const std::string & glob) {
+  static const std::string kSpecialCharacters = "\\^$.|+()[]{}";
+  std::string regex;
+  for (char c : glob) {
+    if (c == '*') {
+      regex += ".*";
+    } else if (c == '?') {
+      regex += '.';
+    } else {
+      if (kSpecialCharacters.find(c) != std::string::npos) {
+        regex += '\\';
+      }
+      regex += c;
+    }
+  }
+  return regex;
+}
+
+}  // namespace
+
+LevelOverrides::TrieNode & LevelOverrides::GetNode(const std::string & key) {
+  TrieNode * node = &m_root;
+  for (char c : key) {
+    std::unique_ptr<TrieNode> & child = node->m_children[c];
+    if (child == nullptr) {
+      child = std::make_unique<TrieNode>();
+    }
+    node = child.get();
+  }
+  return *node;
+}
+
+bool LevelOverrides::Add(const std::string & pattern, LogLevel log_level) {
+  const std::string regex_prefix(kRegexPrefix);
+  if (pattern.compare(0, regex_prefix.size(), regex_prefix) == 0) {
+    try {
+      m_patterns.emplace_back(std::regex(pattern.substr(regex_prefix.size())), log_level);
+    }
+    catch (const std::regex_error &) {
+      return false;
+    }
+    return true;
+  }
+  auto wildcard = pattern.find_first_of("*?");
+  if (wildcard == std::string::npos) {
+    TrieNode & node = GetNode(pattern);
+    node.m_has_exact_level = true;
+    node.m_exact_level = log_level;
+  } else if (wildcard == pattern.size() - 1 && pattern[wildcard] == '*') {
+    TrieNode & node = GetNode(pattern.substr(0, wildcard));
+    node.m_has_prefix_level = true;
+    node.m_prefix_level = log_level;
+  } else {
+    m_patterns.emplace_back(std::regex(GlobToRegex(pattern)), log_level);
+  }
+  return true;
+}
+
+bool LevelOverrides::Match(const std::string & name, LogLevel & log_level) const {
+  const TrieNode * node = &m_root;
+  const TrieNode * longest_prefix = m_root.m_has_prefix_level ? &m_root : nullptr;
+  for (char c : name) {
+    auto child = node->m_children.find(c);
+    if (child == node->m_children.end()) {
+      node = nullptr;
+      break;
+    }
+    node = child->second.get();
+    if (node->m_has_prefix_level) {
+      longest_prefix = node;
+    }
+  }
+  if (node != nullptr && node->m_has_exact_level) {
+    log_level = node->m_exact_level;
+    return true;
+  }
+  if (longest_prefix != nullptr) {
+    log_level = longest_prefix->m_prefix_level;
+    return true;
+  }
+  for (const auto & pattern : m_patterns) {
+    if (std::regex_match(name, pattern.first)) {
+      log_level = pattern.second;
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace logging
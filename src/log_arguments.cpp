@@ -0,0 +1,208 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cinttypes>
+#include <cstdio>
+#include <stdexcept>
+#include <utility>
+#include "logging/log_arguments.h"
+
+namespace logging {
+
+constexpr std::size_t LogArguments::kInlineCapacity;
+
+LogArguments & LogArguments::operator = (const LogArguments & other) {
+  if (this != &other) {
+    Assign(other);
+  }
+  return *this;
+}
+
+LogArguments & LogArguments::operator = (LogArguments && other) noexcept {
+  if (this != &other) {
+    Assign(std::move(other));
+  }
+  return *this;
+}
+
+void LogArguments::Assign(const LogArguments & other) {
+  m_size = 0;
+  m_count = other.m_count;
+  std::memcpy(Reserve(other.m_size), other.GetData(), other.m_size);
+}
+
+void LogArguments::Assign(LogArguments && other) noexcept {
+  m_count = other.m_count;
+  if (other.m_heap) {
+    m_heap = std::move(other.m_heap);
+    m_capacity = other.m_capacity;
+    m_size = other.m_size;
+  } else {
+    // Whatever storage this object has is at least as big as the inline storage of the other one.
+    m_size = other.m_size;
+    std::memcpy(m_heap ? m_heap.get() : m_inline, other.m_inline, other.m_size);
+  }
+  other.m_capacity = kInlineCapacity;
+  other.Clear();
+}
+
+void LogArguments::AddString(const char * value, std::size_t length) {
+  uint32_t converted_length = static_cast<uint32_t>(length);
+  char * destination = Reserve(1 + sizeof(converted_length) + length);
+  destination[0] = static_cast<char>(LogArgumentType::STRING);
+  std::memcpy(destination + 1, &converted_length, sizeof(converted_length));
+  if (length > 0) {
+    std::memcpy(destination + 1 + sizeof(converted_length), value, length);
+  }
+  ++m_count;
+}
+
+void LogArguments::Grow(std::size_t required) {
+  std::size_t capacity = m_capacity * 2;
+  while (capacity < required) {
+    capacity *= 2;
+  }
+  std::unique_ptr<char[]> heap(new char[capacity]);
+  std::memcpy(heap.get(), GetData(), m_size);
+  m_heap = std::move(heap);
+  m_capacity = capacity;
+}
+
+const char * LogArguments::ReadArgument(const char * data, LogArgumentValue & value) {
+  value.m_type = static_cast<LogArgumentType>(*data++);
+  switch (value.m_type) {
+    case (LogArgumentType::BOOL) : {
+      std::memcpy(&value.m_bool, data, sizeof(value.m_bool));
+      return data + sizeof(value.m_bool);
+    }
+    case (LogArgumentType::CHAR) : {
+      value.m_char = *data;
+      return data + 1;
+    }
+    case (LogArgumentType::INT64) : {
+      std::memcpy(&value.m_int64, data, sizeof(value.m_int64));
+      return data + sizeof(value.m_int64);
+    }
+    case (LogArgumentType::UINT64) : {
+      std::memcpy(&value.m_uint64, data, sizeof(value.m_uint64));
+      return data + sizeof(value.m_uint64);
+    }
+    case (LogArgumentType::DOUBLE) : {
+      std::memcpy(&value.m_double, data, sizeof(value.m_double));
+      return data + sizeof(value.m_double);
+    }
+    case (LogArgumentType::POINTER) : {
+      std::memcpy(&value.m_pointer, data, sizeof(value.m_pointer));
+      return data + sizeof(value.m_pointer);
+    }
+    case (LogArgumentType::STRING) : {
+      uint32_t string_length;
+      std::memcpy(&string_length, data, sizeof(string_length));
+      data += sizeof(string_length);
+      value.m_string = data;
+      value.m_length = string_length;
+      return data + string_length;
+    }
+    case (LogArgumentType::KEY) : {
+      std::memcpy(&value.m_string, data, sizeof(value.m_string));
+      value.m_length = value.m_string == nullptr ? 0 : std::strlen(value.m_string);
+      return data + sizeof(value.m_string);
+    }
+    default : {
+      throw std::invalid_argument("Invalid log argument type.");
+    }
+  }
+}
+
+void LogArguments::AppendValue(const LogArgumentValue & value, std::string & output) {
+  char buffer[32];
+  int length = 0;
+  switch (value.m_type) {
+    case (LogArgumentType::BOOL) : {
+      output.append(value.m_bool ? "true" : "false");
+      break;
+    }
+    case (LogArgumentType::CHAR) : {
+      output.push_back(value.m_char);
+      break;
+    }
+    case (LogArgumentType::INT64) : {
+      length = std::snprintf(buffer, sizeof(buffer), "%" PRId64, value.m_int64);
+      output.append(buffer, length);
+      break;
+    }
+    case (LogArgumentType::UINT64) : {
+      length = std::snprintf(buffer, sizeof(buffer), "%" PRIu64, value.m_uint64);
+      output.append(buffer, length);
+      break;
+    }
+    case (LogArgumentType::DOUBLE) : {
+      length = std::snprintf(buffer, sizeof(buffer), "%g", value.m_double);
+      output.append(buffer, length);
+      break;
+    }
+    case (LogArgumentType::POINTER) : {
+      length = std::snprintf(buffer, sizeof(buffer), "%p", value.m_pointer);
+      output.append(buffer, length);
+      break;
+    }
+    case (LogArgumentType::STRING) :
+    case (LogArgumentType::KEY) : {
+      output.append(value.m_string, value.m_length);
+      break;
+    }
+    default : {
+      throw std::invalid_argument("Invalid log argument type.");
+    }
+  }
+}
+
+const char * LogArguments::FormatArgument(const char * data, std::string & output) {
+  LogArgumentValue value;
+  data = ReadArgument(data, value);
+  AppendValue(value, output);
+  return data;
+}
+
+void LogArguments::Format(const char * format, std::string & output) const {
+  const char * data = GetData();
+  const char * data_end = data + m_size;
+  output.clear();
+  while (*format != '\0') {
+    if (format[0] == '{' && format[1] == '{') {
+      output.push_back('{');
+      format += 2;
+    } else if (format[0] == '}' && format[1] == '}') {
+      output.push_back('}');
+      format += 2;
+    } else if (format[0] == '{' && format[1] == '}') {
+      if (data < data_end) {
+        data = FormatArgument(data, output);
+      }
+      format += 2;
+    } else {
+      output.push_back(*format++);
+    }
+  }
+}
+
+}  // namespace logging
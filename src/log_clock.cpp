@@ -0,0 +1,78 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <chrono>
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+#include "logging/log_clock.h"
+
+namespace logging {
+
+namespace {
+
+// Only an invariant TSC ticks at a constant rate across frequency changes and sleep states.
+bool HasInvariantTsc() {
+#ifdef LOGGING_HAVE_RDTSC
+  unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+  if (__get_cpuid(0x80000000, &eax, &ebx, &ecx, &edx) == 0 || eax < 0x80000007) {
+    return false;
+  }
+  __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx);
+  return (edx & (1u << 8)) != 0;
+#else
+  return false;
+#endif
+}
+
+int64_t SystemNowNanos() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+}  // namespace
+
+uint64_t LogClock::SteadyNow() {
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+LogClock::LogClock() : m_use_tsc(HasInvariantTsc()), m_nanos_per_tick(1.0) {
+  m_base_unix_nanos = SystemNowNanos();
+  m_base_ticks = m_use_tsc ? 0 : SteadyNow();
+#ifdef LOGGING_HAVE_RDTSC
+  if (m_use_tsc) {
+    // Measures the TSC rate against steady_clock over a few milliseconds.
+    const uint64_t steady_begin = SteadyNow();
+    const uint64_t tsc_begin = __rdtsc();
+    uint64_t steady_end = steady_begin;
+    while (steady_end - steady_begin < 5000000) {
+      steady_end = SteadyNow();
+    }
+    const uint64_t tsc_end = __rdtsc();
+    m_nanos_per_tick = static_cast<double>(steady_end - steady_begin) / static_cast<double>(tsc_end - tsc_begin);
+    m_base_ticks = tsc_end;
+    m_base_unix_nanos = SystemNowNanos();
+  }
+#endif
+  m_ticks_per_second = 1e9 / m_nanos_per_tick;
+}
+
+}  // namespace logging
@@ -0,0 +1,152 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cstring>
+#include "logging/log_clock.h"
+#include "logging/log_deduplicator.h"
+
+namespace logging {
+
+namespace {
+
+// FNV-1a, continues from hash.
+uint64_t HashBytes(const char * data, std::size_t size, uint64_t hash) {
+  for (std::size_t i = 0; i < size; ++i) {
+    hash = (hash ^ static_cast<unsigned char>(data[i])) * 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+}  // namespace
+
+std::atomic<uint32_t> LogDeduplicator::m_num_open_streaks {0};
+std::atomic<PeriodicTask *> LogDeduplicator::m_report_task {nullptr};
+
+LogDeduplicator::~LogDeduplicator() {
+  if (m_has_repeats.load(std::memory_order_relaxed)) {
+    m_num_open_streaks.fetch_sub(1, std::memory_order_acq_rel);
+  }
+}
+
+void LogDeduplicator::SetConfig(LogLevel dedup_level, uint32_t window_ms) {
+  std::lock_guard<std::mutex> lock(m_mtx);
+  m_window_ticks = LogClock::SecondsToTicks(window_ms / 1000.0);
+  m_level_mask.store(window_ms > 0 ? LogLevelMask(dedup_level) : 0, std::memory_order_relaxed);
+}
+
+bool LogDeduplicator::CheckRepeat(const LogEvent & log_event, RepeatSummary & summary) {
+  // Deferred events are compared by format and captured arguments, so they are not formatted here.
+  const char * content = log_event.m_message.data();
+  std::size_t content_size = log_event.m_message.size();
+  if (log_event.m_format != nullptr) {
+    content = log_event.m_arguments.GetData();
+    content_size = log_event.m_arguments.GetSize();
+  }
+  uint64_t hash = HashBytes(content, content_size, 0xcbf29ce484222325ULL ^ reinterpret_cast<uintptr_t>(log_event.m_format));
+  hash = HashBytes(log_event.m_logger_name.data(), log_event.m_logger_name.size(), hash);
+  hash ^= static_cast<uint64_t>(log_event.m_log_level);
+  uint64_t now = log_event.m_timestamp != 0 ? log_event.m_timestamp : LogClock::Now();
+
+  std::lock_guard<std::mutex> lock(m_mtx);
+  // The hash only rules out most different events quickly.
+  if (m_has_last.load(std::memory_order_relaxed) && hash == m_last_hash && log_event.m_log_level == m_last_level &&
+      log_event.m_format == m_last_format && content_size == m_last_content.size() &&
+      std::memcmp(content, m_last_content.data(), content_size) == 0 && log_event.m_logger_name == m_last_logger_name) {
+    if (now < m_window_end) {
+      ++m_repeats;
+      OpenStreakLocked();
+      return false;
+    }
+    m_window_end = now + m_window_ticks;
+    if (m_repeats == 0) {
+      return true;
+    }
+    // The flood goes on: report it once per window and keep suppressing.
+    ++m_repeats;
+    TakeRepeatsLocked(summary);
+    return false;
+  }
+  TakeRepeatsLocked(summary);
+  m_has_last.store(true, std::memory_order_relaxed);
+  m_last_hash = hash;
+  m_last_level = log_event.m_log_level;
+  m_last_logger_name = log_event.m_logger_name;
+  m_last_format = log_event.m_format;
+  m_last_content.assign(content, content_size);
+  m_window_end = now + m_window_ticks;
+  return true;
+}
+
+void LogDeduplicator::EndStreak(RepeatSummary & summary) {
+  std::lock_guard<std::mutex> lock(m_mtx);
+  TakeRepeatsLocked(summary);
+  m_has_last.store(false, std::memory_order_relaxed);
+}
+
+bool LogDeduplicator::TakePendingRepeats(RepeatSummary & summary) {
+  if (!m_has_repeats.load(std::memory_order_relaxed)) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(m_mtx);
+  TakeRepeatsLocked(summary);
+  return summary.m_count > 0;
+}
+
+bool LogDeduplicator::TakeExpiredRepeats(uint64_t now, RepeatSummary & summary) {
+  if (!m_has_repeats.load(std::memory_order_relaxed)) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(m_mtx);
+  if (now < m_window_end) {
+    return false;
+  }
+  m_window_end = now + m_window_ticks;
+  TakeRepeatsLocked(summary);
+  return summary.m_count > 0;
+}
+
+void LogDeduplicator::TakeRepeatsLocked(RepeatSummary & summary) {
+  if (m_repeats == 0) {
+    return;
+  }
+  summary.m_count = m_repeats;
+  summary.m_log_level = m_last_level;
+  summary.m_logger_name = m_last_logger_name;
+  m_repeats = 0;
+  m_has_repeats.store(false, std::memory_order_relaxed);
+  m_num_open_streaks.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+void LogDeduplicator::OpenStreakLocked() {
+  if (m_has_repeats.load(std::memory_order_relaxed)) {
+    return;
+  }
+  m_has_repeats.store(true, std::memory_order_relaxed);
+  if (m_num_open_streaks.fetch_add(1, std::memory_order_acq_rel) == 0) {
+    PeriodicTask * task = m_report_task.load(std::memory_order_acquire);
+    if (task != nullptr) {
+      task->Wake();
+    }
+  }
+}
+
+}  // namespace logging
@@ -20,15 +20,50 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include <algorithm>
 #include <string>
 #include <iostream>
 #include <assert.h>
 #include "logging/log_manager.h"
 #include "logging/logger_map.h"
+#include "logging/log_deduplicator.h"
 
 namespace logging {
 
+namespace {
+
+// nullptr if a pattern is invalid.
+std::shared_ptr<const LevelOverrides> CompileLevelOverrides(const std::vector<LevelOverrideConfig> & level_override_configs) {
+  auto level_overrides = std::make_shared<LevelOverrides>();
+  for (const auto & level_override_config : level_override_configs) {
+    if (!level_overrides->Add(level_override_config.m_pattern, level_override_config.m_log_level)) {
+      std::cerr << "Invalid logger pattern " << level_override_config.m_pattern << std::endl;
+      return nullptr;
+    }
+  }
+  return level_overrides;
+}
+
+}  // namespace
+
+constexpr uint32_t LogManager::kRepeatReportIntervalMs;
+
+LogManager::LogManager() : m_logger_map() {
+  m_repeat_report_task.Start(std::chrono::milliseconds(kRepeatReportIntervalMs), [this] {
+    if (LogDeduplicator::GetNumOpenStreaks() == 0) {
+      // Woken up again by the deduplicator which opens the next streak.
+      m_repeat_report_task.Pause();
+      return;
+    }
+    m_logger_map.ReportExpiredRepeats();
+  });
+  m_repeat_report_task.Pause();
+  LogDeduplicator::SetReportTask(&m_repeat_report_task);
+}
+
 LogManager::~LogManager() {
+  LogDeduplicator::SetReportTask(nullptr);
+  m_repeat_report_task.Stop();
   try {
     Shutdown();
   }
@@ -63,54 +98,113 @@ void LogManager::WriteToDefaultAppenders(const LogEvent& log_event) {
   m_logger_map.WriteToDefaultAppenders(log_event);
 }
 
+bool LogManager::EnqueueAsync(const Logger * logger, LogEvent & log_event) {
+  return m_async_worker.Enqueue(logger, log_event);
+}
+
 void LogManager::Shutdown() {
+  m_config_file_watcher.Stop();
+  m_async_worker.Stop();
   m_logger_map.Clear();
+  std::lock_guard<std::mutex> lock(m_config_mtx);
+  m_file_default_appenders.clear();
+  m_file_loggers.clear();
+}
+
+bool LogManager::StartAsync(std::size_t queue_capacity) {
+  return m_async_worker.Start(queue_capacity);
+}
+
+void LogManager::StopAsync() {
+  m_async_worker.Stop();
+}
+
+void LogManager::Flush() {
+  m_async_worker.Flush();
+  m_logger_map.FlushAppenders();
 }
 
 void LogManager::PrintSummaryOfLogConfig() const {
   std::cout << "############ PrintSummaryOfLogConfig ##############" << std::endl;
   std::cout << "### Default Appenders ####" << std::endl;
-  AppenderList & default_appenders = m_logger_map.GetAllAppenders();
-  if (default_appenders.size() == 0) {
+  AppenderListPtr default_appenders = m_logger_map.GetAllAppenders();
+  if (default_appenders->size() == 0) {
     std::cout << "NONE" << std::endl;
   }
-  for (auto & default_appender : default_appenders) {
+  for (auto & default_appender : *default_appenders) {
     std::cout << default_appender->GetAppenderName() << " : " << AppenderTypelToString(default_appender->GetAppenderType()) << " : " << LogLevellToString(default_appender->GetAppenderLogLevel())<< std::endl;
   }
   std::cout << "### Loggers ####" << std::endl;
   LoggerList loggers = m_logger_map.GetCurrentLoggers();
   for (auto logger : loggers) {
     std::cout << "Logger: " << logger->GetName() << " : " << LogLevellToString(logger->GetLogLevel()) << std::endl;
-    AppenderList & appenders = logger->GetAllAppenders();
-    if (appenders.size() == 0) {
+    AppenderListPtr appenders = logger->GetAllAppenders();
+    if (appenders->size() == 0) {
       std::cout << "  has NO Appender" << std::endl;
     } else {
       std::cout << "  has Appenders" << std::endl;
     }
 
-    for (auto & appender : appenders) {
+    for (auto & appender : *appenders) {
       std::cout << "  " <<appender->GetAppenderName() << " : " << AppenderTypelToString(appender->GetAppenderType()) << " : " << LogLevellToString(appender->GetAppenderLogLevel()) << std::endl;
     }
   }
   std::cout << "############ PrintSummaryOfLogConfig ##############" << std::endl;
 }
 
+LogStatistics LogManager::GetStatistics() const {
+  LogStatistics statistics;
+  AppenderListPtr default_appenders = m_logger_map.GetAllAppenders();
+  for (auto & appender : *default_appenders) {
+    statistics.m_appenders.emplace_back();
+    appender->CollectStatistics(statistics.m_appenders.back());
+  }
+  LoggerList loggers = m_logger_map.GetCurrentLoggers();
+  for (auto logger : loggers) {
+    statistics.m_loggers.push_back(logger->GetStatistics());
+    AppenderListPtr appenders = logger->GetAllAppenders();
+    for (auto & appender : *appenders) {
+      statistics.m_appenders.emplace_back();
+      statistics.m_appenders.back().m_logger_name = logger->GetName();
+      appender->CollectStatistics(statistics.m_appenders.back());
+    }
+  }
+  return statistics;
+}
+
 void LogManager::InitFromLogConfigFile(const std::string& file_name) {
+  std::lock_guard<std::mutex> lock(m_config_mtx);
   if (m_logging_configurator.ReadConfigFromFile(file_name)) {
     m_logger_map.ClearDefaultAppenders();
+    m_file_default_appenders.clear();
+    m_file_loggers.clear();
 
     for (auto & default_appender_config : m_logging_configurator.m_default_appender_configs) {
       std::cout << "Adding default appender.." <<  default_appender_config->m_name << " type: " << AppenderTypelToString(default_appender_config->m_appender_type) << std::endl;
+      m_file_default_appenders.push_back(default_appender_config->m_name);
       m_logger_map.AddAppender(std::move(default_appender_config));
     }
 
+    // Before the [Logger] sections, which take precedence.
+    std::shared_ptr<const LevelOverrides> level_overrides = CompileLevelOverrides(m_logging_configurator.m_level_override_configs);
+    if (level_overrides != nullptr) {
+      m_logger_map.SetLevelOverrides(std::move(level_overrides));
+    }
+
     for (auto & logger_config : m_logging_configurator.m_logger_configs) {
       std::cout << "Adding logger.." <<  logger_config->m_name << " type: " << LogLevellToString(logger_config->m_log_level) << std::endl;
       m_logger_map.AddLogger(logger_config->m_name);
       LoggerRef logger = GetLogger(logger_config->m_name);
+      FileLoggerState & file_logger = m_file_loggers[logger_config->m_name];
+      file_logger.m_previous_level = logger.GetLogLevel();
+      file_logger.m_previous_additivity = logger.GetAdditivity();
       logger.SetLogLevelForce(logger_config->m_log_level);
+      if (logger.GetAdditivity() != logger_config->m_additivity) {
+        logger.SetAdditivity(logger_config->m_additivity);
+      }
       for (auto & appender_config : logger_config->m_appender_configs) {
         std::cout << "Adding Appender " << appender_config->m_name << " to "<<  logger_config->m_name << " type: " << LogLevellToString(appender_config->m_level) << std::endl;
+        file_logger.m_appender_names.push_back(appender_config->m_name);
         logger.AddAppender(std::move(appender_config));
       }
     }
@@ -123,6 +217,102 @@ void LogManager::InitFromLogConfigFile(const std::string& file_name) {
   // PrintSummaryOfLogConfig();
 }
 
+bool LogManager::ReloadLogConfigFile(const std::string& file_name) {
+  std::lock_guard<std::mutex> lock(m_config_mtx);
+  LoggingConfigurator configurator;
+  try {
+    if (!configurator.ReadConfigFromFile(file_name)) {
+      return false;
+    }
+  }
+  catch (const std::exception &e) {
+    std::cerr << "Config file " << file_name << " not reloaded: " << e.what() << std::endl;
+    return false;
+  }
+  std::shared_ptr<const LevelOverrides> level_overrides = CompileLevelOverrides(configurator.m_level_override_configs);
+  if (level_overrides == nullptr) {
+    return false;
+  }
+  auto contains = [](const std::vector<std::string> & names, const std::string & name) {
+    return std::find(names.begin(), names.end(), name) != names.end();
+  };
+
+  std::vector<std::string> default_appenders;
+  for (auto & appender_config : configurator.m_default_appender_configs) {
+    default_appenders.push_back(appender_config->m_name);
+    ApplyAppenderConfig(m_logger_map, std::move(appender_config));
+  }
+  for (const auto & name : m_file_default_appenders) {
+    if (!contains(default_appenders, name)) {
+      m_logger_map.RemoveAppender(name);
+    }
+  }
+
+  m_logger_map.SetLevelOverrides(std::move(level_overrides));
+
+  std::map<std::string, FileLoggerState> file_loggers;
+  for (auto & logger_config : configurator.m_logger_configs) {
+    m_logger_map.AddLogger(logger_config->m_name);
+    LoggerRef logger = GetLogger(logger_config->m_name);
+    auto previous = m_file_loggers.find(logger_config->m_name);
+    FileLoggerState & file_logger = file_loggers[logger_config->m_name];
+    file_logger.m_previous_level = previous != m_file_loggers.end() ? previous->second.m_previous_level : logger.GetLogLevel();
+    file_logger.m_previous_additivity = previous != m_file_loggers.end() ? previous->second.m_previous_additivity : logger.GetAdditivity();
+    if (logger.GetLogLevel() != logger_config->m_log_level) {
+      logger.SetLogLevelForce(logger_config->m_log_level);
+    }
+    if (logger.GetAdditivity() != logger_config->m_additivity) {
+      logger.SetAdditivity(logger_config->m_additivity);
+    }
+    for (auto & appender_config : logger_config->m_appender_configs) {
+      file_logger.m_appender_names.push_back(appender_config->m_name);
+      ApplyAppenderConfig(logger, std::move(appender_config));
+    }
+    if (previous != m_file_loggers.end()) {
+      for (const auto & name : previous->second.m_appender_names) {
+        if (!contains(file_logger.m_appender_names, name)) {
+          logger.RemoveAppender(name);
+        }
+      }
+    }
+  }
+  for (const auto & previous : m_file_loggers) {
+    if (file_loggers.count(previous.first) == 0 && IsLoggerExists(previous.first)) {
+      LoggerRef logger = GetLogger(previous.first);
+      logger.SetLogLevelForce(previous.second.m_previous_level);
+      if (logger.GetAdditivity() != previous.second.m_previous_additivity) {
+        logger.SetAdditivity(previous.second.m_previous_additivity);
+      }
+      for (const auto & name : previous.second.m_appender_names) {
+        logger.RemoveAppender(name);
+      }
+    }
+  }
+
+  m_file_default_appenders = std::move(default_appenders);
+  m_file_loggers = std::move(file_loggers);
+  // Reconfigured appenders may accept other levels now.
+  m_logger_map.UpdateLevelMasks();
+  return true;
+}
+
+void LogManager::ApplyAppenderConfig(IAppenderAddable & target, std::unique_ptr<AppenderConfig> appender_config) {
+  AppenderRawPtr appender = target.GetAppender(appender_config->m_name);
+  if (appender == nullptr) {
+    target.AddAppender(std::move(appender_config));
+  } else if (!appender->Reconfigure(*appender_config)) {
+    target.ReplaceAppender(std::move(appender_config));
+  }
+}
+
+bool LogManager::WatchLogConfigFile(const std::string& file_name) {
+  return m_config_file_watcher.Start(file_name, [this, file_name] { ReloadLogConfigFile(file_name); });
+}
+
+void LogManager::StopWatchingLogConfigFile() {
+  m_config_file_watcher.Stop();
+}
+
 bool LogManager::IsDefaultAppenderExist(const std::string & appender_name) const {
   return m_logger_map.AppenderExist(appender_name);
 }
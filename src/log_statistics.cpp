@@ -0,0 +1,186 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "logging/log_statistics.h"
+
+#include <cmath>
+#include <sstream>
+#include "logging/log_clock.h"
+
+namespace logging {
+
+constexpr std::size_t LatencyHistogram::kNumLinearBuckets;
+constexpr std::size_t LatencyHistogram::kSubBucketBits;
+constexpr std::size_t LatencyHistogram::kNumBuckets;
+constexpr uint32_t LatencyHistogram::kSampleInterval;
+
+namespace {
+
+// Prometheus le bounds of the send latency histogram, in seconds.
+constexpr double kPrometheusLatencyBounds[] = {
+  1e-7, 2.5e-7, 5e-7, 1e-6, 2.5e-6, 5e-6, 1e-5, 2.5e-5, 5e-5, 1e-4, 2.5e-4, 5e-4,
+  1e-3, 2.5e-3, 5e-3, 1e-2, 2.5e-2, 5e-2, 0.1, 0.25, 0.5, 1.0
+};
+
+uint64_t SumEvents(const std::array<uint64_t, kNumStatisticLevels> & events) {
+  uint64_t total = 0;
+  for (auto count : events) {
+    total += count;
+  }
+  return total;
+}
+
+std::string EscapeLabelValue(const std::string & value) {
+  std::string escaped;
+  escaped.reserve(value.size());
+  for (char c : value) {
+    switch (c) {
+      case '\\': escaped += "\\\\"; break;
+      case '"': escaped += "\\\""; break;
+      case '\n': escaped += "\\n"; break;
+      default: escaped += c; break;
+    }
+  }
+  return escaped;
+}
+
+std::string AppenderLabels(const AppenderStatistics & appender) {
+  return "logger=\"" + EscapeLabelValue(appender.m_logger_name) + "\",appender=\"" + EscapeLabelValue(appender.m_appender_name) + "\"";
+}
+
+void WriteMetricHeader(std::ostringstream & out, const char * name, const char * type, const char * help) {
+  out << "# HELP logging_" << name << ' ' << help << '\n';
+  out << "# TYPE logging_" << name << ' ' << type << '\n';
+}
+
+void WriteAppenderCounter(std::ostringstream & out, const LogStatistics & statistics, const char * name, const char * help,
+                          uint64_t AppenderStatistics::* counter) {
+  WriteMetricHeader(out, name, "counter", help);
+  for (const auto & appender : statistics.m_appenders) {
+    out << "logging_" << name << '{' << AppenderLabels(appender) << "} " << appender.*counter << '\n';
+  }
+}
+
+}  // namespace
+
+uint64_t LatencySnapshot::CountBelow(double nanos) const {
+  uint64_t count = 0;
+  for (const auto & bucket : m_buckets) {
+    if (bucket.first > nanos) {
+      break;
+    }
+    count += bucket.second;
+  }
+  return count;
+}
+
+double LatencySnapshot::Quantile(double q) const {
+  if (m_count == 0) {
+    return 0;
+  }
+  const double rank = std::ceil(q * static_cast<double>(m_count));
+  uint64_t count = 0;
+  for (const auto & bucket : m_buckets) {
+    count += bucket.second;
+    if (static_cast<double>(count) >= rank) {
+      return bucket.first;
+    }
+  }
+  return m_buckets.back().first;
+}
+
+double LatencyHistogram::GetBucketUpperBound(std::size_t bucket) {
+  if (bucket < kNumLinearBuckets) {
+    return static_cast<double>(bucket + 1);
+  }
+  const std::size_t exponent = ((bucket - kNumLinearBuckets) >> kSubBucketBits) + 4;
+  const std::size_t sub_bucket = (bucket - kNumLinearBuckets) & ((1 << kSubBucketBits) - 1);
+  return std::ldexp(static_cast<double>((1 << kSubBucketBits) + sub_bucket + 1), static_cast<int>(exponent - kSubBucketBits));
+}
+
+LatencySnapshot LatencyHistogram::GetSnapshot() const {
+  LatencySnapshot snapshot;
+  uint64_t sum_ticks = 0;
+  for (const auto & shard : m_shards) {
+    sum_ticks += shard.m_sum_ticks.load(std::memory_order_relaxed);
+  }
+  for (std::size_t bucket = 0; bucket < kNumBuckets; ++bucket) {
+    uint64_t count = 0;
+    for (const auto & shard : m_shards) {
+      count += shard.m_buckets[bucket].load(std::memory_order_relaxed);
+    }
+    if (count > 0) {
+      snapshot.m_buckets.emplace_back(LogClock::TicksToNanos(GetBucketUpperBound(bucket)), count);
+      snapshot.m_count += count;
+    }
+  }
+  snapshot.m_sum_nanos = LogClock::TicksToNanos(static_cast<double>(sum_ticks));
+  return snapshot;
+}
+
+uint64_t LoggerStatistics::GetEvents() const {
+  return SumEvents(m_events);
+}
+
+uint64_t AppenderStatistics::GetEvents() const {
+  return SumEvents(m_events);
+}
+
+std::string FormatPrometheusText(const LogStatistics & statistics) {
+  std::ostringstream out;
+  WriteMetricHeader(out, "logger_events_total", "counter", "Events submitted through the logger.");
+  for (const auto & logger : statistics.m_loggers) {
+    for (std::size_t level = 1; level < kNumStatisticLevels; ++level) {
+      out << "logging_logger_events_total{logger=\"" << EscapeLabelValue(logger.m_name) << "\",level=\""
+          << LogLevelToCString(static_cast<LogLevel>(level)) << "\"} " << logger.m_events[level] << '\n';
+    }
+  }
+
+  WriteMetricHeader(out, "appender_events_total", "counter", "Events written by the appender.");
+  for (const auto & appender : statistics.m_appenders) {
+    for (std::size_t level = 1; level < kNumStatisticLevels; ++level) {
+      out << "logging_appender_events_total{" << AppenderLabels(appender) << ",level=\""
+          << LogLevelToCString(static_cast<LogLevel>(level)) << "\"} " << appender.m_events[level] << '\n';
+    }
+  }
+  WriteAppenderCounter(out, statistics, "appender_bytes_written_total", "Bytes written by the appender.", &AppenderStatistics::m_bytes_written);
+  WriteAppenderCounter(out, statistics, "appender_dropped_total", "Events dropped by the appender queue.", &AppenderStatistics::m_dropped);
+  WriteAppenderCounter(out, statistics, "appender_suppressed_total", "Repeated events suppressed by deduplication.", &AppenderStatistics::m_suppressed);
+  WriteAppenderCounter(out, statistics, "appender_flushes_total", "Flushes of the appender.", &AppenderStatistics::m_flushes);
+
+  WriteMetricHeader(out, "appender_send_latency_seconds", "histogram", "Time spent in IAppender::Send.");
+  for (const auto & appender : statistics.m_appenders) {
+    const std::string labels = AppenderLabels(appender);
+    const LatencySnapshot & latency = appender.m_send_latency;
+    for (double bound : kPrometheusLatencyBounds) {
+      out << "logging_appender_send_latency_seconds_bucket{" << labels << ",le=\"" << bound << "\"} "
+          << latency.CountBelow(bound * 1e9) << '\n';
+    }
+    out << "logging_appender_send_latency_seconds_bucket{" << labels << ",le=\"+Inf\"} " << latency.m_count << '\n';
+    out << "logging_appender_send_latency_seconds_sum{" << labels << "} " << latency.m_sum_nanos * 1e-9 << '\n';
+    out << "logging_appender_send_latency_seconds_count{" << labels << "} " << latency.m_count << '\n';
+  }
+  return out.str();
+}
+
+}  // namespace logging
@@ -31,132 +31,213 @@
 
 namespace logging {
 
-Logger::Logger(const std::string &name, const LogLevel level, const bool use_default_appender)
-  : IAppenderAddable{}, m_name(name), m_level(level), m_use_default_appender(use_default_appender), m_mtx() {
+Logger::Logger(const LoggerMap & logger_map, const std::string &name, const LogLevel level, const bool use_default_appender)
+  : IAppenderAddable{}, m_level_mask(0), m_name(name), m_logger_map(&logger_map), m_level(level), m_override_level(LogLevel::NOT_SELECTED), m_effective_level(level),
+    m_use_default_appender(use_default_appender), m_additivity(true), m_inherited_appenders(std::make_shared<const AppenderList>()), m_mtx() {
+  std::lock_guard<std::mutex> lock(m_mtx);
+  UpdateLevelMaskLocked();
 }
 
 void Logger::LogFatal(const std::string &message) const {
-  if (IsFatalEnabled() && m_level != LogLevel::OFF) {
+  if (ShouldLog(LogLevel::FATAL)) {
     Write(LogLevel::FATAL, message);
   }
 }
 
 void Logger::LogError(const std::string &message) const {
-  if (IsErrorEnabled() && m_level != LogLevel::OFF) {
+  if (ShouldLog(LogLevel::ERROR)) {
     Write(LogLevel::ERROR, message);
   }
 }
 
 void Logger::LogWarn(const std::string &message) const {
-  if (IsWarnEnabled() && m_level != LogLevel::OFF) {
-  Write(LogLevel::WARN, message);
+  if (ShouldLog(LogLevel::WARN)) {
+    Write(LogLevel::WARN, message);
   }
 }
 
 void Logger::LogInfo(const std::string &message) const {
-  if (IsInfoEnabled() && m_level != LogLevel::OFF) {
+  if (ShouldLog(LogLevel::INFO)) {
     Write(LogLevel::INFO, message);
   }
 }
 
 void Logger::LogInfoRawBuffer(const std::string &message) const {
-  if (IsInfoEnabled() && m_level != LogLevel::OFF) {
-      LogEvent log_event;
-      log_event.m_log_level = LogLevel::INFO;
-      log_event.m_message = message;
-      log_event.m_logger_name = GetName();
-
-      std::lock_guard<std::mutex> lock(m_mtx);
-
-      if (m_use_default_appender) {
-        LogManager::GetInstance().WriteToDefaultAppenders(log_event);
-      }
-      if (m_appenders.size() > 0) {
-        WriteToAllAppenders(log_event);
-      }
+  if (ShouldLog(LogLevel::INFO)) {
+    Write(LogLevel::INFO, message);
   }
 }
 
 void Logger::LogDebug(const std::string &message) const {
-  if (IsDebugEnabled() && m_level != LogLevel::OFF) {
+  if (ShouldLog(LogLevel::DEBUG)) {
     Write(LogLevel::DEBUG, message);
   }
 }
 
 void Logger::LogVerbose(const std::string &message) const {
-  if (IsVerboseEnabled() && m_level != LogLevel::OFF) {
+  if (ShouldLog(LogLevel::VERBOSE)) {
     Write(LogLevel::VERBOSE, message);
   }
 }
 
-bool Logger::IsFatalEnabled() const {
-  return m_level >= LogLevel::FATAL;
+void Logger::SetLogLevel(const LogLevel log_level) {
+  {
+    std::lock_guard<std::mutex> lock(m_mtx);
+    if (GetAssignedLogLevel() != LogLevel::NOT_SELECTED) {
+      return;
+    }
+    m_level = log_level;
+    UpdateLevelMaskLocked();
+  }
+  ResolveDescendants();
+}
+
+void Logger::SetLogLevelForce(const LogLevel log_level) {
+  {
+    std::lock_guard<std::mutex> lock(m_mtx);
+    m_level = log_level;
+    UpdateLevelMaskLocked();
+  }
+  ResolveDescendants();
+}
+
+void Logger::SetOverrideLevel(const LogLevel log_level) {
+  std::lock_guard<std::mutex> lock(m_mtx);
+  m_override_level = log_level;
+  UpdateLevelMaskLocked();
 }
 
-bool Logger::IsErrorEnabled() const {
-  return m_level >= LogLevel::ERROR;
+void Logger::SetUseDefaultAppender(bool use_default_appender) {
+  std::lock_guard<std::mutex> lock(m_mtx);
+  m_use_default_appender = use_default_appender;
+  UpdateLevelMaskLocked();
 }
 
-bool Logger::IsWarnEnabled() const {
-  return m_level >= LogLevel::WARN;
+void Logger::SetAdditivity(bool additivity) {
+  m_additivity = additivity;
+  // The inherited appenders of this logger change as well.
+  m_logger_map->ResolveSubtree(*this);
 }
 
-bool Logger::IsInfoEnabled() const {
-  return m_level >= LogLevel::INFO;
+void Logger::UpdateLevelMask() {
+  {
+    std::lock_guard<std::mutex> lock(m_mtx);
+    UpdateLevelMaskLocked();
+  }
+  ResolveDescendants();
 }
 
-bool Logger::IsDebugEnabled() const {
-  return m_level >= LogLevel::DEBUG;
+void Logger::UpdateLevelMaskLocked() {
+  const LogLevel assigned_level = GetAssignedLogLevel();
+  const LogLevel effective_level = assigned_level != LogLevel::NOT_SELECTED ? assigned_level : m_inherited_level;
+  m_effective_level.store(effective_level, std::memory_order_relaxed);
+  uint32_t level_mask = LogLevelMask(effective_level);
+  uint32_t appenders_mask = 0;
+  AppenderListPtr appenders = m_effective_appenders.Load();
+  for (const auto & appender : *appenders) {
+    appenders_mask |= AppenderLevelMask(appender->GetAppenderLogLevel());
+  }
+  if (m_use_default_appender) {
+    appenders_mask |= m_logger_map->GetDefaultAppendersLevelMask();
+  }
+  m_level_mask.store(level_mask | ((level_mask & appenders_mask) << kEffectiveLevelShift), std::memory_order_relaxed);
 }
 
-bool Logger::IsVerboseEnabled() const {
-  return m_level >= LogLevel::VERBOSE;
+void Logger::PublishEffectiveAppendersLocked() {
+  AppenderListPtr own_appenders = m_appenders.Load();
+  AppenderList appenders(own_appenders->begin(), own_appenders->end());
+  appenders.insert(appenders.end(), m_inherited_appenders->begin(), m_inherited_appenders->end());
+  m_effective_appenders.Assign(std::move(appenders));
 }
 
-void Logger::Write(const LogLevel log_level, const std::string &message) const {
+void Logger::SetInherited(LogLevel inherited_level, AppenderListPtr inherited_appenders) {
+  std::lock_guard<std::mutex> lock(m_mtx);
+  m_inherited_level = inherited_level;
+  m_inherited_appenders = std::move(inherited_appenders);
+  PublishEffectiveAppendersLocked();
+  UpdateLevelMaskLocked();
+}
+
+void Logger::ResolveDescendants() {
+  m_logger_map->ResolveSubtree(*this);
+}
+
+void Logger::Write(const LogLevel log_level, const std::string &message, const SourceLocation & location) const {
   LogEvent log_event;
+  log_event.m_timestamp = LogClock::Now();
+  log_event.m_thread_id = GetCurrentThreadId();
+  log_event.m_location = location;
   log_event.m_log_level = log_level;
   log_event.m_message = message;
   log_event.m_logger_name = GetName();
+  Submit(log_event);
+}
 
-  std::lock_guard<std::mutex> lock(m_mtx);
+void Logger::Submit(LogEvent &log_event) const {
+  std::size_t level = static_cast<std::size_t>(log_event.m_log_level);
+  if (level < kNumStatisticLevels) {
+    m_event_counters.Add(level);
+  }
+  if (LogManager::GetInstance().EnqueueAsync(this, log_event)) {
+    return;
+  }
+  Dispatch(log_event);
+}
 
+// Lock free: works on snapshots of the appender lists, which also keep appenders removed
+// in the meantime alive until the event is written.
+void Logger::Dispatch(const LogEvent &log_event) const {
   if (m_use_default_appender) {
     LogManager::GetInstance().WriteToDefaultAppenders(log_event);
   }
 
-  if (m_appenders.size() > 0) {
-    WriteToAllAppenders(log_event);
+  WriteToAllAppenders(log_event);
+}
+
+LoggerStatistics Logger::GetStatistics() const {
+  LoggerStatistics statistics;
+  statistics.m_name = m_name;
+  for (std::size_t level = 1; level < kNumStatisticLevels; ++level) {
+    statistics.m_events[level] = m_event_counters.Load(level);
+  }
+  return statistics;
+}
+
+void Logger::FlushAllAppenders() {
+  AppenderListPtr appenders = m_appenders.Load();
+  for (auto & appender : *appenders) {
+    appender->Flush();
+  }
+}
+
+void Logger::ReportExpiredRepeats() {
+  AppenderListPtr appenders = m_appenders.Load();
+  for (auto & appender : *appenders) {
+    appender->ReportExpiredRepeats();
   }
 }
 
 void Logger::CloseAllAppenders() {
-  for (AppenderList::iterator it = GetAllAppenders().begin(); it != GetAllAppenders().end(); ++it) {
-    (*it)->Close();
+  AppenderListPtr appenders = m_appenders.Load();
+  for (auto & appender : *appenders) {
+    appender->Close();
   }
 }
 
 AppenderAddableError Logger::AddAppender(AppenderUnqPtr newAppender) {
-  AppenderAddableError result = AppenderAddableError::NO_ERROR;
-  std::lock_guard<std::mutex> lock(m_mtx);
   if (newAppender == nullptr) {
     return AppenderAddableError::ADDING_NULL_APPENDER;
   }
-
-  AppenderList::iterator it = std::find_if(
-    m_appenders.begin(), m_appenders.end(), [&newAppender](AppenderUnqPtr & appender) {
-    bool result = false;
-    if (appender->GetAppenderName() == newAppender->GetAppenderName()) {
-      result = true;
+  {
+    std::lock_guard<std::mutex> lock(m_mtx);
+    if (!m_appenders.Add(std::move(newAppender))) {
+      return AppenderAddableError::APPENDER_EXIST;
     }
-    return result;});
-
-    if (it == m_appenders.end()) {
-      m_appenders.push_back(std::move(newAppender));
-    } else {
-      result = AppenderAddableError::APPENDER_EXIST;
-    }
-    return result;
+    PublishEffectiveAppendersLocked();
+    UpdateLevelMaskLocked();
+  }
+  ResolveDescendants();
+  return AppenderAddableError::NO_ERROR;
 }
 
 AppenderAddableError Logger::AddAppender(std::unique_ptr<AppenderConfig> new_appender_config) {
@@ -168,6 +249,7 @@ AppenderAddableError Logger::AddAppender(std::unique_ptr<AppenderConfig> new_app
          result = AddAppender(std::move(appender));
        } else {
          GetAppender(new_appender_config->m_name)->SetAppenderConfig(std::move(new_appender_config));
+         UpdateLevelMask();
          result = AppenderAddableError::APPENDER_EXIST;
        }
     break;
@@ -179,6 +261,7 @@ AppenderAddableError Logger::AddAppender(std::unique_ptr<AppenderConfig> new_app
          result = AddAppender(std::move(appender));
        } else {
          GetAppender(new_appender_config->m_name)->SetAppenderConfig(std::move(new_appender_config));
+         UpdateLevelMask();
          result = AppenderAddableError::APPENDER_EXIST;
        }
 #endif
@@ -190,6 +273,29 @@ AppenderAddableError Logger::AddAppender(std::unique_ptr<AppenderConfig> new_app
         result = AddAppender(std::move(appender));
       } else {
         GetAppender(new_appender_config->m_name)->SetAppenderConfig(std::move(new_appender_config));
+        UpdateLevelMask();
+        result = AppenderAddableError::APPENDER_EXIST;
+      }
+    break;
+    }
+    case (AppenderType::BINARY) : {
+      if (AppenderExist(new_appender_config->m_name) == false) {
+        AppenderUnqPtr appender(AppenderFactory::CreateAppender<BinaryAppender>(std::move(new_appender_config)));
+        result = AddAppender(std::move(appender));
+      } else {
+        GetAppender(new_appender_config->m_name)->SetAppenderConfig(std::move(new_appender_config));
+        UpdateLevelMask();
+        result = AppenderAddableError::APPENDER_EXIST;
+      }
+    break;
+    }
+    case (AppenderType::TRACE) : {
+      if (AppenderExist(new_appender_config->m_name) == false) {
+        AppenderUnqPtr appender(AppenderFactory::CreateAppender<TraceAppender>(std::move(new_appender_config)));
+        result = AddAppender(std::move(appender));
+      } else {
+        GetAppender(new_appender_config->m_name)->SetAppenderConfig(std::move(new_appender_config));
+        UpdateLevelMask();
         result = AppenderAddableError::APPENDER_EXIST;
       }
     break;
@@ -210,63 +316,76 @@ AppenderAddableError Logger::AddAppender(std::unique_ptr<AppenderConfig> new_app
   return result;
 }
 
-AppenderList& Logger::GetAllAppenders()  {
-  std::lock_guard<std::mutex> lock(m_mtx);
-  return m_appenders;
+AppenderListPtr Logger::GetAllAppenders()  {
+  return m_appenders.Load();
 }
 
 
 AppenderRawPtr Logger::GetAppender(const std::string &name) const {
-  std::lock_guard<std::mutex> lock(m_mtx);
   if (name.empty()) {
     return nullptr;
   }
-
-  for (const auto & app : m_appenders) {
-    if (app->GetAppenderConfig().m_name == name) {
-      return app.get();
-    }
-  }
-  return nullptr;
+  return m_appenders.Find(name).get();
 }
 
 bool Logger::AppenderExist(const std::string &appender_name) {
-  bool result = false;
-  auto it = std::find_if(
-    m_appenders.begin(), m_appenders.end(), [&appender_name](AppenderUnqPtr & appender_) {
-    return (appender_->GetAppenderName() == appender_name);
-  });
-
-  if (it == m_appenders.end()) {
-  } else {
-    result = true;
-  }
-  return result;
+  return m_appenders.Find(appender_name) != nullptr;
 }
 
 void Logger::RemoveAllAppenders() {
-  std::lock_guard<std::mutex> lock(m_mtx);
-  for (auto & app : m_appenders) {
-    app->Close();
+  {
+    std::lock_guard<std::mutex> lock(m_mtx);
+    AppenderListPtr removed_appenders = m_appenders.Clear();
+    for (auto & app : *removed_appenders) {
+      app->Close();
+    }
+    PublishEffectiveAppendersLocked();
+    UpdateLevelMaskLocked();
   }
-  m_appenders.clear();
+  ResolveDescendants();
 }
 
 void Logger::RemoveAppender(const std::string &name) {
-  std::lock_guard<std::mutex> lock(m_mtx);
-
-  AppenderList::iterator it, itEnd = m_appenders.end();
-
-  for (it = m_appenders.begin(); it != itEnd; it++) {
-    if (name == it->get()->GetAppenderConfig().m_name) {
-      m_appenders.erase(it);
+  {
+    std::lock_guard<std::mutex> lock(m_mtx);
+    if (m_appenders.Remove(name) == nullptr) {
       return;
     }
+    PublishEffectiveAppendersLocked();
+    UpdateLevelMaskLocked();
+  }
+  ResolveDescendants();
+}
+
+AppenderAddableError Logger::ReplaceAppender(std::unique_ptr<AppenderConfig> new_appender_config) {
+  // Closed once the locks are released and no writer uses it any more.
+  AppenderSharedPtr replaced;
+  {
+    std::lock_guard<std::mutex> lock(m_mtx);
+    AppenderSharedPtr current = m_appenders.Find(new_appender_config->m_name);
+    if (current != nullptr) {
+      new_appender_config->ContinueOutputOf(current->GetAppenderConfig());
+    }
+    AppenderSharedPtr appender(AppenderFactory::CreateAppenderFromConfig(std::move(new_appender_config)));
+    if (appender == nullptr) {
+      // The current appender keeps writing.
+      return AppenderAddableError::ADDING_NULL_APPENDER;
+    }
+    replaced = m_appenders.Replace(std::move(appender));
+    PublishEffectiveAppendersLocked();
+    UpdateLevelMaskLocked();
+  }
+  // Descendants drop the replaced appender from their inherited appenders as well.
+  ResolveDescendants();
+  if (replaced != nullptr) {
+    SnapshotAppenderList::CloseWhenReleased(std::move(replaced));
   }
+  return AppenderAddableError::NO_ERROR;
 }
 
 void Logger::WriteToAllAppenders(const LogEvent &log_event) const {
-  for (auto & appender : m_appenders) {
+  AppenderListPtr appenders = m_effective_appenders.Load();
+  for (auto & appender : *appenders) {
     appender->Send(log_event);
   }
 }
@@ -29,33 +29,39 @@
 
 namespace logging {
 
-LoggerMap::LoggerMap() : m_loggers(new LoggerPtrMap()) {
+LoggerMap::LoggerMap() : m_loggers(), m_default_appenders_level_mask(0), m_level_overrides(std::make_shared<const LevelOverrides>()) {
   auto appender_config = std::make_unique<AppenderConfig>(AppenderType::CONSOLE, "DefaultConsoleAppender");
-  m_defalut_appenders.push_back(AppenderFactory::CreateAppender<ConsoleAppender>(std::move(appender_config)));
+  m_defalut_appenders.Add(AppenderFactory::CreateAppender<ConsoleAppender>(std::move(appender_config)));
+  m_default_appenders_level_mask = AppenderLevelMask(m_defalut_appenders.Load()->back()->GetAppenderLogLevel());
 }
 
 LoggerMap::~LoggerMap() {
 }
 
 bool LoggerMap::IsLoggerExists(const std::string& name) const {
-  bool result = true;
-  LoggerPtrMap::iterator it = m_loggers->find(name);
-  if (it == m_loggers->end()) {
-    result = false;
-  }
-  return result;
+  return m_loggers.Find(name) != nullptr;
 }
 
 LoggerRef LoggerMap::GetLogger(const std::string& name) const {
-  std::lock_guard<std::recursive_mutex> lock(m_rmtx);
-  LoggerPtrMap::iterator it = m_loggers->find(name);
-  if (it != m_loggers->end()) {
-    return *(it->second.get());
-  } else {
-    LogLevel logLevel(LogLevel::NOT_SELECTED);
-    m_loggers->insert(LoggerPtrMap::value_type(name, std::unique_ptr<Logger>(new Logger(name, logLevel))));
-    return GetLogger(name);
+  Logger * created = nullptr;
+  LoggerRef logger = m_loggers.FindOrInsert(name, [this, &name, &created] {
+    std::unique_ptr<Logger> logger(new Logger(*this, name, LogLevel::NOT_SELECTED));
+    ResolveInheritance(*logger);
+    created = logger.get();
+    return logger;
+  });
+  if (created != nullptr) {
+    // An ancestor or the overrides may have changed after the first resolution without seeing the new logger.
+    std::lock_guard<std::mutex> lock(m_hierarchy_mtx);
+    IndexLoggerLocked(*created);
+    // Only a level from an override can matter to existing loggers below the new one.
+    if (created->GetOverrideLogLevel() != LogLevel::NOT_SELECTED) {
+      ResolveSubtreeLocked(*created);
+    } else {
+      ResolveInheritance(*created);
+    }
   }
+  return logger;
 }
 
 AppenderAddableError LoggerMap::AddAppender(AppenderUnqPtr newAppender) {
@@ -65,18 +71,8 @@ AppenderAddableError LoggerMap::AddAppender(AppenderUnqPtr newAppender) {
     return AppenderAddableError::ADDING_NULL_APPENDER;
   }
 
-  AppenderList::iterator it = std::find_if(
-  m_defalut_appenders.begin(), m_defalut_appenders.end(), [&newAppender](AppenderUnqPtr & appender) {
-  bool result = false;
-  if (appender->GetAppenderName() == newAppender->GetAppenderName()) {
-    result = true;
-  }
-  return result;});
-
-  if (it == m_defalut_appenders.end()) {
-    m_defalut_appenders.push_back(std::move(newAppender));
-  } else {
-  result = AppenderAddableError::APPENDER_EXIST;
+  if (!m_defalut_appenders.Add(std::move(newAppender))) {
+    result = AppenderAddableError::APPENDER_EXIST;
   }
   return result;
 }
@@ -116,6 +112,26 @@ AppenderAddableError LoggerMap::AddAppender(std::unique_ptr<AppenderConfig> new_
     }
     break;
     }
+    case (AppenderType::BINARY) : {
+    if (AppenderExist(new_appender_config->m_name) == false) {
+      AppenderUnqPtr appender(AppenderFactory::CreateAppender<BinaryAppender>(std::move(new_appender_config)));
+      result = AddAppender(std::move(appender));
+    } else {
+      GetAppender(new_appender_config->m_name)->SetAppenderConfig(std::move(new_appender_config));
+      result = AppenderAddableError::APPENDER_EXIST;
+    }
+    break;
+    }
+    case (AppenderType::TRACE) : {
+    if (AppenderExist(new_appender_config->m_name) == false) {
+      AppenderUnqPtr appender(AppenderFactory::CreateAppender<TraceAppender>(std::move(new_appender_config)));
+      result = AddAppender(std::move(appender));
+    } else {
+      GetAppender(new_appender_config->m_name)->SetAppenderConfig(std::move(new_appender_config));
+      result = AppenderAddableError::APPENDER_EXIST;
+    }
+    break;
+    }
     case (AppenderType::NET) : {
     break;
     }
@@ -129,79 +145,156 @@ AppenderAddableError LoggerMap::AddAppender(std::unique_ptr<AppenderConfig> new_
     break;
     }
   }
+  UpdateLevelMasks();
   return result;
 }
 
-AppenderList& LoggerMap::GetAllAppenders() {
-  std::lock_guard<std::mutex> lock(m_mtx);
-  return m_defalut_appenders;
+AppenderListPtr LoggerMap::GetAllAppenders() {
+  return m_defalut_appenders.Load();
 }
 
 
 AppenderRawPtr LoggerMap::GetAppender(const std::string& name) const {
-  std::lock_guard<std::mutex> lock(m_mtx);
-  for (const auto & app : m_defalut_appenders) {
-    if (app->GetAppenderConfig().m_name == name) {
-      return app.get();
-    }
-  }
-  return nullptr;
+  return m_defalut_appenders.Find(name).get();
 }
 
 bool LoggerMap::AddLogger(const std::string& name, LogLevel log_level) {
-  bool result = true;
-  std::lock_guard<std::mutex> lock(m_mtx);
-  LoggerPtrMap::iterator it = m_loggers->find(name);
-  if (it != m_loggers->end()) {
+  Logger * created = nullptr;
+  m_loggers.FindOrInsert(name, [this, &name, log_level, &created] {
+    std::unique_ptr<Logger> logger(new Logger(*this, name, log_level));
+    ResolveInheritance(*logger);
+    created = logger.get();
+    return logger;
+  });
+  if (created == nullptr) {
     return false;
-  } else {
-    m_loggers->insert(LoggerPtrMap::value_type(name, std::unique_ptr<Logger>(new Logger(name, log_level))));
-    return true;
   }
+  std::lock_guard<std::mutex> lock(m_hierarchy_mtx);
+  IndexLoggerLocked(*created);
+  ResolveSubtreeLocked(*created);
+  return true;
+}
 
-  return result;
+void LoggerMap::IndexLoggerLocked(Logger & logger) const {
+  m_sorted_loggers.emplace(logger.GetName(), &logger);
+  LogLevel override_level = GetOverrideLevelLocked(logger.GetName());
+  if (override_level != LogLevel::NOT_SELECTED) {
+    logger.SetOverrideLevel(override_level);
+  }
 }
 
-bool LoggerMap::AppenderExist(const std::string & appender_name) {
-  bool result = false;
-  auto it = std::find_if(
-  m_defalut_appenders.begin(), m_defalut_appenders.end(), [&appender_name](AppenderUnqPtr & appender_) {
-    return (appender_->GetAppenderName() == appender_name);
-  });
+void LoggerMap::ResolveSubtree(Logger & logger) const {
+  std::lock_guard<std::mutex> lock(m_hierarchy_mtx);
+  ResolveSubtreeLocked(logger);
+}
 
-  if (it == m_defalut_appenders.end()) {
-  } else {
-    result = true;
+void LoggerMap::ResolveSubtreeLocked(Logger & logger) const {
+  ResolveInheritance(logger);
+  const std::string prefix = logger.GetName() + kLoggerNameSeparator;
+  for (auto it = m_sorted_loggers.lower_bound(prefix);
+       it != m_sorted_loggers.end() && it->first.compare(0, prefix.size(), prefix) == 0; ++it) {
+    ResolveInheritance(*it->second);
+  }
+}
+
+void LoggerMap::ResolveInheritance(Logger & logger) const {
+  LogLevel inherited_level = LogLevel::NOT_SELECTED;
+  AppenderList inherited_appenders;
+  bool is_additive = logger.GetAdditivity();
+  const std::string & name = logger.GetName();
+  for (auto end = name.rfind(kLoggerNameSeparator); end != std::string::npos && end > 0;
+       end = name.rfind(kLoggerNameSeparator, end - 1)) {
+    Logger * ancestor = m_loggers.Find(name.substr(0, end));
+    if (ancestor == nullptr) {
+      continue;
+    }
+    if (inherited_level == LogLevel::NOT_SELECTED) {
+      inherited_level = ancestor->GetAssignedLogLevel();
+    }
+    if (is_additive) {
+      AppenderListPtr appenders = ancestor->GetAllAppenders();
+      inherited_appenders.insert(inherited_appenders.end(), appenders->begin(), appenders->end());
+      is_additive = ancestor->GetAdditivity();
+    }
   }
+  logger.SetInherited(inherited_level, std::make_shared<const AppenderList>(std::move(inherited_appenders)));
+}
 
-  return result;
+LogLevel LoggerMap::GetOverrideLevelLocked(const std::string & name) const {
+  LogLevel log_level = LogLevel::NOT_SELECTED;
+  m_level_overrides->Match(name, log_level);
+  return log_level;
 }
 
-void LoggerMap::RemoveAllAppenders() {
-  std::lock_guard<std::mutex> lock(m_mtx);
-  for (auto & app : m_defalut_appenders) {
-    app->Close();
+void LoggerMap::SetLevelOverrides(std::shared_ptr<const LevelOverrides> level_overrides) {
+  std::lock_guard<std::mutex> lock(m_hierarchy_mtx);
+  m_level_overrides = std::move(level_overrides);
+  std::map<std::string, Logger *> changed_loggers;
+  for (auto & sorted_logger : m_sorted_loggers) {
+    Logger & logger = *sorted_logger.second;
+    LogLevel override_level = GetOverrideLevelLocked(sorted_logger.first);
+    if (override_level != logger.GetOverrideLogLevel()) {
+      logger.SetOverrideLevel(override_level);
+      changed_loggers.emplace(sorted_logger.first, &logger);
+    }
+  }
+  for (auto & changed_logger : changed_loggers) {
+    // Loggers below a changed ancestor are resolved with its subtree.
+    const std::string & name = changed_logger.first;
+    bool has_changed_ancestor = false;
+    for (auto end = name.rfind(kLoggerNameSeparator); end != std::string::npos && end > 0 && !has_changed_ancestor;
+         end = name.rfind(kLoggerNameSeparator, end - 1)) {
+      has_changed_ancestor = changed_loggers.count(name.substr(0, end)) != 0;
+    }
+    if (!has_changed_ancestor) {
+      ResolveSubtreeLocked(*changed_logger.second);
+    }
   }
-  m_defalut_appenders.clear();
 }
 
-void LoggerMap::RemoveAppender(const std::string& name) {
-  std::lock_guard<std::mutex> lock(m_mtx);
+bool LoggerMap::AppenderExist(const std::string & appender_name) {
+  return m_defalut_appenders.Find(appender_name) != nullptr;
+}
 
-  AppenderList::iterator it, itEnd = m_defalut_appenders.end();
+void LoggerMap::RemoveAllAppenders() {
+  ClearDefaultAppenders();
+}
 
-  for (it = m_defalut_appenders.begin(); it != itEnd; it++) {
-    auto appender_config = it->get()->GetAppenderConfig();
-    if (name == appender_config.m_name) {
-      m_defalut_appenders.erase(it);
-      return;
+void LoggerMap::RemoveAppender(const std::string& name) {
+  {
+    std::lock_guard<std::mutex> lock(m_mtx);
+    m_defalut_appenders.Remove(name);
+  }
+  UpdateLevelMasks();
+}
+
+AppenderAddableError LoggerMap::ReplaceAppender(std::unique_ptr<AppenderConfig> new_appender_config) {
+  // Closed once the lock is released and no writer uses it any more.
+  AppenderSharedPtr replaced;
+  {
+    std::lock_guard<std::mutex> lock(m_mtx);
+    AppenderSharedPtr current = m_defalut_appenders.Find(new_appender_config->m_name);
+    if (current != nullptr) {
+      new_appender_config->ContinueOutputOf(current->GetAppenderConfig());
+    }
+    AppenderSharedPtr appender(AppenderFactory::CreateAppenderFromConfig(std::move(new_appender_config)));
+    if (appender == nullptr) {
+      // The current appender keeps writing.
+      return AppenderAddableError::ADDING_NULL_APPENDER;
     }
+    replaced = m_defalut_appenders.Replace(std::move(appender));
   }
+  UpdateLevelMasks();
+  if (replaced != nullptr) {
+    SnapshotAppenderList::CloseWhenReleased(std::move(replaced));
+  }
+  return AppenderAddableError::NO_ERROR;
 }
 
+// Lock free, see Logger::Dispatch.
 void LoggerMap::WriteToDefaultAppenders(const LogEvent& log_event) {
-  std::lock_guard<std::mutex> lock(m_mtx);
-  for (auto & appender : m_defalut_appenders) {
+  AppenderListPtr appenders = m_defalut_appenders.Load();
+  for (auto & appender : *appenders) {
     appender->Send(log_event);
   }
 }
@@ -211,43 +304,83 @@ void LoggerMap::Clear() {
   CloseDefaultAppenders();
   CloseLoggers();
 
-  m_loggers->clear();
-  m_defalut_appenders.clear();
+  std::lock_guard<std::mutex> hierarchy_lock(m_hierarchy_mtx);
+  m_sorted_loggers.clear();
+  m_loggers.Clear();
+  m_default_appenders_level_mask = 0;
+  m_level_overrides = std::make_shared<const LevelOverrides>();
 }
 
 void LoggerMap::ClearDefaultAppenders() {
-  std::lock_guard<std::mutex> lock(m_mtx);
-  CloseDefaultAppenders();
-  m_defalut_appenders.clear();
+  {
+    std::lock_guard<std::mutex> lock(m_mtx);
+    CloseDefaultAppenders();
+  }
+  UpdateLevelMasks();
 }
 
 void LoggerMap::ClearLoggers() {
   std::lock_guard<std::mutex> lock(m_mtx);
   CloseLoggers();
-  m_loggers->clear();
+  std::lock_guard<std::mutex> hierarchy_lock(m_hierarchy_mtx);
+  m_sorted_loggers.clear();
+  m_loggers.Clear();
 }
 
 LoggerList LoggerMap::GetCurrentLoggers() const {
+  return m_loggers.GetAll();
+}
+
+void LoggerMap::UpdateLevelMasks() {
+  uint32_t level_mask = 0;
+  {
+    std::lock_guard<std::mutex> lock(m_mtx);
+    AppenderListPtr appenders = m_defalut_appenders.Load();
+    for (const auto & appender : *appenders) {
+      level_mask |= AppenderLevelMask(appender->GetAppenderLogLevel());
+    }
+    m_default_appenders_level_mask = level_mask;
+  }
+  // Nothing which is inherited changes, so only the masks are updated.
+  for (auto logger : GetCurrentLoggers()) {
+    std::lock_guard<std::mutex> lock(logger->m_mtx);
+    logger->UpdateLevelMaskLocked();
+  }
+}
+
+void LoggerMap::FlushAppenders() {
+  AppenderListPtr appenders = m_defalut_appenders.Load();
+  for (auto & appender : *appenders) {
+    appender->Flush();
+  }
+  for (auto logger : m_loggers.GetAll()) {
+    logger->FlushAllAppenders();
+  }
+}
+
+void LoggerMap::ReportExpiredRepeats() {
+  // Keeps Clear() from destroying the loggers while they are walked.
   std::lock_guard<std::mutex> lock(m_mtx);
-  LoggerList logger_list;
-  auto loggers = m_loggers.get();
-  for (auto & logger : *loggers) {
-    logger_list.push_back(logger.second.get());
+  AppenderListPtr appenders = m_defalut_appenders.Load();
+  for (auto & appender : *appenders) {
+    appender->ReportExpiredRepeats();
+  }
+  for (auto logger : m_loggers.GetAll()) {
+    logger->ReportExpiredRepeats();
   }
-  return logger_list;
 }
 
 void LoggerMap::CloseDefaultAppenders() {
-  for (auto & appender : m_defalut_appenders) {
+  AppenderListPtr removed_appenders = m_defalut_appenders.Clear();
+  for (auto & appender : *removed_appenders) {
     appender->Close();
   }
 }
 
 void LoggerMap::CloseLoggers() {
-  auto loggers = m_loggers.get();
-  for (auto & logger : *loggers) {
-    logger.second->CloseAllAppenders();
-    logger.second->RemoveAllAppenders();
+  for (auto logger : m_loggers.GetAll()) {
+    logger->CloseAllAppenders();
+    logger->RemoveAllAppenders();
   }
 }
 
@@ -0,0 +1,107 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <functional>
+#include <utility>
+#include "logging/logger_registry.h"
+#include "logging/logger.h"
+
+namespace logging {
+
+LoggerRegistry::Table::Table(std::size_t num_buckets) : m_mask(num_buckets - 1), m_buckets(new std::atomic<Node*>[num_buckets]) {
+  for (std::size_t i = 0; i < num_buckets; ++i) {
+    m_buckets[i].store(nullptr, std::memory_order_relaxed);
+  }
+}
+
+LoggerRegistry::LoggerRegistry() : m_table(nullptr), m_size(0) {
+  m_tables.emplace_back(new Table(kInitialNumBuckets));
+  m_table.store(m_tables.back().get(), std::memory_order_release);
+}
+
+LoggerRegistry::~LoggerRegistry() = default;
+
+Logger * LoggerRegistry::Find(const std::string & name) const {
+  const Table * table = m_table.load(std::memory_order_acquire);
+  const std::size_t hash = std::hash<std::string>()(name);
+  for (const Node * node = table->m_buckets[hash & table->m_mask].load(std::memory_order_acquire);
+       node != nullptr; node = node->m_next.load(std::memory_order_acquire)) {
+    if (node->m_hash == hash && node->m_name == name) {
+      return node->m_logger;
+    }
+  }
+  return nullptr;
+}
+
+std::vector<Logger*> LoggerRegistry::GetAll() const {
+  std::lock_guard<std::mutex> lock(m_mtx);
+  std::vector<Logger*> loggers;
+  loggers.reserve(m_loggers.size());
+  for (const auto & logger : m_loggers) {
+    loggers.push_back(logger.get());
+  }
+  return loggers;
+}
+
+void LoggerRegistry::Clear() {
+  std::lock_guard<std::mutex> lock(m_mtx);
+  m_tables.clear();
+  m_tables.emplace_back(new Table(kInitialNumBuckets));
+  m_table.store(m_tables.back().get(), std::memory_order_release);
+  m_size.store(0, std::memory_order_relaxed);
+  m_loggers.clear();
+}
+
+Logger * LoggerRegistry::InsertLocked(const std::string & name, std::unique_ptr<Logger> logger) {
+  Logger * result = logger.get();
+  m_loggers.push_back(std::move(logger));
+  const std::size_t size = m_size.load(std::memory_order_relaxed) + 1;
+
+  Table * table = m_table.load(std::memory_order_relaxed);
+  if (size > (table->m_mask + 1) * 3 / 4) {
+    // Build the bigger table off to the side, readers keep using the current one until it is published.
+    std::unique_ptr<Table> new_table(new Table((table->m_mask + 1) * 2));
+    for (auto & existing : m_loggers) {
+      Link(*new_table, existing->GetName(), std::hash<std::string>()(existing->GetName()), existing.get());
+    }
+    table = new_table.get();
+    m_tables.push_back(std::move(new_table));
+    m_table.store(table, std::memory_order_release);
+  } else {
+    Link(*table, name, std::hash<std::string>()(name), result);
+  }
+  m_size.store(size, std::memory_order_relaxed);
+  return result;
+}
+
+void LoggerRegistry::Link(Table & table, const std::string & name, std::size_t hash, Logger * logger) {
+  std::unique_ptr<Node> node(new Node());
+  node->m_name = name;
+  node->m_hash = hash;
+  node->m_logger = logger;
+  std::atomic<Node*> & bucket = table.m_buckets[hash & table.m_mask];
+  node->m_next.store(bucket.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  bucket.store(node.get(), std::memory_order_release);
+  table.m_nodes.push_back(std::move(node));
+}
+
+}  // namespace logging
@@ -28,12 +28,31 @@
 
 namespace logging {
 
+namespace {
+
+// Value of a "Name = value" line with only the surrounding whitespace removed.
+std::string GetRawValue(const std::string & raw_line) {
+  auto value_begin = raw_line.find('=');
+  if (value_begin == std::string::npos) {
+    return "";
+  }
+  auto first = raw_line.find_first_not_of(" \t\r", value_begin + 1);
+  if (first == std::string::npos) {
+    return "";
+  }
+  auto last = raw_line.find_last_not_of(" \t\r");
+  return raw_line.substr(first, last - first + 1);
+}
+
+}  // namespace
+
 bool LoggingConfigurator::ReadConfigFromFile(const std::string & file_name) {
   bool result = true;
   std::ifstream cFile(file_name);
   enum class Section {
     DEFAULT_APPENDER,
     LOGGER,
+    LEVEL_OVERRIDE,
     NONE
   };
 
@@ -47,8 +66,11 @@ bool LoggingConfigurator::ReadConfigFromFile(const std::string & file_name) {
     Section section_state = Section::NONE;
     SubSection sub_section_state = SubSection::NONE;
     std::unique_ptr<AppenderConfig> appender_config(nullptr);
-    std::unique_ptr<LoggerConfig> logger_config(nullptr);
+    // Owned by m_logger_configs, the appenders which follow LoggerName are added to it.
+    LoggerConfig * logger_config = nullptr;
     while (getline(cFile, line)) {
+      // Patterns keep their inner spaces.
+      std::string raw_line = line;
       line.erase(std::remove_if(line.begin(), line.end(), isspace), line.end());
       if (line[0] == '#' || line.empty()) {
         continue;
@@ -62,6 +84,9 @@ bool LoggingConfigurator::ReadConfigFromFile(const std::string & file_name) {
         } else if (section == "Logger") {
           section_state = Section::LOGGER;
           sub_section_state = SubSection::NONE;
+        } else if (section == "LevelOverride") {
+          section_state = Section::LEVEL_OVERRIDE;
+          sub_section_state = SubSection::NONE;
         } else if (section == "LoggerAppender") {
           sub_section_state = SubSection::LOGGER_APPENDER;
         } else {
@@ -75,9 +100,13 @@ bool LoggingConfigurator::ReadConfigFromFile(const std::string & file_name) {
         case(Section::DEFAULT_APPENDER): {
           if (name == "AppenderType") {
             if (value == AppenderTypelToString(AppenderType::CONSOLE)) {
-              appender_config = std::make_unique<AppenderConfig>(AppenderType::CONSOLE, "");
+              appender_config = std::make_unique<ConsoleAppenderConfig>(AppenderType::CONSOLE, "");
             } else if (value == AppenderTypelToString(AppenderType::FILE)) {
               appender_config = std::make_unique<FileAppenderConfig>(AppenderType::FILE, "");
+            } else if (value == AppenderTypelToString(AppenderType::BINARY)) {
+              appender_config = std::make_unique<FileAppenderConfig>(AppenderType::BINARY, "");
+            } else if (value == AppenderTypelToString(AppenderType::TRACE)) {
+              appender_config = std::make_unique<FileAppenderConfig>(AppenderType::TRACE, "");
             } else if (value == AppenderTypelToString(AppenderType::ARALOG)) {
               appender_config = std::make_unique<AraLogAppenderConfig>(AppenderType::ARALOG, "AraLogAppenderDefaultName", "DFT", "Default App description", "ARA_CONSOLE", "/tmp/");
             } else if (value == AppenderTypelToString(AppenderType::SYSLOG)) {
@@ -90,6 +119,20 @@ bool LoggingConfigurator::ReadConfigFromFile(const std::string & file_name) {
             appender_config->m_name = value;
           } else if (name == "LogLevel") {
             appender_config->m_level = LogLevellFromString(value);
+          } else if (name == "Pattern") {
+            appender_config->m_pattern = GetRawValue(raw_line);
+          } else if (name == "Layout") {
+            appender_config->m_layout = LayoutTypeFromString(value);
+          } else if (name == "DedupLevel") {
+            appender_config->m_dedup_level = LogLevellFromString(value);
+          } else if (name == "DedupWindowMs") {
+            appender_config->m_dedup_window_ms = std::stoul(value);
+          } else if (name == "QueueSize") {
+            appender_config->m_queue_size = std::stoul(value);
+          } else if (name == "OverflowPolicy") {
+            appender_config->m_overflow_policy = OverflowPolicyFromString(value);
+          } else if (name == "OverflowKeepLevel") {
+            appender_config->m_overflow_keep_level = LogLevellFromString(value);
           } else if (name == "CustomParameters") {
             appender_config->InitFromCustomParametersStr(value);
             if (appender_config->IsValidConfig()) {
@@ -103,7 +146,8 @@ bool LoggingConfigurator::ReadConfigFromFile(const std::string & file_name) {
         }
         case(Section::LOGGER): {
            if (name == "LoggerName") {
-             logger_config = std::make_unique<LoggerConfig>();
+             m_logger_configs.push_back(std::make_unique<LoggerConfig>());
+             logger_config = m_logger_configs.back().get();
              logger_config->m_name = value;
            } else if (name == "LogLevel" && sub_section_state == SubSection::NONE) {
              if (LogLevellFromString(value) == LogLevel::FATAL) {
@@ -124,11 +168,17 @@ bool LoggingConfigurator::ReadConfigFromFile(const std::string & file_name) {
                logger_config->m_log_level = LogLevel::NOT_SELECTED;
              } else {
              }
+           } else if (name == "Additivity" && sub_section_state == SubSection::NONE) {
+             logger_config->m_additivity = (value != "FALSE");
            } else if (name == "AppenderType") {
              if (value == AppenderTypelToString(AppenderType::CONSOLE)) {
-               appender_config = std::make_unique<AppenderConfig>(AppenderType::CONSOLE, "");
+               appender_config = std::make_unique<ConsoleAppenderConfig>(AppenderType::CONSOLE, "");
              } else if (value == AppenderTypelToString(AppenderType::FILE)) {
                appender_config = std::make_unique<FileAppenderConfig>(AppenderType::FILE, "");
+             } else if (value == AppenderTypelToString(AppenderType::BINARY)) {
+               appender_config = std::make_unique<FileAppenderConfig>(AppenderType::BINARY, "");
+             } else if (value == AppenderTypelToString(AppenderType::TRACE)) {
+               appender_config = std::make_unique<FileAppenderConfig>(AppenderType::TRACE, "");
              } else if (value == AppenderTypelToString(AppenderType::ARALOG)) {
                appender_config = std::make_unique<AraLogAppenderConfig>(AppenderType::ARALOG, "AraLogAppenderDefaultName", "DFT", "Default App description", "ARA_CONSOLE", "/tmp/");
              } else if (value == AppenderTypelToString(AppenderType::SYSLOG)) {
@@ -141,11 +191,24 @@ bool LoggingConfigurator::ReadConfigFromFile(const std::string & file_name) {
              appender_config->m_name = value;
            } else if (name == "LogLevel" && sub_section_state == SubSection::LOGGER_APPENDER) {
              appender_config->m_level = LogLevellFromString(value);
+           } else if (name == "Pattern") {
+             appender_config->m_pattern = GetRawValue(raw_line);
+           } else if (name == "Layout") {
+             appender_config->m_layout = LayoutTypeFromString(value);
+           } else if (name == "DedupLevel") {
+             appender_config->m_dedup_level = LogLevellFromString(value);
+           } else if (name == "DedupWindowMs") {
+             appender_config->m_dedup_window_ms = std::stoul(value);
+           } else if (name == "QueueSize") {
+             appender_config->m_queue_size = std::stoul(value);
+           } else if (name == "OverflowPolicy") {
+             appender_config->m_overflow_policy = OverflowPolicyFromString(value);
+           } else if (name == "OverflowKeepLevel") {
+             appender_config->m_overflow_keep_level = LogLevellFromString(value);
            } else if (name == "CustomParameters") {
              appender_config->InitFromCustomParametersStr(value);
              if (appender_config->IsValidConfig()) {
                logger_config->m_appender_configs.push_back(std::move(appender_config));
-               m_logger_configs.push_back(std::move(logger_config));
              } else {
                std::cout << "AppenderConfig invalid." << std::endl;
              }
@@ -153,6 +216,16 @@ bool LoggingConfigurator::ReadConfigFromFile(const std::string & file_name) {
            }
         break;
         }
+        case(Section::LEVEL_OVERRIDE): {
+          if (name == "LoggerPattern") {
+            m_level_override_configs.emplace_back();
+            m_level_override_configs.back().m_pattern = value;
+          } else if (name == "LogLevel" && !m_level_override_configs.empty()) {
+            m_level_override_configs.back().m_log_level = LogLevellFromString(value);
+          } else {
+          }
+        break;
+        }
         case(Section::NONE): {
         break;
         }
@@ -174,6 +247,7 @@ bool LoggingConfigurator::ReadConfigFromFile(const std::string & file_name) {
 void LoggingConfigurator::Clear() {
   m_default_appender_configs.clear();
   m_logger_configs.clear();
+  m_level_override_configs.clear();
 }
 
 }  // namespace logging
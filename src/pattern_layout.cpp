@@ -0,0 +1,179 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cstring>
+#include "logging/pattern_layout.h"
+
+namespace logging {
+
+namespace {
+
+void AppendUnsigned(uint32_t value, std::string & output) {
+  char digits[10];
+  std::size_t size = 0;
+  do {
+    digits[size++] = static_cast<char>('0' + value % 10);
+    value /= 10;
+  } while (value != 0);
+  while (size > 0) {
+    output += digits[--size];
+  }
+}
+
+// Plain value, or a quoted string if it would be ambiguous in "key=value key=value".
+void AppendFieldValue(const LogArgumentValue & value, std::string & output) {
+  bool needs_quotes = value.m_type == LogArgumentType::STRING && value.m_length == 0;
+  for (std::size_t i = 0; value.m_type == LogArgumentType::STRING && i < value.m_length && !needs_quotes; ++i) {
+    needs_quotes = value.m_string[i] == ' ' || value.m_string[i] == '"' || value.m_string[i] == '=';
+  }
+  if (!needs_quotes) {
+    LogArguments::AppendValue(value, output);
+    return;
+  }
+  output += '"';
+  for (std::size_t i = 0; i < value.m_length; ++i) {
+    if (value.m_string[i] == '"' || value.m_string[i] == '\\') {
+      output += '\\';
+    }
+    output += value.m_string[i];
+  }
+  output += '"';
+}
+
+}  // namespace
+
+constexpr const char * PatternLayout::kDefaultPattern;
+
+PatternLayout::PatternLayout() {
+  SetPattern(kDefaultPattern);
+}
+
+PatternLayout::PatternLayout(const std::string & pattern) {
+  SetPattern(pattern);
+}
+
+void PatternLayout::SetPattern(const std::string & pattern) {
+  m_pattern = pattern;
+  m_literals.clear();
+  m_tokens.clear();
+  std::size_t literal_begin = 0;
+  for (std::size_t i = 0; i < pattern.size(); ++i) {
+    if (pattern[i] != '%' || i + 1 == pattern.size()) {
+      continue;
+    }
+    TokenType type;
+    switch (pattern[i + 1]) {
+      case 'd': type = TokenType::DATE; break;
+      case 'l': type = TokenType::LEVEL; break;
+      case 'c': type = TokenType::LOGGER_NAME; break;
+      case 'm': type = TokenType::MESSAGE; break;
+      case 'n': type = TokenType::NEWLINE; break;
+      case 't': type = TokenType::THREAD_ID; break;
+      case 'F': type = TokenType::FILE; break;
+      case 'L': type = TokenType::LINE; break;
+      case 'f': type = TokenType::FUNCTION; break;
+      case 'k': type = TokenType::FIELDS; break;
+      case '%':
+        AddLiteral(pattern.data() + literal_begin, i + 1 - literal_begin);
+        literal_begin = ++i + 1;
+        continue;
+      default:
+        continue;
+    }
+    AddLiteral(pattern.data() + literal_begin, i - literal_begin);
+    AddToken(type);
+    literal_begin = ++i + 1;
+  }
+  AddLiteral(pattern.data() + literal_begin, pattern.size() - literal_begin);
+}
+
+void PatternLayout::AddLiteral(const char * data, std::size_t length) {
+  if (length == 0) {
+    return;
+  }
+  // Adjacent literals are merged into one token.
+  if (!m_tokens.empty() && m_tokens.back().m_type == TokenType::LITERAL) {
+    m_tokens.back().m_length += static_cast<uint32_t>(length);
+  } else {
+    m_tokens.push_back(Token{TokenType::LITERAL, static_cast<uint32_t>(m_literals.size()), static_cast<uint32_t>(length)});
+  }
+  m_literals.append(data, length);
+}
+
+void PatternLayout::AddToken(TokenType type) {
+  m_tokens.push_back(Token{type, 0, 0});
+}
+
+void PatternLayout::Render(const LogEvent & log_event, std::string & output) const {
+  for (const Token & token : m_tokens) {
+    switch (token.m_type) {
+      case TokenType::LITERAL:
+        output.append(m_literals, token.m_offset, token.m_length);
+        break;
+      case TokenType::DATE:
+        m_timestamp_formatter.Format(LogClock::ToUnixNanos(log_event.m_timestamp), output);
+        break;
+      case TokenType::LEVEL: {
+        const char * level = LogLevelToCString(log_event.m_log_level);
+        output.append(level, std::strlen(level));
+        break;
+      }
+      case TokenType::LOGGER_NAME:
+        output += log_event.m_logger_name;
+        break;
+      case TokenType::MESSAGE:
+        output += log_event.GetMessage();
+        break;
+      case TokenType::NEWLINE:
+        output += '\n';
+        break;
+      case TokenType::THREAD_ID:
+        AppendUnsigned(log_event.m_thread_id, output);
+        break;
+      case TokenType::FILE:
+        if (log_event.m_location.m_file != nullptr) {
+          output += log_event.m_location.m_file;
+        }
+        break;
+      case TokenType::LINE:
+        if (log_event.m_location.m_file != nullptr) {
+          AppendUnsigned(log_event.m_location.m_line, output);
+        }
+        break;
+      case TokenType::FUNCTION:
+        if (log_event.m_location.m_function != nullptr) {
+          output += log_event.m_location.m_function;
+        }
+        break;
+      case TokenType::FIELDS:
+        log_event.m_fields.ForEachField([&output](const char * key, const LogArgumentValue & value) {
+          output += ' ';
+          output += key;
+          output += '=';
+          AppendFieldValue(value, output);
+        });
+        break;
+    }
+  }
+}
+
+}  // namespace logging
@@ -0,0 +1,91 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <utility>
+#include "logging/periodic_task.h"
+
+namespace logging {
+
+PeriodicTask::~PeriodicTask() {
+  Stop();
+}
+
+bool PeriodicTask::Start(std::chrono::milliseconds interval, std::function<void()> task) {
+  if (m_thread.joinable()) {
+    return false;
+  }
+  m_interval = interval;
+  m_task = std::move(task);
+  m_stop_requested = false;
+  m_wake_requested = false;
+  m_is_paused = false;
+  m_thread = std::thread(&PeriodicTask::Run, this);
+  return true;
+}
+
+void PeriodicTask::Stop() {
+  if (!m_thread.joinable()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_mtx);
+    m_stop_requested = true;
+  }
+  m_cv.notify_one();
+  m_thread.join();
+}
+
+void PeriodicTask::Wake() {
+  {
+    std::lock_guard<std::mutex> lock(m_mtx);
+    m_wake_requested = true;
+  }
+  m_cv.notify_one();
+}
+
+void PeriodicTask::Pause() {
+  std::lock_guard<std::mutex> lock(m_mtx);
+  m_is_paused = true;
+}
+
+void PeriodicTask::Run() {
+  std::unique_lock<std::mutex> lock(m_mtx);
+  while (true) {
+    if (m_is_paused) {
+      m_cv.wait(lock, [this] { return m_stop_requested || m_wake_requested; });
+    } else {
+      m_cv.wait_for(lock, m_interval, [this] { return m_stop_requested || m_wake_requested; });
+    }
+    if (m_stop_requested) {
+      break;
+    }
+    if (m_wake_requested) {
+      m_is_paused = false;
+    }
+    m_wake_requested = false;
+    lock.unlock();
+    m_task();
+    lock.lock();
+  }
+}
+
+}  // namespace logging
@@ -0,0 +1,55 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <time.h>
+#include "logging/timestamp_formatter.h"
+
+namespace logging {
+
+constexpr std::size_t TimestampFormatter::kFormattedSize;
+
+void TimestampFormatter::Format(int64_t unix_nanos, std::string & output) {
+  int64_t second = unix_nanos / 1000000000;
+  int64_t nanos = unix_nanos % 1000000000;
+  if (nanos < 0) {
+    --second;
+    nanos += 1000000000;
+  }
+  if (second != m_cached_second) {
+    time_t raw_time = static_cast<time_t>(second);
+    struct tm time_info;
+    localtime_r(&raw_time, &time_info);
+    strftime(m_cached_prefix, sizeof(m_cached_prefix), "%Y-%m-%d %H:%M:%S", &time_info);
+    m_cached_second = second;
+  }
+  char micros[8];
+  micros[0] = '.';
+  uint32_t value = static_cast<uint32_t>(nanos / 1000);
+  for (int i = 6; i >= 1; --i) {
+    micros[i] = static_cast<char>('0' + value % 10);
+    value /= 10;
+  }
+  output.append(m_cached_prefix, 19);
+  output.append(micros, 7);
+}
+
+}  // namespace logging
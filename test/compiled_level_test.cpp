@@ -0,0 +1,75 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Built with LOGGING_COMPILED_LEVEL=LOGGING_LEVEL_WARN (see CMakeLists.txt): statements below WARN
+// must not be compiled, so their arguments are never evaluated.
+
+#include <gtest/gtest.h>
+#include <string>
+#include "logging/logger.h"
+#include "logging/log_manager.h"
+#include "logging/appender_base.h"
+
+static_assert(LOGGING_COMPILED_LEVEL == LOGGING_LEVEL_WARN, "compiled level of this test not applied");
+
+namespace {
+
+int g_evaluations = 0;
+
+std::string Evaluate(const std::string & message) {
+  ++g_evaluations;
+  return message;
+}
+
+class NullAppender : public logging::AppenderBase {
+ public:
+  NullAppender() : logging::AppenderBase(std::make_unique<logging::AppenderConfig>(logging::AppenderType::NONE, "NullAppender")) {}
+  void Close() override { m_is_closed = true; }
+
+ protected:
+  void HookedDoSend(const logging::LogEvent &) override {}
+};
+
+}  // namespace
+
+TEST(CompiledLevelTest, StatementsBelowLevelAreNotEvaluated) {
+  logging::Logger& logger (logging::LogManager::GetInstance().GetLogger("CompiledLevelLogger"));
+  logger.SetUseDefaultAppender(false);
+  logger.AddAppender(logging::AppenderUnqPtr(new NullAppender()));
+  logger.SetLogLevel(logging::LogLevel::VERBOSE);
+
+  g_evaluations = 0;
+  LOG_INFO(logger, Evaluate("info"));
+  LOG_DEBUG(logger, Evaluate("debug"));
+  LOG_VERBOSE(logger, Evaluate("verbose"));
+  LOG_INFO_FMT(logger, "{}", Evaluate("info"));
+  LOG_DEBUG_KV(logger, "debug", "key", Evaluate("value"));
+  LOG_EVERY_N(INFO, logger, 1, Evaluate("info"));
+  ASSERT_EQ(g_evaluations, 0);
+
+  LOG_WARN_FMT(logger, "{}", Evaluate("warn"));
+  LOG_ERROR_KV(logger, "error", "key", Evaluate("value"));
+  ASSERT_EQ(g_evaluations, 2);
+
+  logging::LogManager::GetInstance().Shutdown();
+  ASSERT_EQ(logging::LogManager::GetInstance().GetNumLoggers(), 0);
+}
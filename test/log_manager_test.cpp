@@ -21,8 +21,16 @@
 // SOFTWARE.
 
 #include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
 #include "logging/logger.h"
 #include "logging/log_manager.h"
+#include "logging/appender_base.h"
 
 TEST(LogManagerTest, GetLogger) {
  std::string logger_a_name("LoggerA");
@@ -159,3 +167,419 @@ TEST(LogManagerTest, InitFromLogConfigFile) {
   ASSERT_EQ(logging::LogManager::GetInstance().GetNumLoggers(), 0);
 }
 
+
+namespace {
+
+class CountingAppender : public logging::AppenderBase {
+ public:
+  explicit CountingAppender(const std::string & name)
+    : logging::AppenderBase(std::make_unique<logging::AppenderConfig>(logging::AppenderType::NONE, name)) {}
+  void Close() override { m_is_closed = true; }
+  std::size_t GetCount() const { return m_count.load(); }
+
+ protected:
+  void HookedDoSend(const logging::LogEvent &) override { m_count++; }
+
+ private:
+  std::atomic<std::size_t> m_count {0};
+};
+
+// Logs num_messages events to another logger for every event it receives.
+class ForwardingAppender : public logging::AppenderBase {
+ public:
+  ForwardingAppender(const std::string & name, logging::Logger & logger, std::size_t num_messages)
+    : logging::AppenderBase(std::make_unique<logging::AppenderConfig>(logging::AppenderType::NONE, name)),
+      m_logger(logger), m_num_messages(num_messages) {}
+  void Close() override { m_is_closed = true; }
+
+ protected:
+  void HookedDoSend(const logging::LogEvent &) override {
+    for (std::size_t i = 0; i < m_num_messages; ++i) {
+      LOG_INFO(m_logger, "Forwarded message");
+    }
+  }
+
+ private:
+  logging::Logger & m_logger;
+  std::size_t m_num_messages;
+};
+
+}  // namespace
+
+TEST(LogManagerTest, AsyncMode) {
+  const std::size_t num_threads = 4;
+  const std::size_t num_messages = 1000;
+  logging::Logger& logger (logging::LogManager::GetInstance().GetLogger("AsyncLogger"));
+  CountingAppender * appender = new CountingAppender("AsyncCountingAppender");
+  ASSERT_EQ(logger.AddAppender(logging::AppenderUnqPtr(appender)), logging::AppenderAddableError::NO_ERROR);
+
+  ASSERT_EQ(logging::LogManager::GetInstance().IsAsync(), false);
+  ASSERT_EQ(logging::LogManager::GetInstance().StartAsync(64), true);
+  ASSERT_EQ(logging::LogManager::GetInstance().StartAsync(64), false);
+  ASSERT_EQ(logging::LogManager::GetInstance().IsAsync(), true);
+
+  std::vector<std::thread> producers;
+  for (std::size_t i = 0; i < num_threads; ++i) {
+    producers.emplace_back([&logger, num_messages] {
+      for (std::size_t j = 0; j < num_messages; ++j) {
+        LOG_INFO(logger, "Async message");
+      }
+    });
+  }
+  for (auto & producer : producers) {
+    producer.join();
+  }
+  logging::LogManager::GetInstance().Flush();
+  ASSERT_EQ(appender->GetCount(), num_threads * num_messages);
+
+  LOG_INFO(logger, "Message drained at StopAsync");
+  logging::LogManager::GetInstance().StopAsync();
+  ASSERT_EQ(logging::LogManager::GetInstance().IsAsync(), false);
+  ASSERT_EQ(appender->GetCount(), num_threads * num_messages + 1);
+
+  LOG_INFO(logger, "Synchronous message");
+  ASSERT_EQ(appender->GetCount(), num_threads * num_messages + 2);
+
+  // An appender logging on the backend thread into a full queue writes its events itself.
+  logging::Logger& forwarding_logger (logging::LogManager::GetInstance().GetLogger("AsyncForwardingLogger"));
+  ASSERT_EQ(forwarding_logger.AddAppender(logging::AppenderUnqPtr(new ForwardingAppender("AsyncForwardingAppender", logger, 64))),
+            logging::AppenderAddableError::NO_ERROR);
+  ASSERT_EQ(logging::LogManager::GetInstance().StartAsync(2), true);
+  LOG_INFO(forwarding_logger, "Message to forward");
+  logging::LogManager::GetInstance().Flush();
+  logging::LogManager::GetInstance().StopAsync();
+  ASSERT_EQ(appender->GetCount(), num_threads * num_messages + 2 + 64);
+
+  logging::LogManager::GetInstance().Shutdown();
+  ASSERT_EQ(logging::LogManager::GetInstance().GetNumLoggers(), 0);
+}
+
+TEST(LogManagerTest, AppenderChangesWhileLogging) {
+  const std::size_t num_threads = 4;
+  const std::size_t num_messages = 2000;
+  logging::Logger& logger (logging::LogManager::GetInstance().GetLogger("CowLogger"));
+  CountingAppender * appender = new CountingAppender("StableCountingAppender");
+  ASSERT_EQ(logger.AddAppender(logging::AppenderUnqPtr(appender)), logging::AppenderAddableError::NO_ERROR);
+
+  std::atomic<bool> done {false};
+  std::vector<std::thread> producers;
+  for (std::size_t i = 0; i < num_threads; ++i) {
+    producers.emplace_back([&logger, num_messages] {
+      for (std::size_t j = 0; j < num_messages; ++j) {
+        LOG_INFO(logger, "Message");
+      }
+    });
+  }
+  std::thread reconfigurer([&logger, &done] {
+    while (!done) {
+      logger.AddAppender(logging::AppenderUnqPtr(new CountingAppender("TransientCountingAppender")));
+      logger.RemoveAppender("TransientCountingAppender");
+    }
+  });
+  for (auto & producer : producers) {
+    producer.join();
+  }
+  done = true;
+  reconfigurer.join();
+  ASSERT_EQ(appender->GetCount(), num_threads * num_messages);
+
+  logging::LogManager::GetInstance().Shutdown();
+  ASSERT_EQ(logging::LogManager::GetInstance().GetNumLoggers(), 0);
+}
+
+TEST(LogManagerTest, GetLoggerConcurrently) {
+  const std::size_t num_threads = 4;
+  const std::size_t num_loggers = 1000;
+  std::vector<std::vector<logging::Logger*>> seen(num_threads);
+  std::vector<std::thread> threads;
+  for (std::size_t i = 0; i < num_threads; ++i) {
+    threads.emplace_back([&seen, i, num_loggers] {
+      for (std::size_t j = 0; j < num_loggers; ++j) {
+        seen[i].push_back(&logging::LogManager::GetInstance().GetLogger("Concurrent" + std::to_string(j)));
+      }
+    });
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(logging::LogManager::GetInstance().GetNumLoggers(), num_loggers);
+  for (std::size_t i = 1; i < num_threads; ++i) {
+    ASSERT_EQ(seen[i], seen[0]);
+  }
+
+  logging::LogManager::GetInstance().Shutdown();
+  ASSERT_EQ(logging::LogManager::GetInstance().GetNumLoggers(), 0);
+}
+
+TEST(LogManagerTest, Statistics) {
+  const std::size_t num_threads = 4;
+  const std::size_t num_messages = 1000;
+  logging::Logger& logger (logging::LogManager::GetInstance().GetLogger("StatisticsLogger"));
+  CountingAppender * appender = new CountingAppender("StatisticsCountingAppender");
+  ASSERT_EQ(logger.AddAppender(logging::AppenderUnqPtr(appender)), logging::AppenderAddableError::NO_ERROR);
+  logger.SetUseDefaultAppender(false);
+
+  std::vector<std::thread> producers;
+  for (std::size_t i = 0; i < num_threads; ++i) {
+    producers.emplace_back([&logger, num_messages] {
+      for (std::size_t j = 0; j < num_messages; ++j) {
+        LOG_INFO(logger, "Message");
+      }
+    });
+  }
+  for (auto & producer : producers) {
+    producer.join();
+  }
+  for (int i = 0; i < 3; ++i) {
+    LOG_ERROR(logger, "Repeated error");
+  }
+  logging::LogManager::GetInstance().Flush();
+
+  logging::LogStatistics statistics = logging::LogManager::GetInstance().GetStatistics();
+  ASSERT_EQ(statistics.m_loggers.size(), 1);
+  ASSERT_EQ(statistics.m_loggers[0].m_name, "StatisticsLogger");
+  ASSERT_EQ(statistics.m_loggers[0].GetEvents(logging::LogLevel::INFO), num_threads * num_messages);
+  ASSERT_EQ(statistics.m_loggers[0].GetEvents(logging::LogLevel::ERROR), 3);
+  ASSERT_EQ(statistics.m_loggers[0].GetEvents(), num_threads * num_messages + 3);
+
+  // The default appenders come first.
+  ASSERT_EQ(statistics.m_appenders.size(), logging::LogManager::GetInstance().GetNumDefaultAppenders() + 1);
+  const logging::AppenderStatistics & appender_statistics = statistics.m_appenders.back();
+  ASSERT_EQ(appender_statistics.m_logger_name, "StatisticsLogger");
+  ASSERT_EQ(appender_statistics.m_appender_name, "StatisticsCountingAppender");
+  ASSERT_EQ(appender_statistics.GetEvents(logging::LogLevel::INFO), num_threads * num_messages);
+  // The repeats are only reported by the next event or flush, which the summary doesn't count as an event.
+  ASSERT_EQ(appender_statistics.GetEvents(logging::LogLevel::ERROR), 1);
+  ASSERT_EQ(appender_statistics.m_suppressed, 2);
+  ASSERT_EQ(appender_statistics.m_flushes, 1);
+  ASSERT_EQ(appender_statistics.m_dropped, 0);
+  ASSERT_GE(appender_statistics.m_send_latency.m_count, (num_threads * num_messages + 3) / logging::LatencyHistogram::kSampleInterval);
+  ASSERT_LE(appender_statistics.m_send_latency.m_count, num_threads * num_messages + 3);
+  ASSERT_GT(appender_statistics.m_send_latency.Quantile(0.99), 0);
+  ASSERT_LE(appender_statistics.m_send_latency.Quantile(0.5), appender_statistics.m_send_latency.Quantile(0.99));
+
+  std::string text = logging::FormatPrometheusText(statistics);
+  ASSERT_NE(text.find("logging_logger_events_total{logger=\"StatisticsLogger\",level=\"INFO\"} 4000\n"), std::string::npos);
+  ASSERT_NE(text.find("logging_appender_suppressed_total{logger=\"StatisticsLogger\",appender=\"StatisticsCountingAppender\"} 2\n"), std::string::npos);
+  ASSERT_NE(text.find("logging_appender_send_latency_seconds_count{logger=\"StatisticsLogger\",appender=\"StatisticsCountingAppender\"} "
+                      + std::to_string(appender_statistics.m_send_latency.m_count) + "\n"), std::string::npos);
+  ASSERT_NE(text.find("# TYPE logging_appender_send_latency_seconds histogram\n"), std::string::npos);
+
+  logging::LogManager::GetInstance().Shutdown();
+  ASSERT_EQ(logging::LogManager::GetInstance().GetNumLoggers(), 0);
+}
+
+namespace {
+
+void WriteReloadConfig(const std::string & file_name, const std::string & logger_level, const std::string & file_appender_level,
+                       const std::string & file_prefix, bool with_console_appender, const std::string & pattern = "%m%n") {
+  std::ofstream config(file_name, std::ios::trunc);
+  config << "[DefaultAppender]\nAppenderType=CONSOLE\nAppenderName=ReloadDefaultAppender\nLogLevel=FATAL\nCustomParameters=NONE\n"
+         << "[Logger]\nLoggerName=ReloadLogger\nLogLevel=" << logger_level << "\n"
+         << "[LoggerAppender]\nAppenderType=FILE\nAppenderName=ReloadFileAppender\nLogLevel=" << file_appender_level << "\n"
+         << "Pattern=" << pattern << "\n"
+         << "CustomParameters=OutPutFileDirectory:/tmp/,OutPutFileNamePrefix:" << file_prefix << ",AddTimeStampToFileName:FALSE,FileOpenMode:TRUNCATE\n";
+  if (with_console_appender) {
+    config << "[LoggerAppender]\nAppenderType=CONSOLE\nAppenderName=ReloadConsoleAppender\nLogLevel=FATAL\nCustomParameters=NONE\n";
+  }
+}
+
+}  // namespace
+
+TEST(LogManagerTest, ReloadLogConfigFile) {
+  const std::string file_name("/tmp/logging_reload_test_config.txt");
+  logging::LogManager & log_manager = logging::LogManager::GetInstance();
+  WriteReloadConfig(file_name, "INFO", "VERBOSE", "reload_test_a", true);
+  log_manager.InitFromLogConfigFile(file_name);
+  logging::Logger& logger (log_manager.GetLogger("ReloadLogger"));
+  ASSERT_EQ(logger.GetLogLevel(), logging::LogLevel::INFO);
+  ASSERT_EQ(logger.GetNumAppenders(), 2);
+
+  // Only levels changed, the appenders are kept.
+  logging::AppenderListPtr before = logger.GetAllAppenders();
+  WriteReloadConfig(file_name, "DEBUG", "ERROR", "reload_test_a", true);
+  ASSERT_TRUE(log_manager.ReloadLogConfigFile(file_name));
+  ASSERT_EQ(logger.GetLogLevel(), logging::LogLevel::DEBUG);
+  ASSERT_EQ(logger.GetAppender("ReloadFileAppender"), (*before)[0].get());
+  ASSERT_EQ(logger.GetAppender("ReloadFileAppender")->GetAppenderLogLevel(), logging::LogLevel::ERROR);
+  ASSERT_EQ(logger.GetAppender("ReloadConsoleAppender"), (*before)[1].get());
+  ASSERT_TRUE(logger.ShouldLog(logging::LogLevel::ERROR));
+
+  // Another file needs a new appender, the console appender left the file.
+  WriteReloadConfig(file_name, "DEBUG", "ERROR", "reload_test_b", false);
+  ASSERT_TRUE(log_manager.ReloadLogConfigFile(file_name));
+  ASSERT_EQ(logger.GetNumAppenders(), 1);
+  ASSERT_NE(logger.GetAppender("ReloadFileAppender"), nullptr);
+  ASSERT_NE(logger.GetAppender("ReloadFileAppender"), (*before)[0].get());
+  ASSERT_TRUE(log_manager.IsDefaultAppenderExist("ReloadDefaultAppender"));
+
+  // A new pattern for the same file replaces the appender, which continues the file instead of truncating it.
+  LOG_ERROR(logger, "before pattern change");
+  WriteReloadConfig(file_name, "DEBUG", "ERROR", "reload_test_b", false, "new %m%n");
+  ASSERT_TRUE(log_manager.ReloadLogConfigFile(file_name));
+  LOG_ERROR(logger, "after pattern change");
+  log_manager.Flush();
+  std::ifstream log_file("/tmp/reload_test_b.txt");
+  std::string content((std::istreambuf_iterator<char>(log_file)), std::istreambuf_iterator<char>());
+  ASSERT_NE(content.find("\nbefore pattern change\n"), std::string::npos);
+  ASSERT_NE(content.find("\nnew after pattern change\n"), std::string::npos);
+
+  // A file which doesn't parse leaves everything as it is.
+  WriteReloadConfig(file_name, "LOUD", "ERROR", "reload_test_b", false, "new %m%n");
+  ASSERT_FALSE(log_manager.ReloadLogConfigFile(file_name));
+  ASSERT_EQ(logger.GetLogLevel(), logging::LogLevel::DEBUG);
+
+  ASSERT_TRUE(log_manager.WatchLogConfigFile(file_name));
+  ASSERT_FALSE(log_manager.WatchLogConfigFile(file_name));
+  WriteReloadConfig(file_name, "WARN", "ERROR", "reload_test_b", false, "new %m%n");
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (logger.GetLogLevel() != logging::LogLevel::WARN && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  ASSERT_EQ(logger.GetLogLevel(), logging::LogLevel::WARN);
+  log_manager.StopWatchingLogConfigFile();
+
+  std::remove(file_name.c_str());
+  log_manager.Shutdown();
+  ASSERT_EQ(log_manager.GetNumLoggers(), 0);
+}
+
+TEST(LogManagerTest, ReloadLogConfigFileWhileLogging) {
+  const std::string file_name("/tmp/logging_reload_while_logging_config.txt");
+  const std::string log_file_name("/tmp/reload_test_c.txt");
+  logging::LogManager & log_manager = logging::LogManager::GetInstance();
+  WriteReloadConfig(file_name, "DEBUG", "ERROR", "reload_test_c", false);
+  log_manager.InitFromLogConfigFile(file_name);
+  logging::Logger& logger (log_manager.GetLogger("ReloadLogger"));
+
+  // Only the pattern changes, so every reload replaces the file appender while the threads write to it.
+  const int kNumThreads = 4;
+  const int kNumMessages = 2000;
+  std::atomic<int> num_running(kNumThreads);
+  std::vector<std::thread> threads;
+  for (int thread = 0; thread < kNumThreads; ++thread) {
+    threads.emplace_back([&logger, &num_running, thread] {
+      for (int i = 0; i < kNumMessages; ++i) {
+        LOG_ERROR(logger, "message " + std::to_string(thread) + " " + std::to_string(i));
+      }
+      --num_running;
+    });
+  }
+  int num_reloads = 0;
+  while (num_running > 0 || num_reloads < 2) {
+    WriteReloadConfig(file_name, "DEBUG", "ERROR", "reload_test_c", false, num_reloads % 2 == 0 ? "a %m%n" : "b %m%n");
+    ASSERT_TRUE(log_manager.ReloadLogConfigFile(file_name));
+    ++num_reloads;
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+  log_manager.Flush();
+
+  std::ifstream log_file(log_file_name);
+  std::vector<int> received(kNumThreads, 0);
+  std::string line;
+  while (std::getline(log_file, line)) {
+    // Each appender starts with the header line.
+    if (line.find_first_not_of('#') == std::string::npos) {
+      continue;
+    }
+    std::size_t message = line.find("message ");
+    ASSERT_NE(message, std::string::npos) << line;
+    ++received[std::stoi(line.substr(message + 8))];
+  }
+  ASSERT_EQ(received, std::vector<int>(kNumThreads, kNumMessages));
+
+  std::remove(file_name.c_str());
+  std::remove(log_file_name.c_str());
+  log_manager.Shutdown();
+  ASSERT_EQ(log_manager.GetNumLoggers(), 0);
+}
+
+TEST(LogManagerTest, LevelOverrides) {
+  logging::LevelOverrides level_overrides;
+  ASSERT_TRUE(level_overrides.Add("net.*", logging::LogLevel::DEBUG));
+  ASSERT_TRUE(level_overrides.Add("net.http.*", logging::LogLevel::INFO));
+  ASSERT_TRUE(level_overrides.Add("net.http.client", logging::LogLevel::ERROR));
+  ASSERT_TRUE(level_overrides.Add("*.db", logging::LogLevel::WARN));
+  ASSERT_TRUE(level_overrides.Add("regex:job[0-9]+", logging::LogLevel::FATAL));
+  ASSERT_FALSE(level_overrides.Add("regex:job[", logging::LogLevel::FATAL));
+  logging::LogLevel log_level = logging::LogLevel::NOT_SELECTED;
+  ASSERT_TRUE(level_overrides.Match("net.dns", log_level));
+  ASSERT_EQ(log_level, logging::LogLevel::DEBUG);
+  ASSERT_TRUE(level_overrides.Match("net.http.server", log_level));
+  ASSERT_EQ(log_level, logging::LogLevel::INFO);
+  ASSERT_TRUE(level_overrides.Match("net.http.client", log_level));
+  ASSERT_EQ(log_level, logging::LogLevel::ERROR);
+  // Prefix patterns come before the others.
+  ASSERT_TRUE(level_overrides.Match("net.db", log_level));
+  ASSERT_EQ(log_level, logging::LogLevel::DEBUG);
+  ASSERT_TRUE(level_overrides.Match("cache.db", log_level));
+  ASSERT_EQ(log_level, logging::LogLevel::WARN);
+  ASSERT_TRUE(level_overrides.Match("job42", log_level));
+  ASSERT_EQ(log_level, logging::LogLevel::FATAL);
+  ASSERT_FALSE(level_overrides.Match("job", log_level));
+  ASSERT_FALSE(level_overrides.Match("network", log_level));
+
+  const std::string file_name("/tmp/logging_level_override_test_config.txt");
+  {
+    std::ofstream config(file_name, std::ios::trunc);
+    config << "[LevelOverride]\nLoggerPattern=ovr.net.*\nLogLevel=DEBUG\n"
+           << "[LevelOverride]\nLoggerPattern=regex:ovr\\.job[0-9]+\nLogLevel=WARN\n"
+           << "[Logger]\nLoggerName=ovr.net.special\nLogLevel=FATAL\n";
+  }
+  logging::LogManager & log_manager = logging::LogManager::GetInstance();
+  logging::Logger& existing (log_manager.GetLogger("ovr.net.existing"));
+  logging::Logger& runtime (log_manager.GetLogger("ovr.net.runtime"));
+  log_manager.InitFromLogConfigFile(file_name);
+  ASSERT_EQ(existing.GetLogLevel(), logging::LogLevel::NOT_SELECTED);
+  ASSERT_EQ(existing.GetOverrideLogLevel(), logging::LogLevel::DEBUG);
+  ASSERT_EQ(existing.GetEffectiveLogLevel(), logging::LogLevel::DEBUG);
+  ASSERT_EQ(log_manager.GetLogger("ovr.net.a.b").GetEffectiveLogLevel(), logging::LogLevel::DEBUG);
+  ASSERT_EQ(log_manager.GetLogger("ovr.job7").GetEffectiveLogLevel(), logging::LogLevel::WARN);
+  ASSERT_EQ(log_manager.GetLogger("ovr.other").GetEffectiveLogLevel(), logging::LogLevel::NOT_SELECTED);
+  ASSERT_EQ(log_manager.GetLogger("ovr.net.special").GetEffectiveLogLevel(), logging::LogLevel::FATAL);
+  // Like a level from the config file, the override isn't overwritten by SetLogLevel().
+  existing.SetLogLevel(logging::LogLevel::ERROR);
+  ASSERT_EQ(existing.GetEffectiveLogLevel(), logging::LogLevel::DEBUG);
+  // An override level is inherited like a level set on the logger.
+  ASSERT_EQ(log_manager.GetLogger("ovr.job7.step").GetEffectiveLogLevel(), logging::LogLevel::WARN);
+
+  // Without the section the loggers get back their own level, a level set at runtime is kept.
+  {
+    std::ofstream config(file_name, std::ios::trunc);
+    config << "[Logger]\nLoggerName=ovr.net.special\nLogLevel=FATAL\n";
+  }
+  ASSERT_TRUE(log_manager.ReloadLogConfigFile(file_name));
+  ASSERT_EQ(existing.GetEffectiveLogLevel(), logging::LogLevel::NOT_SELECTED);
+  ASSERT_EQ(log_manager.GetLogger("ovr.job7").GetEffectiveLogLevel(), logging::LogLevel::NOT_SELECTED);
+  ASSERT_EQ(log_manager.GetLogger("ovr.job7.step").GetEffectiveLogLevel(), logging::LogLevel::NOT_SELECTED);
+  ASSERT_EQ(log_manager.GetLogger("ovr.net.special").GetEffectiveLogLevel(), logging::LogLevel::FATAL);
+  runtime.SetLogLevel(logging::LogLevel::ERROR);
+  {
+    std::ofstream config(file_name, std::ios::trunc);
+    config << "[LevelOverride]\nLoggerPattern=ovr.net.*\nLogLevel=VERBOSE\n";
+  }
+  ASSERT_TRUE(log_manager.ReloadLogConfigFile(file_name));
+  ASSERT_EQ(runtime.GetEffectiveLogLevel(), logging::LogLevel::ERROR);
+  ASSERT_EQ(existing.GetEffectiveLogLevel(), logging::LogLevel::VERBOSE);
+  ASSERT_TRUE(log_manager.ReloadLogConfigFile(file_name));
+  ASSERT_EQ(runtime.GetEffectiveLogLevel(), logging::LogLevel::ERROR);
+
+  // "ovr.a-b" sorts between "ovr.a" and its descendants.
+  logging::Logger& child (log_manager.GetLogger("ovr.a.c"));
+  logging::Logger& sibling (log_manager.GetLogger("ovr.a-b"));
+  log_manager.GetLogger("ovr.a");
+  {
+    std::ofstream config(file_name, std::ios::trunc);
+    config << "[LevelOverride]\nLoggerPattern=ovr.a\nLogLevel=DEBUG\n"
+           << "[LevelOverride]\nLoggerPattern=ovr.a-b\nLogLevel=ERROR\n";
+  }
+  ASSERT_TRUE(log_manager.ReloadLogConfigFile(file_name));
+  ASSERT_EQ(child.GetEffectiveLogLevel(), logging::LogLevel::DEBUG);
+  ASSERT_EQ(sibling.GetEffectiveLogLevel(), logging::LogLevel::ERROR);
+
+  std::remove(file_name.c_str());
+  log_manager.Shutdown();
+  ASSERT_EQ(log_manager.GetNumLoggers(), 0);
+}
@@ -21,10 +21,37 @@
 // SOFTWARE.
 
 #include <gtest/gtest.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <string>
+#include <vector>
 #include "gmock/gmock.h"
 #include "logging/logger.h"
 #include "logging/log_manager.h"
 #include "logging/appender_interface.h"
+#include "logging/appender_base.h"
+#include "logging/appender_config.h"
+#include "logging/async_appender.h"
+#include "logging/binary_log_format.h"
+#include "logging/binary_log_reader.h"
+#include "logging/default_format_policy_with_newline.h"
+#include "logging/file_compressor.h"
+#include "logging/json_escape.h"
+#include "logging/log_clock.h"
+#include "logging/log_deduplicator.h"
+#include "logging/log_trace.h"
+#include "logging/pattern_layout.h"
+#include "logging/timestamp_formatter.h"
 #include "logging/log_event.h"
 
 
@@ -113,4 +140,846 @@ TEST(LoggerTest, AddRemoveAppender) {
  logging::LogManager::GetInstance().Shutdown();
  ASSERT_EQ(logging::LogManager::GetInstance().GetNumDefaultAppenders(), 0);
  ASSERT_EQ(logging::LogManager::GetInstance().GetNumLoggers(), 0);
-}
\ No newline at end of file
+}
+namespace {
+
+class RecordingAppender : public logging::AppenderBase {
+ public:
+  explicit RecordingAppender(const std::string & name, logging::LogLevel level = logging::LogLevel::VERBOSE)
+    : logging::AppenderBase(std::make_unique<logging::AppenderConfig>(logging::AppenderType::NONE, name, level)) {}
+  void Close() override { m_is_closed = true; }
+  std::vector<std::string> GetMessages() const {
+    std::lock_guard<std::mutex> lock(m_mtx);
+    return m_messages;
+  }
+
+ protected:
+  // Also called by the LogManager thread which reports expired repeats.
+  void HookedDoSend(const logging::LogEvent & log_event) override {
+    std::lock_guard<std::mutex> lock(m_mtx);
+    m_messages.push_back(log_event.GetMessage());
+  }
+
+ private:
+  mutable std::mutex m_mtx;
+  std::vector<std::string> m_messages;
+};
+
+// Blocks in HookedDoSend until Open() is called, to fill the queue of an AsyncAppender.
+class GatedAppender : public logging::AppenderBase {
+ public:
+  explicit GatedAppender(std::unique_ptr<logging::AppenderConfig> appender_config)
+    : logging::AppenderBase(std::move(appender_config)) {}
+  void Close() override { m_is_closed = true; }
+  void WaitUntilBlocked() {
+    std::unique_lock<std::mutex> lock(m_mtx);
+    m_cv.wait(lock, [this] { return m_is_blocked; });
+  }
+  void Open() {
+    std::lock_guard<std::mutex> lock(m_mtx);
+    m_is_open = true;
+    m_cv.notify_all();
+  }
+  std::vector<std::string> GetMessages() {
+    std::lock_guard<std::mutex> lock(m_mtx);
+    return m_messages;
+  }
+
+ protected:
+  void HookedDoSend(const logging::LogEvent & log_event) override {
+    std::unique_lock<std::mutex> lock(m_mtx);
+    m_is_blocked = true;
+    m_cv.notify_all();
+    m_cv.wait(lock, [this] { return m_is_open; });
+    m_messages.push_back(log_event.GetMessage());
+  }
+
+ private:
+  std::mutex m_mtx;
+  std::condition_variable m_cv;
+  bool m_is_blocked = false;
+  bool m_is_open = false;
+  std::vector<std::string> m_messages;
+};
+
+}  // namespace
+
+TEST(LoggerTest, DeferredFormat) {
+ logging::Logger& logger (logging::LogManager::GetInstance().GetLogger("LoggerA"));
+ RecordingAppender * appender = new RecordingAppender("LoggerA_RecordingAppender");
+ ASSERT_EQ(logger.AddAppender(logging::AppenderUnqPtr(appender)), logging::AppenderAddableError::NO_ERROR);
+
+ std::string long_string(200, 'x');
+ int value = -42;
+ LOG_INFO_FMT(logger, "No arguments {{}}");
+ LOG_INFO_FMT(logger, "{} {} {} {} {} {}", value, 7u, true, 'c', 1.5, std::string("text"));
+ LOG_ERROR_FMT(logger, "[{}]", long_string);
+ LOG_WARN(logger, "Plain message");
+
+ ASSERT_EQ(appender->GetMessages().size(), 4);
+ ASSERT_EQ(appender->GetMessages()[0], "No arguments {}");
+ ASSERT_EQ(appender->GetMessages()[1], "-42 7 true c 1.5 text");
+ ASSERT_EQ(appender->GetMessages()[2], "[" + long_string + "]");
+ ASSERT_EQ(appender->GetMessages()[3], "Plain message");
+
+ logging::LogManager::GetInstance().Shutdown();
+ ASSERT_EQ(logging::LogManager::GetInstance().GetNumLoggers(), 0);
+}
+
+TEST(LoggerTest, LevelMask) {
+ logging::Logger& logger (logging::LogManager::GetInstance().GetLogger("LoggerA"));
+ ASSERT_EQ(logging::LogManager::GetInstance().GetNumDefaultAppenders(), 0);
+ ASSERT_EQ(logger.IsVerboseEnabled(), true);
+ ASSERT_EQ(logger.ShouldLog(logging::LogLevel::FATAL), false);  // Nothing would write it.
+
+ ASSERT_EQ(logger.AddAppender(logging::AppenderUnqPtr(new RecordingAppender("LoggerA_WarnAppender", logging::LogLevel::WARN))),
+           logging::AppenderAddableError::NO_ERROR);
+ ASSERT_EQ(logger.ShouldLog(logging::LogLevel::FATAL), true);
+ ASSERT_EQ(logger.ShouldLog(logging::LogLevel::WARN), true);
+ ASSERT_EQ(logger.ShouldLog(logging::LogLevel::INFO), false);
+
+ std::unique_ptr<logging::AppenderConfig> default_appender_config =
+		 std::make_unique<logging::AppenderConfig>(logging::AppenderType::CONSOLE, "DefaultConsoleAppender", logging::LogLevel::DEBUG);
+ logging::LogManager::GetInstance().AddDefaultAppender(std::move(default_appender_config));
+ ASSERT_EQ(logger.ShouldLog(logging::LogLevel::DEBUG), true);
+ ASSERT_EQ(logger.ShouldLog(logging::LogLevel::VERBOSE), false);
+ logger.SetUseDefaultAppender(false);
+ ASSERT_EQ(logger.ShouldLog(logging::LogLevel::DEBUG), false);
+ logger.SetUseDefaultAppender(true);
+
+ logger.SetLogLevel(logging::LogLevel::ERROR);
+ ASSERT_EQ(logger.IsWarnEnabled(), false);
+ ASSERT_EQ(logger.ShouldLog(logging::LogLevel::WARN), false);
+ ASSERT_EQ(logger.ShouldLog(logging::LogLevel::ERROR), true);
+
+ logging::LogManager::GetInstance().RemoveAllDefaultAppenders();
+ logger.RemoveAppender("LoggerA_WarnAppender");
+ ASSERT_EQ(logger.ShouldLog(logging::LogLevel::FATAL), false);
+
+ logging::LogManager::GetInstance().Shutdown();
+ ASSERT_EQ(logging::LogManager::GetInstance().GetNumLoggers(), 0);
+}
+
+TEST(LoggerTest, HierarchicalLevelsAndAppenders) {
+ logging::LogManager & log_manager = logging::LogManager::GetInstance();
+ logging::Logger& leaf (log_manager.GetLogger("net.http.client"));
+ ASSERT_EQ(leaf.GetEffectiveLogLevel(), logging::LogLevel::NOT_SELECTED);
+ // Sorted right before and after the descendants of "net", but not below it.
+ logging::Logger& before_net (log_manager.GetLogger("net-cache"));
+ logging::Logger& after_net (log_manager.GetLogger("network"));
+
+ // "net.http" doesn't exist, so the level comes from "net".
+ logging::Logger& root (log_manager.GetLogger("net"));
+ root.SetLogLevel(logging::LogLevel::WARN);
+ ASSERT_EQ(before_net.GetEffectiveLogLevel(), logging::LogLevel::NOT_SELECTED);
+ ASSERT_EQ(after_net.GetEffectiveLogLevel(), logging::LogLevel::NOT_SELECTED);
+ ASSERT_EQ(leaf.GetLogLevel(), logging::LogLevel::NOT_SELECTED);
+ ASSERT_EQ(leaf.GetEffectiveLogLevel(), logging::LogLevel::WARN);
+ ASSERT_EQ(leaf.IsInfoEnabled(), false);
+ ASSERT_EQ(leaf.IsWarnEnabled(), true);
+ ASSERT_EQ(log_manager.GetLogger("net.dns").GetEffectiveLogLevel(), logging::LogLevel::WARN);
+
+ RecordingAppender * root_appender = new RecordingAppender("NetAppender");
+ ASSERT_EQ(root.AddAppender(logging::AppenderUnqPtr(root_appender)), logging::AppenderAddableError::NO_ERROR);
+ logging::Logger& middle (log_manager.GetLogger("net.http"));
+ RecordingAppender * middle_appender = new RecordingAppender("HttpAppender");
+ ASSERT_EQ(middle.AddAppender(logging::AppenderUnqPtr(middle_appender)), logging::AppenderAddableError::NO_ERROR);
+ middle.SetLogLevel(logging::LogLevel::INFO);
+ ASSERT_EQ(leaf.GetEffectiveLogLevel(), logging::LogLevel::INFO);
+ ASSERT_EQ(leaf.GetEffectiveAppenders()->size(), 2);
+ LOG_INFO(leaf, "to both");
+ LOG_INFO(root, "filtered by level");
+ ASSERT_EQ(middle_appender->GetMessages(), std::vector<std::string>({"to both"}));
+ ASSERT_EQ(root_appender->GetMessages(), std::vector<std::string>({"to both"}));
+
+ // Without additivity "net.http" and everything below it stop at its own appenders.
+ middle.SetAdditivity(false);
+ LOG_INFO(leaf, "http only");
+ ASSERT_EQ(middle_appender->GetMessages(), std::vector<std::string>({"to both", "http only"}));
+ ASSERT_EQ(root_appender->GetMessages(), std::vector<std::string>({"to both"}));
+
+ leaf.SetLogLevel(logging::LogLevel::ERROR);
+ ASSERT_EQ(leaf.GetEffectiveLogLevel(), logging::LogLevel::ERROR);
+ middle.RemoveAppender("HttpAppender");
+ ASSERT_EQ(leaf.GetEffectiveAppenders()->size(), 0);
+
+ log_manager.Shutdown();
+ ASSERT_EQ(log_manager.GetNumLoggers(), 0);
+}
+
+namespace {
+
+std::string ReadFile(const std::string & file_name) {
+  std::ifstream ifs(file_name);
+  std::stringstream ss;
+  ss << ifs.rdbuf();
+  return ss.str();
+}
+
+bool FileExists(const std::string & file_name) {
+  return std::ifstream(file_name).good();
+}
+
+bool WaitForFile(const std::string & file_name) {
+  for (int i = 0; i < 200 && !FileExists(file_name); ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  return FileExists(file_name);
+}
+
+}  // namespace
+
+TEST(LoggerTest, FileAppenderFlushPolicy) {
+ logging::Logger& logger (logging::LogManager::GetInstance().GetLogger("LoggerA"));
+ std::unique_ptr<logging::FileAppenderConfig> appender_config =
+		 std::make_unique<logging::FileAppenderConfig>(logging::AppenderType::FILE, "LoggerA_FileAppender", "/tmp/", "FALSE", "logging_flush_policy_test", "TRUNCATE");
+ ASSERT_EQ(appender_config->m_buffer_size, 0);
+ appender_config->m_buffer_size = logging::FileAppenderConfig::kDefaultBufferSize;
+ appender_config->m_flush_interval_ms = 0;
+ appender_config->m_flush_level = logging::LogLevel::ERROR;
+ ASSERT_EQ(logger.AddAppender(std::move(appender_config)), logging::AppenderAddableError::NO_ERROR);
+ const std::string file_name("/tmp/logging_flush_policy_test.txt");
+
+ LOG_INFO(logger, "Buffered message");
+ ASSERT_EQ(ReadFile(file_name).find("Buffered message"), std::string::npos);
+ LOG_ERROR(logger, "Error message");
+ std::string content = ReadFile(file_name);
+ ASSERT_NE(content.find("Buffered message"), std::string::npos);
+ ASSERT_NE(content.find("Error message"), std::string::npos);
+
+ LOG_INFO(logger, "Flushed message");
+ ASSERT_EQ(ReadFile(file_name).find("Flushed message"), std::string::npos);
+ logging::LogManager::GetInstance().Flush();
+ ASSERT_NE(ReadFile(file_name).find("Flushed message"), std::string::npos);
+
+ logging::LogManager::GetInstance().Shutdown();
+ ASSERT_EQ(logging::LogManager::GetInstance().GetNumLoggers(), 0);
+}
+
+TEST(LoggerTest, FileAppenderRotation) {
+ const std::string prefix("/tmp/logging_rotation_test");
+ for (int i = 0; i < 16; ++i) {
+   std::remove((prefix + "." + std::to_string(i) + ".txt").c_str());
+ }
+ logging::Logger& logger (logging::LogManager::GetInstance().GetLogger("LoggerA"));
+ std::unique_ptr<logging::FileAppenderConfig> appender_config =
+		 std::make_unique<logging::FileAppenderConfig>(logging::AppenderType::FILE, "LoggerA_FileAppender", "/tmp/", "FALSE", "logging_rotation_test", "TRUNCATE");
+ appender_config->m_max_file_size = 256;
+ appender_config->m_max_files = 2;
+ ASSERT_EQ(logger.AddAppender(std::move(appender_config)), logging::AppenderAddableError::NO_ERROR);
+
+ for (int i = 0; i < 3; ++i) {
+   for (int j = 0; j < 10; ++j) {
+     LOG_INFO(logger, "Rotation message " + std::to_string(i));
+   }
+   ASSERT_TRUE(WaitForFile(prefix + "." + std::to_string(i) + ".txt"));
+ }
+ // Joins the rotation thread, so the last rollover and pruning are done.
+ logger.CloseAllAppenders();
+ ASSERT_NE(ReadFile(prefix + ".2.txt").find("Rotation message 2"), std::string::npos);
+ ASSERT_NE(ReadFile(prefix + ".1.txt").find("Rotation message 1"), std::string::npos);
+ ASSERT_FALSE(FileExists(prefix + ".0.txt"));
+
+ logging::LogManager::GetInstance().Shutdown();
+ ASSERT_EQ(logging::LogManager::GetInstance().GetNumLoggers(), 0);
+}
+
+TEST(LoggerTest, FileAppenderRotationOfExistingFile) {
+ const std::string prefix("/tmp/logging_rotation_append_test");
+ std::remove((prefix + ".0.txt").c_str());
+ std::remove((prefix + ".1.txt").c_str());
+ {
+   std::ofstream existing(prefix + ".txt", std::ios::trunc);
+   existing << std::string(300, 'x') << std::endl;
+ }
+ logging::Logger& logger (logging::LogManager::GetInstance().GetLogger("LoggerA"));
+ std::unique_ptr<logging::FileAppenderConfig> appender_config =
+		 std::make_unique<logging::FileAppenderConfig>(logging::AppenderType::FILE, "LoggerA_FileAppender", "/tmp/", "FALSE", "logging_rotation_append_test", "APPEND");
+ appender_config->m_max_file_size = 256;
+ ASSERT_EQ(logger.AddAppender(std::move(appender_config)), logging::AppenderAddableError::NO_ERROR);
+ // The existing content already exceeds the limit.
+ LOG_INFO(logger, "Appended message");
+ ASSERT_TRUE(WaitForFile(prefix + ".0.txt"));
+ logger.RemoveAllAppenders();
+
+ // Nothing is written, so the interval passes without an empty rotated file.
+ std::unique_ptr<logging::FileAppenderConfig> interval_config =
+		 std::make_unique<logging::FileAppenderConfig>(logging::AppenderType::FILE, "LoggerA_FileAppender", "/tmp/", "FALSE", "logging_rotation_append_test", "TRUNCATE");
+ interval_config->m_rotation_interval_sec = 1;
+ ASSERT_EQ(logger.AddAppender(std::move(interval_config)), logging::AppenderAddableError::NO_ERROR);
+ std::this_thread::sleep_for(std::chrono::milliseconds(2500));
+ logger.CloseAllAppenders();
+ ASSERT_FALSE(FileExists(prefix + ".1.txt"));
+
+ logging::LogManager::GetInstance().Shutdown();
+ ASSERT_EQ(logging::LogManager::GetInstance().GetNumLoggers(), 0);
+}
+
+TEST(LoggerTest, FileAppenderCompression) {
+ if (!logging::FileCompressor::IsSupported(logging::CompressionType::GZIP)) {
+   GTEST_SKIP();
+ }
+ const std::string prefix("/tmp/logging_compression_test");
+ for (int i = 0; i < 16; ++i) {
+   std::remove((prefix + "." + std::to_string(i) + ".txt").c_str());
+   std::remove((prefix + "." + std::to_string(i) + ".txt.gz").c_str());
+ }
+ logging::Logger& logger (logging::LogManager::GetInstance().GetLogger("LoggerA"));
+ std::unique_ptr<logging::FileAppenderConfig> appender_config =
+		 std::make_unique<logging::FileAppenderConfig>(logging::AppenderType::FILE, "LoggerA_FileAppender", "/tmp/", "FALSE", "logging_compression_test", "TRUNCATE");
+ appender_config->InitFromCustomParametersStr("MaxFileSize:256,Compression:GZIP,MaxCompressionJobs:2");
+ ASSERT_EQ(logger.AddAppender(std::move(appender_config)), logging::AppenderAddableError::NO_ERROR);
+
+ for (int j = 0; j < 10; ++j) {
+   LOG_INFO(logger, "Compressed message");
+ }
+ ASSERT_TRUE(WaitForFile(prefix + ".0.txt.gz"));
+ // Waits for pending compression jobs.
+ logger.CloseAllAppenders();
+ ASSERT_FALSE(FileExists(prefix + ".0.txt"));
+ std::string content = ReadFile(prefix + ".0.txt.gz");
+ ASSERT_GE(content.size(), 2);
+ ASSERT_EQ(static_cast<unsigned char>(content[0]), 0x1f);
+ ASSERT_EQ(static_cast<unsigned char>(content[1]), 0x8b);
+
+ logging::LogManager::GetInstance().Shutdown();
+ ASSERT_EQ(logging::LogManager::GetInstance().GetNumLoggers(), 0);
+}
+
+TEST(LoggerTest, FileAppenderCompressionMaxFiles) {
+ if (!logging::FileCompressor::IsSupported(logging::CompressionType::GZIP)) {
+   GTEST_SKIP();
+ }
+ const std::string prefix("/tmp/logging_compression_max_files_test");
+ for (int i = 0; i < 16; ++i) {
+   std::remove((prefix + "." + std::to_string(i) + ".txt").c_str());
+   std::remove((prefix + "." + std::to_string(i) + ".txt.gz").c_str());
+ }
+ logging::Logger& logger (logging::LogManager::GetInstance().GetLogger("LoggerA"));
+ std::unique_ptr<logging::FileAppenderConfig> appender_config =
+		 std::make_unique<logging::FileAppenderConfig>(logging::AppenderType::FILE, "LoggerA_FileAppender", "/tmp/", "FALSE", "logging_compression_max_files_test", "TRUNCATE");
+ appender_config->InitFromCustomParametersStr("MaxFileSize:256,Compression:GZIP,MaxCompressionJobs:2,MaxFiles:1");
+ ASSERT_EQ(logger.AddAppender(std::move(appender_config)), logging::AppenderAddableError::NO_ERROR);
+
+ // One message above MaxFileSize per round, so each round rotates exactly once.
+ const std::string message(300, 'x');
+ for (int i = 0; i < 3; ++i) {
+   LOG_INFO(logger, message);
+   ASSERT_TRUE(WaitForFile(prefix + "." + std::to_string(i) + ".txt.gz"));
+ }
+ logger.CloseAllAppenders();
+ // Older files are pruned once compressed, so neither a plain nor a compressed copy is left.
+ for (int i = 0; i < 2; ++i) {
+   ASSERT_FALSE(FileExists(prefix + "." + std::to_string(i) + ".txt"));
+   ASSERT_FALSE(FileExists(prefix + "." + std::to_string(i) + ".txt.gz"));
+ }
+ ASSERT_TRUE(FileExists(prefix + ".2.txt.gz"));
+
+ logging::LogManager::GetInstance().Shutdown();
+ ASSERT_EQ(logging::LogManager::GetInstance().GetNumLoggers(), 0);
+}
+
+TEST(LoggerTest, ConsoleAppenderDirectMode) {
+ const std::string stdout_file("/tmp/logging_console_test_stdout.txt");
+ const std::string stderr_file("/tmp/logging_console_test_stderr.txt");
+ fflush(stdout);
+ fflush(stderr);
+ int saved_stdout = dup(STDOUT_FILENO);
+ int saved_stderr = dup(STDERR_FILENO);
+ int stdout_fd = open(stdout_file.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+ int stderr_fd = open(stderr_file.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+ dup2(stdout_fd, STDOUT_FILENO);
+ dup2(stderr_fd, STDERR_FILENO);
+
+ logging::Logger& logger (logging::LogManager::GetInstance().GetLogger("LoggerA"));
+ std::unique_ptr<logging::ConsoleAppenderConfig> appender_config =
+		 std::make_unique<logging::ConsoleAppenderConfig>(logging::AppenderType::CONSOLE, "LoggerA_ConsoleAppender");
+ appender_config->InitFromCustomParametersStr("OutputMode:DIRECT,Buffering:BLOCK,FlushIntervalMs:0,ErrorsToStderr:TRUE");
+ ASSERT_EQ(logger.AddAppender(std::move(appender_config)), logging::AppenderAddableError::NO_ERROR);
+ LOG_INFO(logger, "Buffered console message");
+ std::string buffered_stdout = ReadFile(stdout_file);
+ LOG_ERROR(logger, "Console error message");
+ std::string error_stdout = ReadFile(stdout_file);
+ std::string error_stderr = ReadFile(stderr_file);
+ logging::LogManager::GetInstance().Shutdown();
+
+ dup2(saved_stdout, STDOUT_FILENO);
+ dup2(saved_stderr, STDERR_FILENO);
+ close(saved_stdout);
+ close(saved_stderr);
+ close(stdout_fd);
+ close(stderr_fd);
+
+ ASSERT_EQ(buffered_stdout.find("Buffered console message"), std::string::npos);
+ ASSERT_NE(error_stdout.find("Buffered console message"), std::string::npos);
+ ASSERT_EQ(error_stdout.find("Console error message"), std::string::npos);
+ ASSERT_NE(error_stderr.find("Console error message"), std::string::npos);
+ ASSERT_EQ(logging::LogManager::GetInstance().GetNumLoggers(), 0);
+}
+
+TEST(LoggerTest, PatternLayout) {
+ logging::LogEvent log_event;
+ log_event.m_log_level = logging::LogLevel::WARN;
+ log_event.m_logger_name = "LoggerA";
+ log_event.m_message = "Some message";
+ std::string output;
+
+ logging::PatternLayout default_layout;
+ default_layout.Render(log_event, output);
+ ASSERT_EQ(output.substr(logging::TimestampFormatter::kFormattedSize), " [WARN][LoggerA] Some message\n");
+
+ output.clear();
+ logging::PatternLayout layout("%c: %m (100%%, %x)%");
+ layout.Render(log_event, output);
+ ASSERT_EQ(output, "LoggerA: Some message (100%, %x)%");
+
+ logging::Logger& logger (logging::LogManager::GetInstance().GetLogger("LoggerA"));
+ std::unique_ptr<logging::FileAppenderConfig> appender_config =
+		 std::make_unique<logging::FileAppenderConfig>(logging::AppenderType::FILE, "LoggerA_FileAppender", "/tmp/", "FALSE", "logging_pattern_test", "TRUNCATE");
+ appender_config->m_pattern = "%l|%c|%m%n";
+ ASSERT_EQ(logger.AddAppender(std::move(appender_config)), logging::AppenderAddableError::NO_ERROR);
+ LOG_INFO(logger, "Pattern message");
+ logging::LogManager::GetInstance().Flush();
+ ASSERT_NE(ReadFile("/tmp/logging_pattern_test.txt").find("INFO|LoggerA|Pattern message\n"), std::string::npos);
+
+ logging::LogManager::GetInstance().Shutdown();
+ ASSERT_EQ(logging::LogManager::GetInstance().GetNumLoggers(), 0);
+}
+
+TEST(LoggerTest, Timestamp) {
+ int64_t system_now = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+ int64_t log_clock_now = logging::LogClock::ToUnixNanos(logging::LogClock::Now());
+ ASSERT_LT(std::abs(log_clock_now - system_now), 1000000000);
+
+ logging::TimestampFormatter formatter;
+ std::string first;
+ formatter.Format(1600000000123456789, first);
+ ASSERT_EQ(first.size(), logging::TimestampFormatter::kFormattedSize);
+ ASSERT_EQ(first.substr(19), ".123456");
+ std::string second;
+ formatter.Format(1600000000987654321, second);
+ ASSERT_EQ(second.substr(0, 19), first.substr(0, 19));
+ ASSERT_EQ(second.substr(19), ".987654");
+ std::string next_second;
+ formatter.Format(1600000001000000000, next_second);
+ ASSERT_NE(next_second.substr(0, 19), first.substr(0, 19));
+ ASSERT_EQ(next_second.substr(19), ".000000");
+}
+
+TEST(LoggerTest, SourceLocationAndThreadId) {
+ uint32_t main_thread_id = logging::GetCurrentThreadId();
+ uint32_t other_thread_id = 0;
+ std::thread([&other_thread_id] { other_thread_id = logging::GetCurrentThreadId(); }).join();
+ ASSERT_NE(main_thread_id, 0);
+ ASSERT_NE(other_thread_id, 0);
+ ASSERT_NE(main_thread_id, other_thread_id);
+ ASSERT_EQ(logging::GetCurrentThreadId(), main_thread_id);
+
+ logging::Logger& logger (logging::LogManager::GetInstance().GetLogger("LoggerA"));
+ std::unique_ptr<logging::FileAppenderConfig> appender_config =
+		 std::make_unique<logging::FileAppenderConfig>(logging::AppenderType::FILE, "LoggerA_FileAppender", "/tmp/", "FALSE", "logging_location_test", "TRUNCATE");
+ appender_config->m_pattern = "%t|%F|%L|%f|%m%n";
+ ASSERT_EQ(logger.AddAppender(std::move(appender_config)), logging::AppenderAddableError::NO_ERROR);
+ const int line = __LINE__ + 1;
+ LOG_INFO(logger, "Located message");
+ logger.LogInfo("Unlocated message");
+ logging::LogManager::GetInstance().Flush();
+ std::string content = ReadFile("/tmp/logging_location_test.txt");
+ std::string expected = std::to_string(main_thread_id) + "|" + __FILE__ + "|" + std::to_string(line) + "|TestBody|Located message\n";
+ ASSERT_NE(content.find(expected), std::string::npos);
+ ASSERT_NE(content.find(std::to_string(main_thread_id) + "||||Unlocated message\n"), std::string::npos);
+
+ logging::LogManager::GetInstance().Shutdown();
+ ASSERT_EQ(logging::LogManager::GetInstance().GetNumLoggers(), 0);
+}
+
+TEST(LoggerTest, StructuredFields) {
+ logging::LogEvent log_event;
+ log_event.m_fields.AddFields("user_id", 42, "latency_us", 12.5, "user", std::string("some user"), "ok", true);
+ ASSERT_LE(log_event.m_fields.GetSize(), logging::LogArguments::kInlineCapacity);
+ std::vector<std::string> keys;
+ std::vector<logging::LogArgumentType> types;
+ log_event.m_fields.ForEachField([&keys, &types](const char * key, const logging::LogArgumentValue & value) {
+   keys.push_back(key);
+   types.push_back(value.m_type);
+ });
+ ASSERT_EQ(keys, std::vector<std::string>({"user_id", "latency_us", "user", "ok"}));
+ ASSERT_EQ(types, std::vector<logging::LogArgumentType>({logging::LogArgumentType::INT64, logging::LogArgumentType::DOUBLE,
+                                                        logging::LogArgumentType::STRING, logging::LogArgumentType::BOOL}));
+
+ logging::Logger& logger (logging::LogManager::GetInstance().GetLogger("LoggerA"));
+ std::unique_ptr<logging::FileAppenderConfig> appender_config =
+		 std::make_unique<logging::FileAppenderConfig>(logging::AppenderType::FILE, "LoggerA_FileAppender", "/tmp/", "FALSE", "logging_fields_test", "TRUNCATE");
+ appender_config->m_pattern = "%m%k%n";
+ ASSERT_EQ(logger.AddAppender(std::move(appender_config)), logging::AppenderAddableError::NO_ERROR);
+ int64_t user_id = 42;
+ LOG_INFO_KV(logger, "Request done", "user_id", user_id, "user", "some user", "latency_us", 12.5);
+ logging::LogManager::GetInstance().Flush();
+ ASSERT_NE(ReadFile("/tmp/logging_fields_test.txt").find("Request done user_id=42 user=\"some user\" latency_us=12.5\n"), std::string::npos);
+
+ logging::LogManager::GetInstance().Shutdown();
+ ASSERT_EQ(logging::LogManager::GetInstance().GetNumLoggers(), 0);
+}
+
+TEST(LoggerTest, JsonLayout) {
+ std::vector<std::string> inputs = {"", "plain ascii message", std::string(100, 'a') + "\"quoted\"" + std::string(40, 'b'),
+                                    "tab\tnew line\ncarriage\rback\\slash", std::string("nul\0byte", 8), "\x01\x1f\x7f",
+                                    "utf-8 \xc3\xa9\xe2\x82\xac" + std::string(33, 'c') + "\n"};
+ for (const std::string & input : inputs) {
+   std::string simd;
+   std::string scalar;
+   logging::AppendJsonEscaped(input.data(), input.size(), simd);
+   logging::AppendJsonEscapedScalar(input.data(), input.size(), scalar);
+   ASSERT_EQ(simd, scalar);
+ }
+ std::string escaped;
+ logging::AppendJsonEscaped(inputs[3].data(), inputs[3].size(), escaped);
+ ASSERT_EQ(escaped, "tab\\tnew line\\ncarriage\\rback\\\\slash");
+ escaped.clear();
+ logging::AppendJsonEscaped(inputs[5].data(), inputs[5].size(), escaped);
+ ASSERT_EQ(escaped, "\\u0001\\u001f\x7f");
+
+ logging::Logger& logger (logging::LogManager::GetInstance().GetLogger("LoggerA"));
+ std::unique_ptr<logging::FileAppenderConfig> appender_config =
+		 std::make_unique<logging::FileAppenderConfig>(logging::AppenderType::FILE, "LoggerA_FileAppender", "/tmp/", "FALSE", "logging_json_test", "TRUNCATE");
+ appender_config->m_layout = logging::LayoutType::JSON;
+ ASSERT_EQ(logger.AddAppender(std::move(appender_config)), logging::AppenderAddableError::NO_ERROR);
+ LOG_INFO_KV(logger, "Say \"hi\"", "user", "some user", "ok", true);
+ logging::LogManager::GetInstance().Flush();
+ std::string content = ReadFile("/tmp/logging_json_test.txt");
+ ASSERT_EQ(content.find("####"), std::string::npos);
+ ASSERT_EQ(content.compare(0, 9, "{\"time\":\""), 0);
+ ASSERT_NE(content.find("\"level\":\"INFO\",\"logger\":\"LoggerA\""), std::string::npos);
+ ASSERT_NE(content.find("\"message\":\"Say \\\"hi\\\"\""), std::string::npos);
+ ASSERT_NE(content.find("\"fields\":{\"user\":\"some user\",\"ok\":true}}\n"), std::string::npos);
+
+ logging::LogManager::GetInstance().Shutdown();
+ ASSERT_EQ(logging::LogManager::GetInstance().GetNumLoggers(), 0);
+}
+
+TEST(LoggerTest, BinaryAppender) {
+ logging::Logger& logger (logging::LogManager::GetInstance().GetLogger("LoggerA"));
+ std::unique_ptr<logging::FileAppenderConfig> appender_config =
+		 std::make_unique<logging::FileAppenderConfig>(logging::AppenderType::BINARY, "LoggerA_BinaryAppender", "/tmp/", "FALSE", "logging_binary_test", "TRUNCATE");
+ ASSERT_EQ(logger.AddAppender(std::move(appender_config)), logging::AppenderAddableError::NO_ERROR);
+ int64_t request_id = -123456;
+ LOG_INFO(logger, "Plain message");
+ LOG_WARN_FMT(logger, "request {} from {} took {} us ({}, {})", request_id, std::string("some_user"), 42u, 0.5, 'x');
+ LOG_ERROR_KV(logger, "Request failed", "user", "some user", "ok", false);
+ LOG_WARN_FMT(logger, "request {} from {} took {} us ({}, {})", request_id + 1, "other_user", 43u, true, -1);
+ LOG_INFO(logger, std::string(300, 'a'));
+ LOG_INFO(logger, "Plain message");
+ logging::LogManager::GetInstance().Flush();
+
+ std::ifstream input("/tmp/logging_binary_test.bin", std::ifstream::binary);
+ logging::BinaryLogReader reader(input);
+ ASSERT_TRUE(reader.ReadHeader());
+ ASSERT_NE(reader.GetMetadata().find("appender=LoggerA_BinaryAppender\n"), std::string::npos);
+ logging::DefaultFormatPolicyWithNewLine format_policy;
+ std::vector<std::string> lines;
+ std::vector<uint32_t> thread_ids;
+ std::vector<std::size_t> field_counts;
+ logging::LogEvent log_event;
+ int64_t unix_nanos = 0;
+ int64_t previous_unix_nanos = reader.GetStartTime();
+ while (reader.ReadEvent(log_event, unix_nanos)) {
+   lines.push_back(format_policy.FormatMessage(log_event));
+   thread_ids.push_back(log_event.m_thread_id);
+   field_counts.push_back(log_event.m_fields.GetCount());
+   ASSERT_GE(unix_nanos, previous_unix_nanos);
+   previous_unix_nanos = unix_nanos;
+ }
+ ASSERT_TRUE(reader.IsAtEnd());
+ ASSERT_EQ(lines, std::vector<std::string>({"[INFO][LoggerA] Plain message\n",
+                                            "[WARN][LoggerA] request -123456 from some_user took 42 us (0.5, x)\n",
+                                            "[ERROR][LoggerA] Request failed\n",
+                                            "[WARN][LoggerA] request -123455 from other_user took 43 us (true, -1)\n",
+                                            "[INFO][LoggerA] " + std::string(300, 'a') + "\n",
+                                            "[INFO][LoggerA] Plain message\n"}));
+ ASSERT_EQ(thread_ids, std::vector<uint32_t>(6, logging::GetCurrentThreadId()));
+ ASSERT_EQ(field_counts, std::vector<std::size_t>({0, 0, 4, 0, 0, 0}));
+
+ logging::LogManager::GetInstance().Shutdown();
+ ASSERT_EQ(logging::LogManager::GetInstance().GetNumLoggers(), 0);
+}
+
+TEST(LoggerTest, BinaryAppenderReusedKeyBuffer) {
+ logging::Logger& logger (logging::LogManager::GetInstance().GetLogger("LoggerA"));
+ std::unique_ptr<logging::FileAppenderConfig> appender_config =
+		 std::make_unique<logging::FileAppenderConfig>(logging::AppenderType::BINARY, "LoggerA_BinaryAppender", "/tmp/", "FALSE", "logging_binary_key_test", "TRUNCATE");
+ ASSERT_EQ(logger.AddAppender(std::move(appender_config)), logging::AppenderAddableError::NO_ERROR);
+ // Same address, different keys.
+ char key[8];
+ std::strcpy(key, "first");
+ LOG_INFO_KV(logger, "Message", key, 1);
+ std::strcpy(key, "second");
+ LOG_INFO_KV(logger, "Message", key, 2);
+ logging::LogManager::GetInstance().Flush();
+
+ std::ifstream input("/tmp/logging_binary_key_test.bin", std::ifstream::binary);
+ logging::BinaryLogReader reader(input);
+ ASSERT_TRUE(reader.ReadHeader());
+ std::vector<std::string> keys;
+ logging::LogEvent log_event;
+ int64_t unix_nanos = 0;
+ while (reader.ReadEvent(log_event, unix_nanos)) {
+   logging::LogArgumentValue value;
+   logging::LogArguments::ReadArgument(log_event.m_fields.GetData(), value);
+   ASSERT_EQ(value.m_type, logging::LogArgumentType::KEY);
+   keys.push_back(value.m_string);
+ }
+ ASSERT_TRUE(reader.IsAtEnd());
+ ASSERT_EQ(keys, std::vector<std::string>({"first", "second"}));
+
+ logging::LogManager::GetInstance().Shutdown();
+ ASSERT_EQ(logging::LogManager::GetInstance().GetNumLoggers(), 0);
+}
+
+TEST(LoggerTest, BinaryLogReaderCorruptSize) {
+ std::string header(logging::kBinaryLogMagic, logging::kBinaryLogMagicSize);
+ header += static_cast<char>(logging::kBinaryLogVersion);
+ logging::AppendVarint(0, header);
+ std::string metadata_too_large(header);
+ logging::AppendVarint(std::numeric_limits<uint64_t>::max(), metadata_too_large);
+ std::istringstream metadata_input(metadata_too_large);
+ logging::BinaryLogReader metadata_reader(metadata_input);
+ ASSERT_FALSE(metadata_reader.ReadHeader());
+
+ // A record claiming more bytes than the maximum or than the input holds.
+ logging::AppendVarint(0, header);
+ for (uint64_t size : {std::numeric_limits<uint64_t>::max(), logging::kBinaryLogMaxRecordSize}) {
+   std::string data(header);
+   logging::AppendVarint(size, data);
+   data += static_cast<char>(logging::BinaryRecordType::EVENT);
+   std::istringstream input(data);
+   logging::BinaryLogReader reader(input);
+   ASSERT_TRUE(reader.ReadHeader());
+   logging::LogEvent log_event;
+   int64_t unix_nanos = 0;
+   ASSERT_FALSE(reader.ReadEvent(log_event, unix_nanos));
+   ASSERT_FALSE(reader.IsAtEnd());
+ }
+}
+
+TEST(LoggerTest, TraceAppender) {
+ logging::Logger& logger (logging::LogManager::GetInstance().GetLogger("LoggerA"));
+ std::unique_ptr<logging::FileAppenderConfig> appender_config =
+		 std::make_unique<logging::FileAppenderConfig>(logging::AppenderType::TRACE, "LoggerA_TraceAppender", "/tmp/", "FALSE", "logging_trace_test", "TRUNCATE");
+ ASSERT_EQ(logger.AddAppender(std::move(appender_config)), logging::AppenderAddableError::NO_ERROR);
+ int64_t before = logging::LogClock::ToUnixNanos(logging::LogClock::Now());
+ LOG_INFO(logger, "Plain message");
+ LOG_WARN_FMT(logger, "request {} took {} us", 123456, 42);
+ std::thread([&logger] { LOG_ERROR(logger, std::string(300, 'a')); }).join();
+ logging::LogManager::GetInstance().Flush();
+ int64_t after = logging::LogClock::ToUnixNanos(logging::LogClock::Now());
+
+ std::ifstream input("/tmp/logging_trace_test.trace");
+ std::string header;
+ std::getline(input, header);
+ ASSERT_EQ(header, logging::kTraceHeader);
+ std::vector<logging::TraceRecord> records;
+ logging::TraceRecord record;
+ while (logging::ReadTraceRecord(input, record)) {
+   ASSERT_GE(record.m_unix_nanos, before);
+   ASSERT_LE(record.m_unix_nanos, after);
+   ASSERT_EQ(record.m_logger_name, "LoggerA");
+   records.push_back(record);
+ }
+ ASSERT_FALSE(input.bad());
+ ASSERT_EQ(records.size(), 3);
+ ASSERT_EQ(records[0].m_log_level, logging::LogLevel::INFO);
+ ASSERT_EQ(records[0].m_message_size, std::string("Plain message").size());
+ ASSERT_EQ(records[0].m_thread_id, logging::GetCurrentThreadId());
+ ASSERT_EQ(records[1].m_log_level, logging::LogLevel::WARN);
+ ASSERT_EQ(records[1].m_message_size, std::string("request 123456 took 42 us").size());
+ ASSERT_EQ(records[2].m_log_level, logging::LogLevel::ERROR);
+ ASSERT_EQ(records[2].m_message_size, 300);
+ ASSERT_NE(records[2].m_thread_id, records[0].m_thread_id);
+ // The statistic counts what is in the file, header included.
+ logging::AppenderStatistics statistics;
+ logger.GetAppender("LoggerA_TraceAppender")->CollectStatistics(statistics);
+ ASSERT_EQ(statistics.m_bytes_written, ReadFile("/tmp/logging_trace_test.trace").size());
+
+ std::istringstream malformed("# logging trace v1\n1 2 LOUD 3 LoggerA\n");
+ ASSERT_FALSE(logging::ReadTraceRecord(malformed, record));
+ ASSERT_TRUE(malformed.fail());
+
+ logging::LogManager::GetInstance().Shutdown();
+ ASSERT_EQ(logging::LogManager::GetInstance().GetNumLoggers(), 0);
+}
+
+TEST(LoggerTest, SampledStatements) {
+ logging::Logger& logger (logging::LogManager::GetInstance().GetLogger("LoggerA"));
+ std::unique_ptr<logging::FileAppenderConfig> appender_config =
+		 std::make_unique<logging::FileAppenderConfig>(logging::AppenderType::FILE, "LoggerA_FileAppender", "/tmp/", "FALSE", "logging_sampling_test", "TRUNCATE");
+ appender_config->m_pattern = "%m%k%n";
+ ASSERT_EQ(logger.AddAppender(std::move(appender_config)), logging::AppenderAddableError::NO_ERROR);
+ logger.SetLogLevel(logging::LogLevel::INFO);
+ int evaluated = 0;
+ for (int i = 0; i < 10; ++i) {
+   LOG_EVERY_N(INFO, logger, 4, "every n " + std::to_string(++evaluated));
+   LOG_FIRST_N(WARN, logger, 3, "first n");
+   LOG_EVERY_T(INFO, logger, 3600.0, "every t");
+   LOG_RATE_LIMITED(ERROR, logger, 2, "rate limited");
+   LOG_RATE_LIMITED(ERROR, logger, 0, "rate zero");
+   LOG_RATE_LIMITED(ERROR, logger, -1.0, "rate negative");
+   LOG_EVERY_N(DEBUG, logger, 1, "level disabled");
+ }
+ logging::LogManager::GetInstance().Flush();
+ ASSERT_EQ(evaluated, 3);
+ std::string content = ReadFile("/tmp/logging_sampling_test.txt");
+ ASSERT_EQ(content.substr(content.find('\n') + 1),
+           "every n 1\nfirst n\nevery t\nrate limited\nfirst n\nrate limited\nfirst n\n"
+           "every n 2 suppressed=3\nevery n 3 suppressed=3\n");
+
+ logging::LogManager::GetInstance().Shutdown();
+ ASSERT_EQ(logging::LogManager::GetInstance().GetNumLoggers(), 0);
+}
+
+TEST(LoggerTest, RepeatedMessageDedup) {
+ logging::Logger& logger (logging::LogManager::GetInstance().GetLogger("LoggerA"));
+ RecordingAppender * appender = new RecordingAppender("LoggerA_RecordingAppender");
+ ASSERT_EQ(logger.AddAppender(logging::AppenderUnqPtr(appender)), logging::AppenderAddableError::NO_ERROR);
+
+ for (int i = 0; i < 5; ++i) {
+   LOG_ERROR(logger, "Dependency down");
+ }
+ LOG_INFO(logger, "Info is not deduplicated");
+ LOG_INFO(logger, "Info is not deduplicated");
+ LOG_ERROR(logger, "Dependency down");
+ LOG_WARN(logger, "Dependency down");
+ LOG_WARN(logger, "Dependency down");
+ logging::LogManager::GetInstance().Flush();
+ // INFO ends the streak, so the next ERROR is written again.
+ ASSERT_EQ(appender->GetMessages(), std::vector<std::string>({"Dependency down", "last message repeated 4 times",
+                                                              "Info is not deduplicated", "Info is not deduplicated",
+                                                              "Dependency down", "Dependency down",
+                                                              "last message repeated 1 times"}));
+
+ std::unique_ptr<logging::AppenderConfig> appender_config =
+		 std::make_unique<logging::AppenderConfig>(logging::AppenderType::NONE, "LoggerA_RecordingAppender");
+ appender_config->m_dedup_window_ms = 20;
+ appender->SetAppenderConfig(std::move(appender_config));
+ ASSERT_EQ(logging::LogDeduplicator::GetNumOpenStreaks(), 0);
+ LOG_ERROR(logger, "Timeout");
+ LOG_ERROR(logger, "Timeout");
+ // The report thread only runs while repeats are waiting to be reported.
+ ASSERT_EQ(logging::LogDeduplicator::GetNumOpenStreaks(), 1);
+ // Reported once the window has passed, without another event or a flush.
+ std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+ ASSERT_EQ(logging::LogDeduplicator::GetNumOpenStreaks(), 0);
+ LOG_ERROR(logger, "Timeout");
+ std::vector<std::string> messages = appender->GetMessages();
+ ASSERT_EQ(std::vector<std::string>(messages.begin() + 7, messages.end()),
+           std::vector<std::string>({"Timeout", "last message repeated 1 times", "Timeout"}));
+
+ // Deferred events are compared by format and arguments, without formatting them.
+ logging::LogDeduplicator deduplicator;
+ deduplicator.SetConfig(logging::LogLevel::WARN, 1000);
+ logging::LogEvent deferred_event;
+ deferred_event.m_log_level = logging::LogLevel::ERROR;
+ deferred_event.m_logger_name = "LoggerA";
+ deferred_event.m_format = "Retry {} failed";
+ deferred_event.m_arguments.Add(1);
+ logging::LogEvent other_event(deferred_event);
+ other_event.m_arguments.Clear();
+ other_event.m_arguments.Add(2);
+ logging::RepeatSummary summary;
+ ASSERT_TRUE(deduplicator.Check(deferred_event, summary));
+ ASSERT_FALSE(deduplicator.Check(deferred_event, summary));
+ ASSERT_TRUE(deduplicator.Check(other_event, summary));
+ ASSERT_EQ(summary.m_count, 1);
+ ASSERT_TRUE(deferred_event.m_message.empty());
+ ASSERT_TRUE(other_event.m_message.empty());
+
+ logging::LogManager::GetInstance().Shutdown();
+ ASSERT_EQ(logging::LogManager::GetInstance().GetNumLoggers(), 0);
+}
+
+namespace {
+
+logging::LogEvent MakeEvent(logging::LogLevel log_level, const std::string & message) {
+  logging::LogEvent log_event;
+  log_event.m_log_level = log_level;
+  log_event.m_logger_name = "LoggerA";
+  log_event.m_message = message;
+  return log_event;
+}
+
+// Sends events while the sink is blocked on "first" and returns what reaches it.
+std::vector<std::string> RunOverflow(logging::OverflowPolicy overflow_policy, const std::vector<logging::LogEvent> & log_events,
+                                     std::vector<uint64_t> & dropped_per_level) {
+  std::unique_ptr<logging::AppenderConfig> appender_config =
+		 std::make_unique<logging::AppenderConfig>(logging::AppenderType::NONE, "GatedAppender");
+  appender_config->m_queue_size = 4;
+  appender_config->m_overflow_policy = overflow_policy;
+  GatedAppender * gated_appender = new GatedAppender(std::move(appender_config));
+  logging::AsyncAppender appender((logging::AppenderUnqPtr(gated_appender)));
+  appender.Send(MakeEvent(logging::LogLevel::INFO, "first"));
+  gated_appender->WaitUntilBlocked();
+  for (const logging::LogEvent & log_event : log_events) {
+    appender.Send(log_event);
+  }
+  gated_appender->Open();
+  appender.Flush();
+  dropped_per_level.clear();
+  for (int level = 1; level <= 6; ++level) {
+    dropped_per_level.push_back(appender.GetDroppedCount(static_cast<logging::LogLevel>(level)));
+  }
+  return gated_appender->GetMessages();
+}
+
+}  // namespace
+
+TEST(LoggerTest, AsyncAppenderOverflow) {
+ std::vector<logging::LogEvent> info_events;
+ for (int i = 1; i <= 8; ++i) {
+   info_events.push_back(MakeEvent(logging::LogLevel::INFO, "e" + std::to_string(i)));
+ }
+ std::vector<uint64_t> dropped;
+ ASSERT_EQ(RunOverflow(logging::OverflowPolicy::DROP_NEWEST, info_events, dropped),
+           std::vector<std::string>({"first", "4 events dropped", "e1", "e2", "e3", "e4"}));
+ ASSERT_EQ(dropped, std::vector<uint64_t>({0, 0, 0, 4, 0, 0}));
+ ASSERT_EQ(RunOverflow(logging::OverflowPolicy::DROP_OLDEST, info_events, dropped),
+           std::vector<std::string>({"first", "4 events dropped", "e5", "e6", "e7", "e8"}));
+ ASSERT_EQ(dropped, std::vector<uint64_t>({0, 0, 0, 4, 0, 0}));
+ ASSERT_EQ(RunOverflow(logging::OverflowPolicy::BLOCK, {}, dropped), std::vector<std::string>({"first"}));
+
+ std::vector<logging::LogEvent> mixed_events = {
+   MakeEvent(logging::LogLevel::DEBUG, "d1"), MakeEvent(logging::LogLevel::INFO, "i1"), MakeEvent(logging::LogLevel::DEBUG, "d2"),
+   MakeEvent(logging::LogLevel::INFO, "i2"), MakeEvent(logging::LogLevel::ERROR, "e1"), MakeEvent(logging::LogLevel::INFO, "i3"),
+   MakeEvent(logging::LogLevel::WARN, "w1"), MakeEvent(logging::LogLevel::DEBUG, "d3")};
+ ASSERT_EQ(RunOverflow(logging::OverflowPolicy::DROP_BELOW_LEVEL, mixed_events, dropped),
+           std::vector<std::string>({"first", "4 events dropped", "i2", "e1", "i3", "w1"}));
+ ASSERT_EQ(dropped, std::vector<uint64_t>({0, 0, 0, 1, 3, 0}));
+
+ // Events sent while Close() drains the queue are written after it, later ones on the calling thread.
+ std::unique_ptr<logging::AppenderConfig> gated_config =
+		 std::make_unique<logging::AppenderConfig>(logging::AppenderType::NONE, "GatedAppender");
+ gated_config->m_queue_size = 4;
+ GatedAppender * gated_appender = new GatedAppender(std::move(gated_config));
+ logging::AsyncAppender async_appender((logging::AppenderUnqPtr(gated_appender)));
+ async_appender.Send(MakeEvent(logging::LogLevel::INFO, "first"));
+ gated_appender->WaitUntilBlocked();
+ async_appender.Send(MakeEvent(logging::LogLevel::INFO, "queued"));
+ std::thread closer([&async_appender] { async_appender.Close(); });
+ std::this_thread::sleep_for(std::chrono::milliseconds(50));
+ async_appender.Send(MakeEvent(logging::LogLevel::INFO, "during close"));
+ gated_appender->Open();
+ closer.join();
+ async_appender.Send(MakeEvent(logging::LogLevel::INFO, "after close"));
+ ASSERT_EQ(gated_appender->GetMessages(), std::vector<std::string>({"first", "queued", "during close", "after close"}));
+
+ logging::Logger& logger (logging::LogManager::GetInstance().GetLogger("LoggerA"));
+ std::unique_ptr<logging::FileAppenderConfig> appender_config =
+		 std::make_unique<logging::FileAppenderConfig>(logging::AppenderType::FILE, "LoggerA_FileAppender", "/tmp/", "FALSE", "logging_queue_test", "TRUNCATE");
+ appender_config->m_queue_size = 16;
+ ASSERT_EQ(logger.AddAppender(std::move(appender_config)), logging::AppenderAddableError::NO_ERROR);
+ ASSERT_NE(dynamic_cast<logging::AsyncAppender*>(logger.GetAppender("LoggerA_FileAppender")), nullptr);
+ LOG_INFO(logger, "Queued message");
+ logging::LogManager::GetInstance().Flush();
+ ASSERT_NE(ReadFile("/tmp/logging_queue_test.txt").find("Queued message\n"), std::string::npos);
+
+ logging::LogManager::GetInstance().Shutdown();
+ ASSERT_EQ(logging::LogManager::GetInstance().GetNumLoggers(), 0);
+}
@@ -0,0 +1,426 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// Drives LogManager with a synthetic traffic profile or a captured trace and reports what the
+// callers saw.
+//
+//   loadgen [-c config] [-t threads] [-r rate] [-d seconds] [-n loggers] [-s sizes] [-l levels] [-a]
+//   loadgen [-c config] [-a] -R file.trace [-x speed]
+//
+// -c  logging config file, as config/example_logging_config.txt. Without it events go to the
+//     default console appender.
+// -t  producer threads (4), -r  messages per second per thread, 0 for as fast as possible (1000),
+// -d  duration in seconds (5), -n  number of loggers, named loadgen.0 ... (8),
+// -s  message sizes as size:weight,... (64:60,256:30,4096:10),
+// -l  levels as level:weight,... (INFO:90,WARN:8,ERROR:2), -a  asynchronous mode.
+// -R  replays a trace written by a TRACE appender: one producer per thread of the trace, each event
+//     at its original offset from the start divided by the speed factor of -x (1).
+//
+// Every message is unique, so deduplication doesn't hide any. The report goes to stderr, so the
+// console output can be sent to /dev/null. Latency is caller side and measured from when each LOG
+// call was scheduled, so a call that stalls also counts against the calls queued up behind it
+// (no coordinated omission). Service time is the duration of the call alone.
+
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "logging/log_manager.h"
+#include "logging/log_trace.h"
+#include "logging/logger.h"
+
+namespace {
+
+using SteadyClock = std::chrono::steady_clock;
+
+struct Options {
+  std::string m_config_file;
+  std::size_t m_num_threads = 4;
+  double m_rate = 1000;
+  double m_duration_seconds = 5;
+  std::size_t m_num_loggers = 8;
+  std::vector<std::pair<std::size_t, double>> m_sizes {{64, 60}, {256, 30}, {4096, 10}};
+  std::vector<std::pair<logging::LogLevel, double>> m_levels {{logging::LogLevel::INFO, 90}, {logging::LogLevel::WARN, 8}, {logging::LogLevel::ERROR, 2}};
+  bool m_async = false;
+  std::string m_trace_file;
+  double m_speed = 1;
+};
+
+// Log-linear latency histogram in nanoseconds: exact below 128 ns, then 64 buckets per power of two,
+// so percentiles are within 1.6%.
+class LatencyRecorder {
+ public:
+  LatencyRecorder() : m_counts(kNumBuckets, 0) {}
+
+  void Record(uint64_t nanos) {
+    ++m_counts[GetBucket(nanos)];
+    ++m_count;
+    m_max = std::max(m_max, nanos);
+  }
+
+  void Merge(const LatencyRecorder & other) {
+    for (std::size_t i = 0; i < kNumBuckets; ++i) {
+      m_counts[i] += other.m_counts[i];
+    }
+    m_count += other.m_count;
+    m_max = std::max(m_max, other.m_max);
+  }
+
+  // Highest value of the bucket holding the quantile q.
+  uint64_t Percentile(double q) const {
+    uint64_t rank = static_cast<uint64_t>(std::ceil(q * static_cast<double>(m_count)));
+    uint64_t count = 0;
+    for (std::size_t i = 0; i < kNumBuckets; ++i) {
+      count += m_counts[i];
+      if (count >= rank && count > 0) {
+        return std::min(GetBucketMax(i), m_max);
+      }
+    }
+    return m_max;
+  }
+
+  uint64_t GetCount() const { return m_count; }
+  uint64_t GetMax() const { return m_max; }
+
+ private:
+  static constexpr unsigned kSubBucketBits = 6;
+  static constexpr uint64_t kNumExact = 2 << kSubBucketBits;
+  static constexpr std::size_t kNumBuckets = kNumExact + (64 - kSubBucketBits - 1) * (1 << kSubBucketBits);
+
+  static std::size_t GetBucket(uint64_t nanos) {
+    if (nanos < kNumExact) {
+      return static_cast<std::size_t>(nanos);
+    }
+    unsigned exponent = 63 - __builtin_clzll(nanos);
+    unsigned shift = exponent - kSubBucketBits;
+    return kNumExact + ((exponent - kSubBucketBits - 1) << kSubBucketBits) + ((nanos >> shift) & ((1 << kSubBucketBits) - 1));
+  }
+
+  static uint64_t GetBucketMax(std::size_t bucket) {
+    if (bucket < kNumExact) {
+      return bucket;
+    }
+    unsigned exponent = static_cast<unsigned>((bucket - kNumExact) >> kSubBucketBits) + kSubBucketBits + 1;
+    uint64_t sub_bucket = (bucket - kNumExact) & ((1 << kSubBucketBits) - 1);
+    unsigned shift = exponent - kSubBucketBits;
+    return (((1ull << kSubBucketBits) + sub_bucket + 1) << shift) - 1;
+  }
+
+  std::vector<uint64_t> m_counts;
+  uint64_t m_count = 0;
+  uint64_t m_max = 0;
+};
+
+struct ProducerResult {
+  LatencyRecorder m_latency;
+  LatencyRecorder m_service_time;
+  uint64_t m_events = 0;
+};
+
+// A unique message of the given size (longer if the prefix alone doesn't fit).
+void MakeMessage(std::size_t producer, uint64_t sequence, std::size_t size, std::string & message) {
+  message = "producer=" + std::to_string(producer) + " seq=" + std::to_string(sequence) + ' ';
+  if (message.size() < size) {
+    message.resize(size, 'x');
+  }
+}
+
+uint64_t ToNanos(SteadyClock::duration duration) {
+  return static_cast<uint64_t>(std::max<int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count(), 0));
+}
+
+// scheduled is when the call was due, it may have been delayed by the calls before it.
+void Log(logging::Logger & logger, logging::LogLevel log_level, const std::string & message, SteadyClock::time_point scheduled,
+         ProducerResult & result) {
+  SteadyClock::time_point start = SteadyClock::now();
+  if (logger.ShouldLog(log_level)) {
+    logger.Write(log_level, message);
+  }
+  SteadyClock::time_point end = SteadyClock::now();
+  result.m_latency.Record(ToNanos(end - scheduled));
+  result.m_service_time.Record(ToNanos(end - start));
+  ++result.m_events;
+}
+
+void RunProfile(const Options & options, const std::vector<logging::Logger*> & loggers, std::size_t producer,
+                SteadyClock::time_point start, ProducerResult & result) {
+  std::mt19937_64 random(producer + 1);
+  std::vector<double> size_weights;
+  for (const auto & size : options.m_sizes) {
+    size_weights.push_back(size.second);
+  }
+  std::vector<double> level_weights;
+  for (const auto & level : options.m_levels) {
+    level_weights.push_back(level.second);
+  }
+  std::discrete_distribution<std::size_t> size_distribution(size_weights.begin(), size_weights.end());
+  std::discrete_distribution<std::size_t> level_distribution(level_weights.begin(), level_weights.end());
+  std::uniform_int_distribution<std::size_t> logger_distribution(0, loggers.size() - 1);
+
+  const SteadyClock::time_point end = start + std::chrono::duration_cast<SteadyClock::duration>(std::chrono::duration<double>(options.m_duration_seconds));
+  const std::chrono::duration<double> period(options.m_rate > 0 ? 1 / options.m_rate : 0);
+  std::string message;
+  for (uint64_t sequence = 0; ; ++sequence) {
+    SteadyClock::time_point now = SteadyClock::now();
+    // Without a rate there is no schedule, each call is due when the previous one returned.
+    SteadyClock::time_point scheduled = now;
+    if (options.m_rate > 0) {
+      scheduled = start + std::chrono::duration_cast<SteadyClock::duration>(period * static_cast<double>(sequence));
+      if (scheduled >= end) {
+        break;
+      }
+      if (now < scheduled) {
+        std::this_thread::sleep_until(scheduled);
+      }
+    } else if (now >= end) {
+      break;
+    }
+    MakeMessage(producer, sequence, options.m_sizes[size_distribution(random)].first, message);
+    Log(*loggers[logger_distribution(random)], options.m_levels[level_distribution(random)].first, message, scheduled, result);
+  }
+}
+
+struct ReplayEvent {
+  SteadyClock::duration m_offset;
+  logging::Logger * m_logger;
+  logging::LogLevel m_log_level;
+  std::size_t m_message_size;
+};
+
+void RunReplay(const std::vector<ReplayEvent> & events, std::size_t producer, SteadyClock::time_point start, ProducerResult & result) {
+  std::string message;
+  uint64_t sequence = 0;
+  for (const ReplayEvent & event : events) {
+    SteadyClock::time_point next = start + event.m_offset;
+    if (SteadyClock::now() < next) {
+      std::this_thread::sleep_until(next);
+    }
+    MakeMessage(producer, sequence++, event.m_message_size, message);
+    Log(*event.m_logger, event.m_log_level, message, next, result);
+  }
+}
+
+// Events of the trace grouped by thread, offsets relative to the first event.
+bool LoadTrace(const Options & options, std::vector<std::vector<ReplayEvent>> & producers) {
+  std::ifstream input(options.m_trace_file);
+  if (!input) {
+    std::cerr << "loadgen: cannot open " << options.m_trace_file << std::endl;
+    return false;
+  }
+  std::map<uint32_t, std::size_t> producer_of_thread;
+  logging::TraceRecord record;
+  bool has_first = false;
+  int64_t first_unix_nanos = 0;
+  while (logging::ReadTraceRecord(input, record)) {
+    if (!has_first) {
+      first_unix_nanos = record.m_unix_nanos;
+      has_first = true;
+    }
+    auto it = producer_of_thread.find(record.m_thread_id);
+    if (it == producer_of_thread.end()) {
+      it = producer_of_thread.emplace(record.m_thread_id, producers.size()).first;
+      producers.emplace_back();
+    }
+    double offset_nanos = static_cast<double>(std::max<int64_t>(record.m_unix_nanos - first_unix_nanos, 0)) / options.m_speed;
+    producers[it->second].push_back({std::chrono::duration_cast<SteadyClock::duration>(std::chrono::duration<double, std::nano>(offset_nanos)),
+                                     &logging::LogManager::GetInstance().GetLogger(record.m_logger_name),
+                                     record.m_log_level, record.m_message_size});
+  }
+  if (input.fail() && !input.eof()) {
+    std::cerr << "loadgen: " << options.m_trace_file << " has a malformed line" << std::endl;
+    return false;
+  }
+  for (auto & events : producers) {
+    std::stable_sort(events.begin(), events.end(), [](const ReplayEvent & a, const ReplayEvent & b) { return a.m_offset < b.m_offset; });
+  }
+  return true;
+}
+
+template <class T>
+bool ParseWeights(const std::string & text, T (*parse)(const std::string &), std::vector<std::pair<T, double>> & weights) {
+  weights.clear();
+  std::istringstream items(text);
+  std::string item;
+  try {
+    while (std::getline(items, item, ',')) {
+      std::size_t colon = item.find(':');
+      double weight = colon == std::string::npos ? 1 : std::stod(item.substr(colon + 1));
+      if (weight < 0) {
+        return false;
+      }
+      weights.emplace_back(parse(item.substr(0, colon)), weight);
+    }
+  }
+  catch (std::exception &) {
+    return false;
+  }
+  return !weights.empty();
+}
+
+std::size_t ParseSize(const std::string & text) {
+  return std::stoul(text);
+}
+
+logging::LogLevel ParseLevel(const std::string & text) {
+  return logging::LogLevellFromString(text);
+}
+
+struct Counters {
+  uint64_t m_bytes_written = 0;
+  uint64_t m_dropped = 0;
+};
+
+Counters GetCounters() {
+  Counters counters;
+  for (const auto & appender : logging::LogManager::GetInstance().GetStatistics().m_appenders) {
+    counters.m_bytes_written += appender.m_bytes_written;
+    counters.m_dropped += appender.m_dropped;
+  }
+  return counters;
+}
+
+void PrintUsage() {
+  std::cerr << "usage: loadgen [-c config] [-t threads] [-r rate] [-d seconds] [-n loggers] [-s sizes] [-l levels] [-a]\n"
+            << "       loadgen [-c config] [-a] -R file.trace [-x speed]" << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char * argv[]) {
+  Options options;
+  int option;
+  try {
+    while ((option = getopt(argc, argv, "c:t:r:d:n:s:l:aR:x:h")) != -1) {
+      switch (option) {
+        case 'c': options.m_config_file = optarg; break;
+        case 't': options.m_num_threads = std::stoul(optarg); break;
+        case 'r': options.m_rate = std::stod(optarg); break;
+        case 'd': options.m_duration_seconds = std::stod(optarg); break;
+        case 'n': options.m_num_loggers = std::stoul(optarg); break;
+        case 's':
+          if (!ParseWeights(optarg, &ParseSize, options.m_sizes)) {
+            std::cerr << "loadgen: invalid sizes " << optarg << std::endl;
+            return 2;
+          }
+          break;
+        case 'l':
+          if (!ParseWeights(optarg, &ParseLevel, options.m_levels)) {
+            std::cerr << "loadgen: invalid levels " << optarg << std::endl;
+            return 2;
+          }
+          break;
+        case 'a': options.m_async = true; break;
+        case 'R': options.m_trace_file = optarg; break;
+        case 'x': options.m_speed = std::stod(optarg); break;
+        default:
+          PrintUsage();
+          return 2;
+      }
+    }
+  }
+  catch (std::exception &) {
+    PrintUsage();
+    return 2;
+  }
+  if (options.m_num_threads == 0 || options.m_num_loggers == 0 || options.m_speed <= 0 || options.m_rate < 0) {
+    PrintUsage();
+    return 2;
+  }
+
+  logging::LogManager & log_manager = logging::LogManager::GetInstance();
+  if (!options.m_config_file.empty()) {
+    log_manager.InitFromLogConfigFile(options.m_config_file);
+  }
+
+  std::vector<logging::Logger*> loggers;
+  std::vector<std::vector<ReplayEvent>> replay_producers;
+  if (options.m_trace_file.empty()) {
+    for (std::size_t i = 0; i < options.m_num_loggers; ++i) {
+      loggers.push_back(&log_manager.GetLogger("loadgen." + std::to_string(i)));
+    }
+  } else if (!LoadTrace(options, replay_producers)) {
+    return 1;
+  }
+  if (options.m_async) {
+    log_manager.StartAsync();
+  }
+
+  const Counters before = GetCounters();
+  const std::size_t num_producers = options.m_trace_file.empty() ? options.m_num_threads : replay_producers.size();
+  std::vector<ProducerResult> results(num_producers);
+  std::vector<std::thread> producers;
+  const SteadyClock::time_point start = SteadyClock::now() + std::chrono::milliseconds(10);
+  for (std::size_t i = 0; i < num_producers; ++i) {
+    if (options.m_trace_file.empty()) {
+      producers.emplace_back(RunProfile, std::cref(options), std::cref(loggers), i, start, std::ref(results[i]));
+    } else {
+      producers.emplace_back(RunReplay, std::cref(replay_producers[i]), i, start, std::ref(results[i]));
+    }
+  }
+  for (auto & producer : producers) {
+    producer.join();
+  }
+  const SteadyClock::time_point produced = SteadyClock::now();
+  log_manager.Flush();
+  const SteadyClock::time_point drained = SteadyClock::now();
+  const Counters after = GetCounters();
+
+  LatencyRecorder latency;
+  LatencyRecorder service_time;
+  uint64_t events = 0;
+  for (const auto & result : results) {
+    latency.Merge(result.m_latency);
+    service_time.Merge(result.m_service_time);
+    events += result.m_events;
+  }
+  const double seconds = std::chrono::duration<double>(produced - start).count();
+  const uint64_t bytes_written = after.m_bytes_written - before.m_bytes_written;
+  std::cerr << "producers " << num_producers << (options.m_async ? " (async)" : "") << '\n'
+            << "events " << events << '\n'
+            << "seconds " << seconds << '\n'
+            << "events_per_second " << static_cast<double>(events) / seconds << '\n'
+            << "latency_ns_p50 " << latency.Percentile(0.5) << '\n'
+            << "latency_ns_p99 " << latency.Percentile(0.99) << '\n'
+            << "latency_ns_p999 " << latency.Percentile(0.999) << '\n'
+            << "latency_ns_max " << latency.GetMax() << '\n'
+            << "service_ns_p50 " << service_time.Percentile(0.5) << '\n'
+            << "service_ns_p99 " << service_time.Percentile(0.99) << '\n'
+            << "service_ns_max " << service_time.GetMax() << '\n'
+            << "bytes_written " << bytes_written << '\n'
+            << "bytes_per_second " << static_cast<double>(bytes_written) / seconds << '\n'
+            << "dropped " << after.m_dropped - before.m_dropped << '\n'
+            << "drain_ms " << std::chrono::duration<double, std::milli>(drained - produced).count() << std::endl;
+
+  log_manager.Shutdown();
+  return 0;
+}
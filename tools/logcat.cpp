@@ -0,0 +1,114 @@
+// MIT License
+
+// Copyright (c) 2018 Kohei Otsuka
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Converts binary logs written by BinaryAppender back to text.
+//
+//   logcat [-t] [-k] [file.bin ...]
+//
+// Prints every event as "[LEVEL][logger] message" like DefaultFormatPolicyWithNewLine, -t prefixes
+// the local time and -k appends the structured fields as " key=value". Reads stdin without files.
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "logging/binary_log_reader.h"
+#include "logging/default_format_policy_with_newline.h"
+#include "logging/log_event.h"
+#include "logging/pattern_layout.h"
+#include "logging/timestamp_formatter.h"
+
+namespace {
+
+struct Options {
+  bool m_print_time = false;
+  bool m_print_fields = false;
+};
+
+bool Decode(std::istream & input, const std::string & name, const Options & options) {
+  logging::BinaryLogReader reader(input);
+  if (!reader.ReadHeader()) {
+    std::cerr << "logcat: " << name << " is not a binary log" << std::endl;
+    return false;
+  }
+  logging::DefaultFormatPolicyWithNewLine format_policy;
+  logging::TimestampFormatter timestamp_formatter;
+  logging::PatternLayout fields_layout("%k");
+  logging::LogEvent log_event;
+  int64_t unix_nanos = 0;
+  std::string line;
+  while (reader.ReadEvent(log_event, unix_nanos)) {
+    line.clear();
+    if (options.m_print_time) {
+      timestamp_formatter.Format(unix_nanos, line);
+      line += ' ';
+    }
+    line += format_policy.FormatMessage(log_event);
+    if (options.m_print_fields && !log_event.m_fields.IsEmpty()) {
+      line.pop_back();
+      fields_layout.Render(log_event, line);
+      line += '\n';
+    }
+    std::cout << line;
+  }
+  if (!reader.IsAtEnd()) {
+    std::cerr << "logcat: " << name << " ends with a truncated or corrupt record" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char * argv[]) {
+  Options options;
+  std::vector<std::string> files;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "-t") == 0) {
+      options.m_print_time = true;
+    } else if (std::strcmp(argv[i], "-k") == 0) {
+      options.m_print_fields = true;
+    } else if (argv[i][0] == '-' && argv[i][1] != '\0') {
+      std::cerr << "usage: logcat [-t] [-k] [file.bin ...]" << std::endl;
+      return 2;
+    } else {
+      files.push_back(argv[i]);
+    }
+  }
+
+  std::ios::sync_with_stdio(false);
+  bool ok = true;
+  if (files.empty()) {
+    ok = Decode(std::cin, "stdin", options);
+  }
+  for (const std::string & file : files) {
+    std::ifstream input(file, std::ifstream::binary);
+    if (!input) {
+      std::cerr << "logcat: cannot open " << file << std::endl;
+      ok = false;
+      continue;
+    }
+    ok = Decode(input, file, options) && ok;
+  }
+  return ok ? 0 : 1;
+}